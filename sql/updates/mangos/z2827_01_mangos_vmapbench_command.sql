@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2826_01_mangos_spawn_group_squad required_z2827_01_mangos_vmapbench_command bit;
+
+DELETE FROM command WHERE name IN ('debug vmapbench');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug vmapbench', 3, 'Syntax: .debug vmapbench [#rays]\r\n\r\nCast #rays (default 5000, at most 20000) random rays against a local set of triangles around your character with every ray kernel the cpu supports, and show their timings and result mismatches against the scalar kernel. The kernel used by the server is not changed.');
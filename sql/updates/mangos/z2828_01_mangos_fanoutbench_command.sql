@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2827_01_mangos_vmapbench_command required_z2828_01_mangos_fanoutbench_command bit;
+
+DELETE FROM command WHERE name IN ('debug fanoutbench');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug fanoutbench', 3, 'Syntax: .debug fanoutbench [#repeats]\r\n\r\nCompare building one buffer per receiver against sharing one packet body for a full length channel message sent to 1000 and 5000 receivers, repeated #repeats times (default 100, at most 10000).');
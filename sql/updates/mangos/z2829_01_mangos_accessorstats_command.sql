@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2828_01_mangos_fanoutbench_command required_z2829_01_mangos_accessorstats_command bit;
+
+DELETE FROM command WHERE name IN ('debug accessorstats');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug accessorstats', 3, 'Syntax: .debug accessorstats [reset]\r\n\r\nShow the object accessor player and corpse lookup counters: lookups, contended lookups and grace period waits. With reset the counters are cleared after being shown.');
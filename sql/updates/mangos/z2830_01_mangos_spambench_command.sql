@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2829_01_mangos_accessorstats_command required_z2830_01_mangos_spambench_command bit;
+
+DELETE FROM command WHERE name IN ('anticheat spambench');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('anticheat spambench', 3, 'Syntax: .anticheat spambench $file [#repeats]\r\n\r\nReplay the chat corpus $file #repeats times (default 1) through the antispam checks, comparing the old and new implementations. The corpus has one message per line, optionally prefixed with an account id and a tab. Shows timings, differing normalizations, distance mismatches and the spam clusters found.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2830_01_mangos_spambench_command required_z2831_01_mangos_queuestats_command bit;
+
+DELETE FROM command WHERE name IN ('debug queuestats');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug queuestats', 3, 'Syntax: .debug queuestats [reset]\r\n\r\nShow the battleground join to invite and LFG join to group wait times (average, median, 95th percentile and maximum) and the number of queue passes. With reset the statistics are cleared after being shown.');
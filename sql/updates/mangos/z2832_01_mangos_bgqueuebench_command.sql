@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2831_01_mangos_queuestats_command required_z2832_01_mangos_bgqueuebench_command bit;
+
+DELETE FROM command WHERE name IN ('debug bgqueuebench');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug bgqueuebench', 3, 'Syntax: .debug bgqueuebench [#players] [#pops]\r\n\r\nRun the battleground matchmaking on a private queue kept filled with #players queued players (default 1000) until #pops (default 1000) battlegrounds were formed, with random leaves in between. Runs on the battleground queue thread and shows match check, join and leave timings and the average faction imbalance.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2832_01_mangos_bgqueuebench_command required_z2833_01_mangos_messagerstats_command bit;
+
+DELETE FROM command WHERE name IN ('debug messagerstats');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug messagerstats', 3, 'Syntax: .debug messagerstats [reset]\r\n\r\nShow depth, batch and queued to executed latency statistics of the world, battleground, battleground queue, LFG queue and current map message queues. With reset the statistics are cleared after being shown.');
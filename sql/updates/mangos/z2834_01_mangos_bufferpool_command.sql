@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2833_01_mangos_messagerstats_command required_z2834_01_mangos_bufferpool_command bit;
+
+DELETE FROM command WHERE name IN ('debug bufferpool');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug bufferpool', 3, 'Syntax: .debug bufferpool [reset]\r\n\r\nShow the packet buffer pool hits, misses, blocks returned from other threads and releases per size class and the number of allocations too large to be pooled. With reset the counters are cleared after being shown.');
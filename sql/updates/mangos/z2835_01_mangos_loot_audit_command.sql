@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2834_01_mangos_bufferpool_command required_z2835_01_mangos_loot_audit_command bit;
+
+DELETE FROM command WHERE name IN ('loot audit');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('loot audit', 2, 'Syntax: .loot audit $lootType [#amountOfDropCheck] [#tolerance]\r\n\r\nSimulate #amountOfDropCheck drops (default 10000) of every template of the loot type without rates and list the entries dropping off their chance by more than #tolerance percent points. Deviations within the statistical noise of the simulation are never listed.');
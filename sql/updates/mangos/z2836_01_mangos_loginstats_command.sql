@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2835_01_mangos_loot_audit_command required_z2836_01_mangos_loginstats_command bit;
+
+DELETE FROM command WHERE name IN ('debug loginstats');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug loginstats', 3, 'Syntax: .debug loginstats [reset]\r\n\r\nShow character load times on the loader connections and login request to login times (average, median, 95th percentile and maximum). With reset the statistics are cleared after being shown.');
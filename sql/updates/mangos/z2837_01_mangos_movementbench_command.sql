@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2836_01_mangos_loginstats_command required_z2837_01_mangos_movementbench_command bit;
+
+DELETE FROM command WHERE name IN ('debug movementbench');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug movementbench', 3, 'Syntax: .debug movementbench [#players] [#seconds]\r\n\r\nSimulate #players players (default 80, at most 200) moving in a crowded area for #seconds seconds (default 30, at most 30) and compare relaying every movement packet with the MovementRelay shaping settings: packets, bytes, peak bytes per tick and time spent.');
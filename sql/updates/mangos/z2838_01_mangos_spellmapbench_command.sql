@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2837_01_mangos_movementbench_command required_z2838_01_mangos_spellmapbench_command bit;
+
+DELETE FROM command WHERE name IN ('debug spellmapbench');
+
+INSERT INTO `command`(`name`, `security`, `help`) VALUES
+('debug spellmapbench', 3, 'Syntax: .debug spellmapbench [#lookups]\r\n\r\nCompare memory use and lookup time of the spell lookup tables against std::multimap copies of them, with #lookups lookups per table (default 100000, at most 1000000).');
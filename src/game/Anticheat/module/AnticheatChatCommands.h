@@ -20,5 +20,6 @@ static ChatCommand anticheatCommandTable[] =
     { "spaminform",   SEC_GAMEMASTER,    false, &ChatHandler::HandleAnticheatSpaminformCommand,     "", nullptr },
     { "blacklist",    SEC_GAMEMASTER,    false, &ChatHandler::HandleAnticheatBlacklistCommand,      "", nullptr },
     { "debugextrap",  SEC_ADMINISTRATOR, true,  &ChatHandler::HandleAnticheatDebugExtrapCommand,    "", nullptr },
+    { "spambench",    SEC_ADMINISTRATOR, true,  &ChatHandler::HandleAnticheatSpambenchCommand,      "", nullptr },
     { nullptr,   0,                  false, nullptr,                                                "", nullptr },
 };
\ No newline at end of file
@@ -10,6 +10,7 @@ bool HandleAnticheatCheatinformCommand(char* args);
 bool HandleAnticheatSpaminformCommand(char* args);
 bool HandleAnticheatBlacklistCommand(char* args);
 bool HandleAnticheatDebugExtrapCommand(char* args);
+bool HandleAnticheatSpambenchCommand(char* args);
 
 //fingerprint commands
 bool HandleAnticheatFingerprintListCommand(char* args);
@@ -258,7 +258,7 @@ std::string Antispam::GetInfo() const
         ret << "Repeats: " << u.first << " Message: \"" << u.second << "\"";
 
         if (i > 0)
-            ret << " Distance from previous message: " << nam::damerau_levenshtein_distance(_uniqueMessages[i - 1].second, u.second);
+            ret << " Distance from previous message: " << nam::damerau_levenshtein_distance_fast(_uniqueMessages[i - 1].second, u.second);
 
         ret << "\n";
     }
@@ -514,19 +514,55 @@ void Antispam::Analyze()
         }
     }
 
-    // step 5: see if they are repeating their messages too often
+    // step 5: see if the messages are part of a spam wave sent from several accounts
+    auto const clusterNotify = sAnticheatConfig.GetAntispamClusterNotify();
+    auto const clusterSilence = sAnticheatConfig.GetAntispamClusterSilence();
+
+    if (clusterNotify > 0 || clusterSilence > 0)
+    {
+        SpamClusterIndex::Result largest = { 0, 0, 0 };
+
+        for (auto const &msg : messages)
+        {
+            auto const cluster = sAntispamMgr.AddToCluster(msg, _account);
+
+            if (cluster.accounts > largest.accounts)
+                largest = cluster;
+        }
+
+        if (largest.accounts >= clusterSilence && clusterSilence > 0)
+        {
+            Silence("Message is part of a spam wave.  %u similar messages from %u accounts", largest.messages, largest.accounts);
+            return;
+        }
+        else if (largest.accounts >= clusterNotify && clusterNotify > 0)
+        {
+            Notify("Message is part of a spam wave.  %u similar messages from %u accounts", largest.messages, largest.accounts);
+        }
+    }
+
+    // step 6: see if they are repeating their messages too often
+    auto const uniquenessThreshold = sAnticheatConfig.GetAntispamUniquenessThreshold();
+
     for (auto const &msg : messages)
     {
+        nam::damerau_levenshtein_pattern const pattern(msg);
+
         // first see if the message is similar to previously observed unique messages
         bool found = false;
         for (auto i = 0u; i < _uniqueMessages.size(); ++i)
         {
             auto &u = _uniqueMessages[i];
 
-            auto const distance = static_cast<uint32>(nam::damerau_levenshtein_distance(msg, u.second));
+            // the distance is never less than the difference in length, which is much cheaper to check
+            auto const lengthDifference = msg.length() > u.second.length() ? msg.length() - u.second.length() : u.second.length() - msg.length();
+            if (lengthDifference >= uniquenessThreshold)
+                continue;
+
+            auto const distance = static_cast<uint32>(pattern.distance(u.second));
 
             // if these two messages are the same, increase the count
-            if (distance < sAnticheatConfig.GetAntispamUniquenessThreshold())
+            if (distance < uniquenessThreshold)
             {
                 ++u.first;
                 found = true;
@@ -12,6 +12,7 @@
 #include "World/World.h"
 #include "Accounts/AccountMgr.h"
 #include "Log/Log.h"
+#include "../dldist.hpp"
 
 #include "Database/DatabaseEnv.h"
 #include "Policies/Singleton.h"
@@ -26,6 +27,8 @@
 #include <thread>
 #include <chrono>
 #include <array>
+#include <iomanip>
+#include <sstream>
 
 INSTANTIATE_SINGLETON_1(NamreebAnticheat::AntispamMgr);
 
@@ -50,6 +53,88 @@ void ReplaceAllW(std::wstring &str, const std::wstring& from, const std::wstring
         startPos += to.length();
     }
 }
+
+// messages of a spam wave usually differ in spacing and punctuation, so those are always ignored for clustering
+constexpr uint32 CLUSTER_NORMALIZE_MASK = NF_CUT_COLOR | NF_CUT_SPACE | NF_CUT_CTRL | NF_CUT_PUNCT;
+
+bool IsAlphaNumeric(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+bool IsWordCharacter(char c)
+{
+    return IsAlphaNumeric(c) || c == '_';
+}
+
+bool IsLinkEnd(const std::string &str, size_t pos)
+{
+    return str.compare(pos, 4, "|h|r") == 0;
+}
+
+// character classes as the "C" locale defines them, bytes of multibyte utf8 characters are always kept
+bool KeepCharacter(unsigned char c, uint32 mask)
+{
+    if (c >= 0x80)
+        return true;
+
+    if ((mask & NF_CUT_CTRL) && (c < 0x20 || c == 0x7F))
+        return false;
+
+    if ((mask & NF_CUT_SPACE) && (c == ' ' || (c >= '\t' && c <= '\r') || c == '_'))
+        return false;
+
+    if ((mask & NF_CUT_NUMBERS) && c >= '0' && c <= '9')
+        return false;
+
+    if ((mask & NF_CUT_PUNCT) && c > ' ' && c < 0x7F && !IsAlphaNumeric(c))
+        return false;
+
+    return true;
+}
+
+// passes every character of the message to 'emit', except color codes (|cAARRGGBB), link ends (|h|r)
+// and link targets (|H...|h) when cutColor is set
+template <typename Emit>
+void ScanMessage(const std::string &str, bool cutColor, Emit &&emit)
+{
+    auto const length = str.length();
+
+    for (size_t i = 0; i < length; )
+    {
+        if (cutColor && str[i] == '|' && i + 1 < length)
+        {
+            if (str[i + 1] == 'c' && i + 10 <= length && std::all_of(&str[i + 2], &str[i + 10], IsWordCharacter))
+            {
+                i += 10;
+                continue;
+            }
+
+            if (IsLinkEnd(str, i))
+            {
+                i += 4;
+                continue;
+            }
+
+            if (str[i + 1] == 'H')
+            {
+                // the link target ends at the next |h which does not end the whole link.  the link text after it is kept
+                auto end = str.find("|h", i + 3);
+                while (end != std::string::npos && IsLinkEnd(str, end))
+                    end = str.find("|h", end + 4);
+
+                if (end != std::string::npos)
+                {
+                    i = end + 2;
+                    continue;
+                }
+            }
+        }
+
+        emit(str[i]);
+        ++i;
+    }
+}
 }
 
 namespace NamreebAnticheat
@@ -61,6 +146,88 @@ std::string AntispamMgr::NormalizeString(const std::string &string, uint32 mask)
 }
 
 std::string AntispamMgr::NormalizeStringInternal(const std::string &string, uint32 mask) const
+{
+    // color codes are cut while scanning for the character classes below, unless word replacements
+    // have to be applied to the message in between
+    std::string replaced;
+    auto const replaceWords = !!(mask & NF_REPLACE_WORDS) && !_asciiReplace.empty();
+
+    if (replaceWords)
+    {
+        replaced.reserve(string.length());
+        ScanMessage(string, !!(mask & NF_CUT_COLOR), [&replaced](char c) { replaced.push_back(c); });
+
+        for (auto const& e : _asciiReplace)
+            ReplaceAll(replaced, e.first, e.second);
+    }
+
+    auto const &source = replaceWords ? replaced : string;
+    auto const cutColor = !replaceWords && !!(mask & NF_CUT_COLOR);
+
+    // character removal, upper casing and repeat removal are all done in this one pass
+    std::string newMsg;
+    newMsg.reserve(source.length());
+    bool nonAscii = false;
+
+    ScanMessage(source, cutColor, [&](char c)
+    {
+        auto const u = static_cast<unsigned char>(c);
+
+        if (!KeepCharacter(u, mask))
+            return;
+
+        if (u >= 0x80)
+            nonAscii = true;
+        else if (u >= 'a' && u <= 'z')
+            c = static_cast<char>(u - 'a' + 'A');
+
+        if ((mask & NF_REMOVE_REPEATS) && !newMsg.empty() && newMsg.back() == c)
+            return;
+
+        newMsg.push_back(c);
+    });
+
+    if (!(mask & NF_REPLACE_UNICODE) || !nonAscii)
+        return newMsg;
+
+    // non ascii messages have to be upper cased and replaced as wide strings, and repeats removed after that
+    newMsg.clear();
+    ScanMessage(source, cutColor, [&newMsg, mask](char c)
+    {
+        if (KeepCharacter(static_cast<unsigned char>(c), mask))
+            newMsg.push_back(c);
+    });
+
+    std::wstring w_tempMsg, w_tempMsg2;
+    Utf8toWStr(newMsg, w_tempMsg);
+    wstrToUpper(w_tempMsg);
+
+    if (!isBasicLatinString(w_tempMsg, true))
+    {
+        for (auto const& s : _unicodeReplace)
+            ReplaceAllW(w_tempMsg, s.first, s.second);
+
+        if (mask & NF_REMOVE_NON_LATIN)
+        {
+            for (size_t i = 0; i < w_tempMsg.size(); ++i)
+                if (isBasicLatinCharacter(w_tempMsg[i]) || isNumeric(w_tempMsg[i]))
+                    w_tempMsg2.push_back(w_tempMsg[i]);
+        }
+        else
+            w_tempMsg2 = w_tempMsg;
+    }
+    else
+        w_tempMsg2 = w_tempMsg;
+
+    newMsg = std::string(w_tempMsg2.begin(), w_tempMsg2.end());
+
+    if (mask & NF_REMOVE_REPEATS)
+        newMsg.erase(std::unique(newMsg.begin(), newMsg.end()), newMsg.end());
+
+    return newMsg;
+}
+
+std::string AntispamMgr::NormalizeStringRegex(const std::string &string, uint32 mask) const
 {
     auto newMsg = string;
 
@@ -173,14 +340,20 @@ void AntispamMgr::WorkerLoop()
                 }
             }
 
+            _clusters.Expire(startMS, sAnticheatConfig.GetAntispamClusterExpiration() * IN_MILLISECONDS);
+
             for (auto const &s : workQueue)
                 s->Analyze();
         }
         else
         {
-            std::lock_guard<std::mutex> guard(_mutex);
-            _workQueue.clear();
-            _temporaryCache.clear();
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                _workQueue.clear();
+                _temporaryCache.clear();
+            }
+
+            _clusters.Clear();
         }
 
         auto stop = std::chrono::high_resolution_clock::now();
@@ -356,6 +529,137 @@ void AntispamMgr::ScheduleAnalysis(std::shared_ptr<Antispam> session)
     _workQueue.insert(session);
 }
 
+SpamClusterIndex::Result AntispamMgr::AddToCluster(const std::string &string, uint32 accountId)
+{
+    auto const normalized = NormalizeString(string, sAnticheatConfig.GetSpamNormalizationMask() | CLUSTER_NORMALIZE_MASK);
+
+    if (normalized.length() < sAnticheatConfig.GetAntispamClusterMinLength())
+        return { 0, 0, 0 };
+
+    return _clusters.Insert(normalized, accountId, WorldTimer::getMSTime(), sAnticheatConfig.GetAntispamClusterSimilarity());
+}
+
+std::string AntispamMgr::Benchmark(const std::vector<std::pair<uint32, std::string> > &corpus, uint32 repeats) const
+{
+    // how many previous messages each message is compared against, about the size of a session's unique message list
+    static constexpr size_t COMPARE_WINDOW = 32;
+
+    typedef std::chrono::steady_clock Clock;
+    auto const elapsedMS = [](Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    std::stringstream report;
+    report << std::fixed << std::setprecision(2);
+    report << "Antispam benchmark: " << corpus.size() << " messages, " << repeats << " repeats\n";
+
+    // normalization, with the configured mask and with every flag set
+    for (auto const mask : { sAnticheatConfig.GetSpamNormalizationMask(), uint32(0x1FF) })
+    {
+        uint32 differences = 0;
+        size_t checksum = 0;
+
+        auto start = Clock::now();
+        for (uint32 r = 0; r < repeats; ++r)
+            for (auto const &m : corpus)
+                checksum += NormalizeStringRegex(m.second, mask).length();
+        auto const regexMS = elapsedMS(start);
+
+        start = Clock::now();
+        for (uint32 r = 0; r < repeats; ++r)
+            for (auto const &m : corpus)
+                checksum += NormalizeStringInternal(m.second, mask).length();
+        auto const scanMS = elapsedMS(start);
+
+        for (auto const &m : corpus)
+            if (NormalizeStringRegex(m.second, mask) != NormalizeStringInternal(m.second, mask))
+                ++differences;
+
+        report << "Normalize (mask 0x" << std::hex << mask << std::dec << "): regex " << regexMS << " ms, single pass "
+            << scanMS << " ms (" << (scanMS > 0. ? regexMS / scanMS : 0.) << "x), " << differences << " differing results"
+            << " (checksum " << checksum << ")\n";
+    }
+
+    // fuzzy comparison of each message against the messages before it
+    {
+        uint32 mismatches = 0;
+        int64 fullTotal = 0, fastTotal = 0;
+
+        auto start = Clock::now();
+        for (uint32 r = 0; r < repeats; ++r)
+            for (size_t i = 0; i < corpus.size(); ++i)
+                for (size_t j = i > COMPARE_WINDOW ? i - COMPARE_WINDOW : 0; j < i; ++j)
+                    fullTotal += nam::damerau_levenshtein_distance(corpus[i].second, corpus[j].second);
+        auto const fullMS = elapsedMS(start);
+
+        start = Clock::now();
+        for (uint32 r = 0; r < repeats; ++r)
+            for (size_t i = 0; i < corpus.size(); ++i)
+            {
+                nam::damerau_levenshtein_pattern const pattern(corpus[i].second);
+                for (size_t j = i > COMPARE_WINDOW ? i - COMPARE_WINDOW : 0; j < i; ++j)
+                    fastTotal += pattern.distance(corpus[j].second);
+            }
+        auto const fastMS = elapsedMS(start);
+
+        for (size_t i = 0; i < corpus.size(); ++i)
+        {
+            nam::damerau_levenshtein_pattern const pattern(corpus[i].second);
+            for (size_t j = i > COMPARE_WINDOW ? i - COMPARE_WINDOW : 0; j < i; ++j)
+                if (pattern.distance(corpus[j].second) != nam::damerau_levenshtein_distance(corpus[i].second, corpus[j].second))
+                    ++mismatches;
+        }
+
+        report << "Edit distance (window " << COMPARE_WINDOW << "): full matrix " << fullMS << " ms, bit-parallel " << fastMS
+            << " ms (" << (fastMS > 0. ? fullMS / fastMS : 0.) << "x), " << mismatches << " mismatches"
+            << (fullTotal == fastTotal ? "" : ", totals differ") << "\n";
+    }
+
+    // cross account clustering, into a private index so the live one is not polluted
+    {
+        auto const similarity = sAnticheatConfig.GetAntispamClusterSimilarity();
+        auto const minLength = sAnticheatConfig.GetAntispamClusterMinLength();
+        auto const mask = sAnticheatConfig.GetSpamNormalizationMask() | CLUSTER_NORMALIZE_MASK;
+
+        std::vector<std::pair<uint32, std::string> > normalized;
+        normalized.reserve(corpus.size());
+        for (auto const &m : corpus)
+        {
+            auto n = NormalizeStringInternal(m.second, mask);
+            if (n.length() >= minLength)
+                normalized.emplace_back(m.first, std::move(n));
+        }
+
+        SpamClusterIndex index;
+        std::string sample;
+        SpamClusterIndex::Result largest = { 0, 0, 0 };
+        size_t clusters = 0;
+
+        auto const start = Clock::now();
+        for (uint32 r = 0; r < repeats; ++r)
+        {
+            index.Clear();
+            for (auto const &m : normalized)
+                index.Insert(m.second, m.first, 0, similarity);
+        }
+        auto const clusterMS = elapsedMS(start);
+
+        clusters = index.GetClusterCount();
+        largest = index.GetLargestCluster(sample);
+
+        report << "Clustering: " << normalized.size() << " messages indexed in " << clusterMS / std::max(repeats, 1u) << " ms, "
+            << clusters << " clusters, largest has " << largest.accounts << " accounts and " << largest.messages << " messages";
+
+        if (largest.accounts)
+            report << ": \"" << sample << "\"";
+
+        report << "\n";
+    }
+
+    return report.str();
+}
+
 void AntispamMgr::CacheSession(std::shared_ptr<Antispam> session)
 {
     std::lock_guard<std::mutex> guard(_mutex);
@@ -9,6 +9,7 @@
 #define __ANTISPAMMGR_HPP_
 
 #include "Policies/Singleton.h"
+#include "spamclusters.hpp"
 
 #include <atomic>
 #include <string>
@@ -50,12 +51,18 @@ class AntispamMgr
         // temporarily cache antispam session information in case they reconnect and resume spamming
         std::unordered_map<uint32, std::pair<uint32, std::shared_ptr<Antispam> > > _temporaryCache;
 
+        // recent messages of all sessions, grouped by similarity
+        SpamClusterIndex _clusters;
+
         // the thread is declared after all other members to guarantee that it is initialized last
         std::thread _worker;
 
         // this function performs the actual normalization, but assumes that the mutex is already locked
         std::string NormalizeStringInternal(const std::string &string, uint32 mask) const;
 
+        // the previous regex based normalization, only kept as a reference for the benchmark
+        std::string NormalizeStringRegex(const std::string &string, uint32 mask) const;
+
         void WorkerLoop();
 
     public:
@@ -75,6 +82,14 @@ class AntispamMgr
 
         void ScheduleAnalysis(std::shared_ptr<Antispam> session);
 
+        // adds a message to the cross session similarity index.  returns a zero cluster id if the message
+        // is too short after normalization to be compared
+        SpamClusterIndex::Result AddToCluster(const std::string &string, uint32 accountId);
+
+        // times normalization, fuzzy comparison and clustering of the given (account, message) corpus and
+        // compares the results against the reference implementations.  returns a human readable report
+        std::string Benchmark(const std::vector<std::pair<uint32, std::string> > &corpus, uint32 repeats) const;
+
         // temporarily cache antispam session data for the configured amount of time in case the
         // account reconnects to a new session
         void CacheSession(std::shared_ptr<Antispam> session);
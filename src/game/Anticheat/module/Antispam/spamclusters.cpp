@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017-2020 namreeb (legal@namreeb.org)
+ *
+ * This is private software and may not be shared under any circumstances,
+ * absent permission of namreeb.
+ */
+
+#include "spamclusters.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr size_t SHINGLE_LENGTH = 3;
+
+uint64 Mix64(uint64 x)
+{
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+}
+
+namespace NamreebAnticheat
+{
+void SpamClusterIndex::ComputeSignature(const std::string &text, Signature &signature)
+{
+    signature.fill(std::numeric_limits<uint32>::max());
+
+    auto const shingles = text.length() > SHINGLE_LENGTH ? text.length() - SHINGLE_LENGTH + 1 : 1;
+
+    for (size_t i = 0; i < shingles; ++i)
+    {
+        uint64 shingle = 0;
+        for (size_t j = i; j < std::min(i + SHINGLE_LENGTH, text.length()); ++j)
+            shingle = (shingle << 8) | static_cast<unsigned char>(text[j]);
+
+        // the i-th hash function is derived from two base hashes (h1 + i * h2), which is as good as
+        // independent functions for minhash purposes and much cheaper
+        auto const hash = Mix64(shingle);
+        auto const h1 = static_cast<uint32>(hash);
+        auto const h2 = static_cast<uint32>(hash >> 32) | 1;
+
+        for (uint32 k = 0; k < SIGNATURE_SIZE; ++k)
+            signature[k] = std::min(signature[k], h1 + k * h2);
+    }
+}
+
+float SpamClusterIndex::Similarity(const Signature &a, const Signature &b)
+{
+    uint32 equal = 0;
+    for (uint32 k = 0; k < SIGNATURE_SIZE; ++k)
+        if (a[k] == b[k])
+            ++equal;
+
+    return static_cast<float>(equal) / SIGNATURE_SIZE;
+}
+
+uint64 SpamClusterIndex::BandKey(const Signature &signature, uint32 band)
+{
+    uint64 key = band;
+    for (uint32 r = 0; r < ROWS; ++r)
+        key = Mix64(key ^ signature[band * ROWS + r]);
+
+    return key;
+}
+
+SpamClusterIndex::Result SpamClusterIndex::Insert(const std::string &text, uint32 accountId, uint32 now, float minSimilarity)
+{
+    Signature signature;
+    ComputeSignature(text, signature);
+
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    // every cluster sharing at least one band with the message is a candidate, keep the most similar one
+    Cluster *best = nullptr;
+    uint32 bestId = 0;
+    float bestSimilarity = minSimilarity;
+
+    for (uint32 band = 0; band < BANDS; ++band)
+    {
+        auto const range = _buckets.equal_range(BandKey(signature, band));
+
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (i->second == bestId)
+                continue;
+
+            auto &cluster = _clusters.at(i->second);
+            auto const similarity = Similarity(signature, cluster.signature);
+
+            if (similarity >= bestSimilarity)
+            {
+                best = &cluster;
+                bestId = i->second;
+                bestSimilarity = similarity;
+            }
+        }
+    }
+
+    if (!best)
+    {
+        if (_clusters.size() >= MAX_CLUSTERS)
+            return { 0, 0, 0 };
+
+        bestId = _nextId++;
+        best = &_clusters[bestId];
+        best->signature = signature;
+        best->sample = text;
+        best->messages = 0;
+
+        for (uint32 band = 0; band < BANDS; ++band)
+            _buckets.emplace(BandKey(signature, band), bestId);
+    }
+
+    best->accounts.insert(accountId);
+    ++best->messages;
+    best->lastSeen = now;
+
+    return { bestId, static_cast<uint32>(best->accounts.size()), best->messages };
+}
+
+void SpamClusterIndex::RemoveFromBuckets(uint32 clusterId, const Signature &signature)
+{
+    for (uint32 band = 0; band < BANDS; ++band)
+    {
+        auto const range = _buckets.equal_range(BandKey(signature, band));
+
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (i->second == clusterId)
+            {
+                _buckets.erase(i);
+                break;
+            }
+        }
+    }
+}
+
+void SpamClusterIndex::Expire(uint32 now, uint32 maxAge)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    for (auto i = _clusters.begin(); i != _clusters.end(); )
+    {
+        if (i->second.lastSeen + maxAge <= now)
+        {
+            RemoveFromBuckets(i->first, i->second.signature);
+            i = _clusters.erase(i);
+        }
+        else
+            ++i;
+    }
+}
+
+void SpamClusterIndex::Clear()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    _clusters.clear();
+    _buckets.clear();
+}
+
+size_t SpamClusterIndex::GetClusterCount() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _clusters.size();
+}
+
+SpamClusterIndex::Result SpamClusterIndex::GetLargestCluster(std::string &sample) const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    Result result = { 0, 0, 0 };
+
+    for (auto const &c : _clusters)
+    {
+        if (c.second.accounts.size() > result.accounts)
+        {
+            result = { c.first, static_cast<uint32>(c.second.accounts.size()), c.second.messages };
+            sample = c.second.sample;
+        }
+    }
+
+    return result;
+}
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017-2020 namreeb (legal@namreeb.org)
+ *
+ * This is private software and may not be shared under any circumstances,
+ * absent permission of namreeb.
+ */
+
+#ifndef __SPAMCLUSTERS_HPP_
+#define __SPAMCLUSTERS_HPP_
+
+#include "Platform/Define.h"
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace NamreebAnticheat
+{
+// groups near-identical (normalized) messages from all sessions, so that one spam wave sent from many accounts
+// is recognized even when each account only sends it a few times.  similarity is estimated with MinHash
+// signatures over character trigrams, and candidate clusters are found with locality sensitive hashing
+// (banded signatures), so inserting a message does not compare it against every known cluster.
+class SpamClusterIndex
+{
+    public:
+        static constexpr uint32 SIGNATURE_SIZE = 32;
+        static constexpr uint32 BANDS = 8;
+        static constexpr uint32 ROWS = SIGNATURE_SIZE / BANDS;
+
+        // the index stops creating new clusters beyond this, existing clusters still grow
+        static constexpr size_t MAX_CLUSTERS = 100000;
+
+        typedef std::array<uint32, SIGNATURE_SIZE> Signature;
+
+        struct Result
+        {
+            uint32 clusterId;       // zero if the message was not indexed
+            uint32 accounts;        // distinct accounts which sent a message of this cluster
+            uint32 messages;        // total messages of this cluster
+        };
+
+        SpamClusterIndex() : _nextId(1) {}
+
+        // adds a message sent by the given account.  it joins the most similar cluster whose estimated
+        // jaccard similarity is at least minSimilarity, or starts a new one
+        Result Insert(const std::string &text, uint32 accountId, uint32 now, float minSimilarity);
+
+        // removes clusters which have not seen a message in maxAge milliseconds
+        void Expire(uint32 now, uint32 maxAge);
+        void Clear();
+
+        size_t GetClusterCount() const;
+
+        // returns the cluster with the most distinct accounts, or zero accounts if the index is empty
+        Result GetLargestCluster(std::string &sample) const;
+
+        static void ComputeSignature(const std::string &text, Signature &signature);
+        static float Similarity(const Signature &a, const Signature &b);
+
+    private:
+        struct Cluster
+        {
+            Signature signature;
+            std::string sample;
+            std::unordered_set<uint32> accounts;
+            uint32 messages;
+            uint32 lastSeen;
+        };
+
+        static uint64 BandKey(const Signature &signature, uint32 band);
+
+        void RemoveFromBuckets(uint32 clusterId, const Signature &signature);
+
+        mutable std::mutex _mutex;
+
+        uint32 _nextId;
+        std::unordered_map<uint32, Cluster> _clusters;
+        std::unordered_multimap<uint64, uint32> _buckets;
+};
+}
+
+#endif /* !__SPAMCLUSTERS_HPP_ */
@@ -7,6 +7,8 @@
 #include "Antispam/antispam.hpp"
 #include "Globals/ObjectMgr.h"
 
+#include <fstream>
+
 bool ChatHandler::HandleAnticheatInfoCommand(char* args)
 {
     Player *target = nullptr;
@@ -281,4 +283,59 @@ bool ChatHandler::HandleAnticheatDebugExtrapCommand(char* args)
     PSendSysMessage("Extrapolation debug enabled for %u seconds", seconds);
 
     return true;
-}
\ No newline at end of file
+}
+
+// replays a recorded chat corpus through the antispam pipeline.  one message per line, optionally
+// prefixed with the sending account id and a tab.  lines without an account id get one each
+bool ChatHandler::HandleAnticheatSpambenchCommand(char* args)
+{
+    char* fileName = ExtractQuotedOrLiteralArg(&args);
+    if (!fileName)
+        return false;
+
+    uint32 repeats;
+    if (!ExtractOptUInt32(&args, repeats, 1) || !repeats)
+        return false;
+
+    std::ifstream file(fileName);
+    if (!file)
+    {
+        PSendSysMessage("Can not open chat corpus %s", fileName);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::vector<std::pair<uint32, std::string> > corpus;
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        uint32 accountId = uint32(corpus.size()) + 1;
+
+        auto const tab = line.find('\t');
+        if (tab != std::string::npos && tab > 0 && line.find_first_not_of("0123456789") == tab)
+        {
+            accountId = uint32(std::strtoul(line.c_str(), nullptr, 10));
+            line.erase(0, tab + 1);
+        }
+
+        if (!line.empty())
+            corpus.emplace_back(accountId, line);
+    }
+
+    if (corpus.empty())
+    {
+        PSendSysMessage("Chat corpus %s is empty", fileName);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::stringstream report(sAntispamMgr.Benchmark(corpus, repeats));
+    while (std::getline(report, line))
+        SendSysMessage(line.c_str());
+
+    return true;
+}
@@ -98,9 +98,14 @@ void AnticheatConfig::loadConfigSettings()
     setConfig(CONFIG_UINT32_AC_ANTISPAM_REPETITION_NOTIFY, "Antispam.RepetitionNotify", 50);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_REPETITION_SILENCE, "Antispam.RepetitionSilence", 0);
     setConfig(CONFIG_UINT32_AC_ANTISPAM_REPETITION_MOVEMENT_TIMEOUT, "Antispam.RepetitionMovementTimeout", 60);
+    setConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_NOTIFY, "Antispam.ClusterNotify", 0);
+    setConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_SILENCE, "Antispam.ClusterSilence", 0);
+    setConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_MIN_LENGTH, "Antispam.ClusterMinLength", 16);
+    setConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_EXPIRATION, "Antispam.ClusterExpiration", 600);
 
     setConfig(CONFIG_FLOAT_AC_ANTISPAM_REPETITION_DISTANCE_SCALE, "Antispam.RepetitionDistanceScale", 1.f);
     setConfig(CONFIG_FLOAT_AC_ANTISPAM_REPETITION_TIME_SCALE, "Antispam.RepetitionTimeScale", 0.f);
+    setConfig(CONFIG_FLOAT_AC_ANTISPAM_CLUSTER_SIMILARITY, "Antispam.ClusterSimilarity", 0.6f);
 
     for (auto i = 0; i < CHEATS_COUNT; ++i)
     {
@@ -30,6 +30,10 @@ enum AnticheatConfigUInt32Values
     CONFIG_UINT32_AC_ANTISPAM_REPETITION_NOTIFY,
     CONFIG_UINT32_AC_ANTISPAM_REPETITION_SILENCE,
     CONFIG_UINT32_AC_ANTISPAM_REPETITION_MOVEMENT_TIMEOUT,
+    CONFIG_UINT32_AC_ANTISPAM_CLUSTER_NOTIFY,
+    CONFIG_UINT32_AC_ANTISPAM_CLUSTER_SILENCE,
+    CONFIG_UINT32_AC_ANTISPAM_CLUSTER_MIN_LENGTH,
+    CONFIG_UINT32_AC_ANTISPAM_CLUSTER_EXPIRATION,
     CONFIG_UINT32_AC_FINGERPRINT_HISTORY,
     CONFIG_UINT32_AC_FINGERPRINT_LEVEL,
     CONFIG_UINT32_AC_KICK_DELAY_MIN,
@@ -68,6 +72,7 @@ enum AnticheatConfigFloatValues
 {
     CONFIG_FLOAT_AC_ANTISPAM_REPETITION_DISTANCE_SCALE = 0,
     CONFIG_FLOAT_AC_ANTISPAM_REPETITION_TIME_SCALE,
+    CONFIG_FLOAT_AC_ANTISPAM_CLUSTER_SIMILARITY,
     CONFIG_FLOAT_AC_COUNT
 };
 
@@ -161,6 +166,11 @@ class AnticheatConfig : public Config
         uint32 GetAntispamRepetitionMovementTimeout()   const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_REPETITION_MOVEMENT_TIMEOUT);    }
         float GetAntispamRepetitionDistanceScale()      const { return getConfig(CONFIG_FLOAT_AC_ANTISPAM_REPETITION_DISTANCE_SCALE);       }
         float GetAntispamRepetitionTimeScale()          const { return getConfig(CONFIG_FLOAT_AC_ANTISPAM_REPETITION_TIME_SCALE);           }
+        uint32 GetAntispamClusterNotify()               const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_NOTIFY);                 }
+        uint32 GetAntispamClusterSilence()              const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_SILENCE);                }
+        uint32 GetAntispamClusterMinLength()            const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_MIN_LENGTH);             }
+        uint32 GetAntispamClusterExpiration()           const { return getConfig(CONFIG_UINT32_AC_ANTISPAM_CLUSTER_EXPIRATION);             }
+        float GetAntispamClusterSimilarity()            const { return getConfig(CONFIG_FLOAT_AC_ANTISPAM_CLUSTER_SIMILARITY);              }
 
         static const char *GetDetectorName(CheatType cheatType);
 };
@@ -29,6 +29,7 @@
 #include <string>
 #include <algorithm>
 #include <vector>
+#include <cstdint>
 
 namespace nam
 {
@@ -46,7 +47,7 @@ constexpr T min3(const T &a, const T &b, const T &c)
 }
 }
 
-int damerau_levenshtein_distance(const std::string &string1, const std::string &string2)
+inline int damerau_levenshtein_distance(const std::string &string1, const std::string &string2)
 {
     auto const string1_length = string1.length();
     auto const string2_length = string2.length();
@@ -94,5 +95,106 @@ int damerau_levenshtein_distance(const std::string &string1, const std::string &
 
     return dist[get_index(columns, static_cast<int>(string1_length), static_cast<int>(string2_length))];
 }
+
+// bit-parallel version of damerau_levenshtein_distance (Hyyro's extension of Myers' algorithm), giving the same
+// (restricted) distance.  the pattern is preprocessed once and can then be compared against any number of strings
+// in O(ceil(m/64) * n) time, where m is the pattern length and n the length of the other string.
+class damerau_levenshtein_pattern
+{
+    private:
+        size_t _length;
+        size_t _words;
+
+        // one match bitmask (_words wide) per byte value
+        std::vector<uint64_t> _peq;
+
+    public:
+        explicit damerau_levenshtein_pattern(const std::string &pattern) :
+            _length(pattern.length()), _words((pattern.length() + 63) / 64), _peq(256 * ((pattern.length() + 63) / 64), 0)
+        {
+            for (size_t i = 0; i < _length; ++i)
+                _peq[static_cast<unsigned char>(pattern[i]) * _words + i / 64] |= uint64_t(1) << (i % 64);
+        }
+
+        size_t length() const { return _length; }
+
+        int distance(const std::string &text) const
+        {
+            if (!_length)
+                return static_cast<int>(text.length());
+
+            if (text.empty())
+                return static_cast<int>(_length);
+
+            // vertical delta vectors of the current column, and the previous column's diagonal zero/match vectors
+            std::vector<uint64_t> state(_words * 3, 0);
+            uint64_t *const vp = state.data();
+            uint64_t *const vn = vp + _words;
+            uint64_t *const d0_prev = vn + _words;
+
+            std::fill(vp, vp + _words, ~uint64_t(0));
+
+            auto const last_bit = uint64_t(1) << ((_length - 1) % 64);
+            auto score = static_cast<int>(_length);
+
+            const uint64_t *pm_prev = nullptr;
+
+            for (auto const c : text)
+            {
+                const uint64_t *const pm = &_peq[static_cast<unsigned char>(c) * _words];
+
+                uint64_t add_carry = 0, hp_carry = 1, hn_carry = 0, tr_carry = 0;
+
+                for (size_t w = 0; w < _words; ++w)
+                {
+                    auto const x = pm[w] | vn[w];
+
+                    // transposition: a match on this row in the previous column and on the row above in this column
+                    auto const tr = ~d0_prev[w] & pm[w];
+                    auto const tr_shift = pm_prev ? (((tr << 1) | tr_carry) & pm_prev[w]) : 0;
+                    tr_carry = tr >> 63;
+
+                    auto const masked = x & vp[w];
+                    auto const sum1 = masked + vp[w];
+                    auto const sum = sum1 + add_carry;
+                    add_carry = (sum1 < masked || sum < sum1) ? 1 : 0;
+
+                    auto const d0 = (sum ^ vp[w]) | x | tr_shift;
+                    auto const hp = vn[w] | ~(d0 | vp[w]);
+                    auto const hn = vp[w] & d0;
+
+                    if (w == _words - 1)
+                    {
+                        if (hp & last_bit)
+                            ++score;
+                        else if (hn & last_bit)
+                            --score;
+                    }
+
+                    auto const hp_shift = (hp << 1) | hp_carry;
+                    auto const hn_shift = (hn << 1) | hn_carry;
+                    hp_carry = hp >> 63;
+                    hn_carry = hn >> 63;
+
+                    vp[w] = hn_shift | ~(d0 | hp_shift);
+                    vn[w] = hp_shift & d0;
+                    d0_prev[w] = d0;
+                }
+
+                pm_prev = pm;
+            }
+
+            return score;
+        }
+};
+
+inline int damerau_levenshtein_distance_fast(const std::string &string1, const std::string &string2)
+{
+    // the distance is symmetric, so use the shorter string as the pattern to keep the bit vectors small
+    if (string1.length() < string2.length())
+        return damerau_levenshtein_pattern(string1).distance(string2);
+
+    return damerau_levenshtein_pattern(string2).distance(string1);
+}
 }
 #endif /* !__DLDIST_HPP_ */
\ No newline at end of file
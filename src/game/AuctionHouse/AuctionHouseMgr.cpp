@@ -435,6 +435,26 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id)
     return true;
 }
 
+std::wstring const& AuctionHouseMgr::GetItemSearchName(ItemPrototype const* proto, int loc_idx)
+{
+    ItemSearchNameMap& names = m_itemSearchNames[loc_idx];
+    ItemSearchNameMap::iterator itr = names.find(proto->ItemId);
+    if (itr != names.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+    sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+
+    // names failing conversion stay empty and never match a search, as with Utf8FitTo
+    std::wstring wname;
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return names.emplace(proto->ItemId, std::move(wname)).first->second;
+}
+
 void AuctionHouseMgr::Update()
 {
     for (auto& mAuction : mAuctions)
@@ -517,31 +537,85 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
+{
+    MANGOS_ASSERT(ah);
+    AuctionsMap[ah->Id] = ah;
+
+    AuctionIdSet& templateAuctions = m_auctionsByTemplate[ah->itemTemplate];
+    if (templateAuctions.empty())
+        if (ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(ah->itemTemplate))
+            m_templatesByClass[proto->Class].insert(ah->itemTemplate);
+    templateAuctions.insert(ah->Id);
+
+    m_expiryQueue.emplace(ah->expireTime, ah->Id);
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    uint32 itemTemplate = itr->second->itemTemplate;
+    AuctionsByTemplateMap::iterator templateItr = m_auctionsByTemplate.find(itemTemplate);
+    if (templateItr != m_auctionsByTemplate.end())
+    {
+        templateItr->second.erase(id);
+        if (templateItr->second.empty())
+        {
+            m_auctionsByTemplate.erase(templateItr);
+            if (ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(itemTemplate))
+            {
+                TemplatesByClassMap::iterator classItr = m_templatesByClass.find(proto->Class);
+                if (classItr != m_templatesByClass.end())
+                {
+                    classItr->second.erase(itemTemplate);
+                    if (classItr->second.empty())
+                        m_templatesByClass.erase(classItr);
+                }
+            }
+        }
+    }
+
+    // expiry queue entry is left behind and skipped when it comes up
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime)
+{
+    auction->expireTime = expireTime;
+    m_expiryQueue.emplace(expireTime, auction->Id);
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
-    ///- Handle expired auctions
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();)
+    ///- Handle expired auctions, earliest first
+    while (!m_expiryQueue.empty() && m_expiryQueue.top().first <= curTime)
     {
-        if (curTime < itr->second->expireTime)
-        {
-            itr++;
+        ExpiryQueueEntry next = m_expiryQueue.top();
+        m_expiryQueue.pop();
+
+        AuctionEntry* auction = GetAuction(next.second);
+        // already removed, or expire time changed after it was queued
+        if (!auction || auction->expireTime != next.first)
             continue;
-        }
 
-        ///- perform the transaction if there was bidder.  this will alyways have the side effect of
-        ///- removing the auction from the collection.  therefore we must increment the iterator here.
-        if (itr->second->bid)
-            (itr++)->second->AuctionBidWinning();
+        ///- perform the transaction if there was bidder. this will alyways have the side effect of
+        ///- removing the auction from the collection.
+        if (auction->bid)
+            auction->AuctionBidWinning();
         ///- cancel the auction if there was no bidder and clear the auction
         else
         {
-            sAuctionMgr.SendAuctionExpiredMail(itr->second);
+            sAuctionMgr.SendAuctionExpiredMail(auction);
 
-            itr->second->DeleteFromDB();
-            sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
-            delete itr->second;
-            AuctionsMap.erase(itr++);
+            auction->DeleteFromDB();
+            sAuctionMgr.RemoveAItem(auction->itemGuidLow);
+            RemoveAuction(auction->Id);
+            delete auction;
         }
     }
 }
@@ -582,75 +656,107 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-        std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
-        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-        uint32& count, uint32& totalcount)
+void AuctionHouseObject::MatchTemplateAuctions(uint32 itemTemplate, AuctionIdSet const& auctions, Player* player, int loc_idx,
+        std::wstring const& wsearchedname, uint32 levelmin, uint32 levelmax, uint32 usable,
+        uint32 inventoryType, uint32 itemSubClass, uint32 quality, std::vector<AuctionEntry*>& matches) const
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
+    ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(itemTemplate);
+    if (!proto)
+        return;
 
-    for (auto& AentryItr : AuctionsMap)
-    {
-        auto Aentry = AentryItr.second;
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-            continue;
+    if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
+        return;
 
+    if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+    {
+        if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
         {
-            ItemPrototype const* proto = item->GetProto();
+            // if inventory type is chest, we want to return robes too
+            // i.e. cloth chests are in most cases robes by definition
 
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
+            return;
+        }
+    }
 
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
+    if (quality != 0xffffffff && proto->Quality < quality)
+        return;
 
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            {
-                if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                {
-                    // if inventory type is chest, we want to return robes too
-                    // i.e. cloth chests are in most cases robes by definition
+    if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+        return;
 
-                    continue;
-                }
-            }
+    if (usable != 0x00 && proto->Class == ITEM_CLASS_RECIPE)
+    {
+        if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
+        {
+            if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
+                return;
+        }
+    }
 
-            if (quality != 0xffffffff && proto->Quality < quality)
-                continue;
+    if (!wsearchedname.empty() && sAuctionMgr.GetItemSearchName(proto, loc_idx).find(wsearchedname) == std::wstring::npos)
+        return;
 
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-                continue;
+    for (uint32 auctionId : auctions)
+    {
+        AuctionEntry* Aentry = GetAuction(auctionId);
+        if (!Aentry)
+            continue;
 
-            if (usable != 0x00)
-            {
-                if (player->CanUseItem(item) != EQUIP_ERR_OK)
-                    continue;
+        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
+        if (!item)
+            continue;
 
-                if (proto->Class == ITEM_CLASS_RECIPE)
-                {
-                    if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
-                    {
-                        if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
-                            continue;
-                    }
-                }
-            }
+        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+            continue;
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+        matches.push_back(Aentry);
+    }
+}
 
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
+        std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
+        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+        uint32& count, uint32& totalcount)
+{
+    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
 
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
+    std::vector<AuctionEntry*> matches;
+    if (itemClass != 0xffffffff)
+    {
+        TemplatesByClassMap::const_iterator classItr = m_templatesByClass.find(itemClass);
+        if (classItr != m_templatesByClass.end())
+        {
+            for (uint32 itemTemplate : classItr->second)
             {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
+                AuctionsByTemplateMap::const_iterator templateItr = m_auctionsByTemplate.find(itemTemplate);
+                if (templateItr != m_auctionsByTemplate.end())
+                    MatchTemplateAuctions(itemTemplate, templateItr->second, player, loc_idx,
+                                          wsearchedname, levelmin, levelmax, usable, inventoryType, itemSubClass, quality, matches);
             }
         }
+    }
+    else
+    {
+        for (auto const& templateAuctions : m_auctionsByTemplate)
+            MatchTemplateAuctions(templateAuctions.first, templateAuctions.second, player, loc_idx,
+                                  wsearchedname, levelmin, levelmax, usable, inventoryType, itemSubClass, quality, matches);
+    }
 
-        ++totalcount;
+    totalcount += matches.size();
+    if (listfrom >= matches.size())
+        return;
+
+    // only the requested page has to be in auction id order
+    auto byId = [](AuctionEntry const* left, AuctionEntry const* right) { return left->Id < right->Id; };
+    auto pageBegin = matches.begin() + listfrom;
+    auto pageEnd = matches.begin() + std::min<size_t>(matches.size(), listfrom + MAX_AUCTION_ITEMS_CLIENT_UI_PAGE - count);
+    std::nth_element(matches.begin(), pageBegin, matches.end(), byId);
+    std::partial_sort(pageBegin, pageEnd, matches.end(), byId);
+
+    for (auto itr = pageBegin; itr != pageEnd; ++itr)
+    {
+        ++count;
+        (*itr)->BuildAuctionInfo(data);
     }
 }
 
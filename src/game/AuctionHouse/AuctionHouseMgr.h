@@ -22,7 +22,11 @@
 #include "Common.h"
 #include "Server/DBCStructure.h"
 
+#include <queue>
+#include <set>
+
 class Item;
+struct ItemPrototype;
 class Player;
 class Unit;
 class WorldPacket;
@@ -98,11 +102,7 @@ class AuctionHouseObject
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -110,7 +110,10 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : nullptr;
         }
 
-        bool RemoveAuction(uint32 id) { return !!AuctionsMap.erase(id); }
+        bool RemoveAuction(uint32 id);
+
+        // expire time must only be changed here for listed auctions, expiry queue is ordered by it
+        void SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime);
 
         void Update();
 
@@ -122,7 +125,24 @@ class AuctionHouseObject
                                    uint32& count, uint32& totalcount);
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        typedef std::set<uint32> AuctionIdSet;                                              // ordered, pages are listed by auction id
+        typedef std::unordered_map<uint32, AuctionIdSet> AuctionsByTemplateMap;             // item template -> auctions
+        typedef std::unordered_map<uint32, std::set<uint32>> TemplatesByClassMap;           // item class -> item templates with auctions
+        typedef std::pair<time_t, uint32> ExpiryQueueEntry;                                 // expire time, auction id
+        typedef std::priority_queue<ExpiryQueueEntry, std::vector<ExpiryQueueEntry>, std::greater<ExpiryQueueEntry>> ExpiryQueue;
+
+        void MatchTemplateAuctions(uint32 itemTemplate, AuctionIdSet const& auctions, Player* player, int loc_idx,
+                                   std::wstring const& wsearchedname, uint32 levelmin, uint32 levelmax, uint32 usable,
+                                   uint32 inventoryType, uint32 itemSubClass, uint32 quality, std::vector<AuctionEntry*>& matches) const;
+
         AuctionEntryMap AuctionsMap;
+
+        // search filters are item template properties, so they are checked once per template instead of once per auction
+        AuctionsByTemplateMap m_auctionsByTemplate;
+        TemplatesByClassMap m_templatesByClass;
+
+        // min-heap on expire time, entries of removed or rescheduled auctions are skipped when popped
+        ExpiryQueue m_expiryQueue;
 };
 
 enum AuctionHouseType
@@ -145,6 +165,10 @@ class AuctionHouseMgr
         AuctionHouseObject* GetAuctionsMap(AuctionHouseType houseType) { return &mAuctions[houseType]; }
         AuctionHouseObject* GetAuctionsMap(AuctionHouseEntry const* house);
 
+        // lower case localized item name as compared by auction search, cached per locale
+        std::wstring const& GetItemSearchName(ItemPrototype const* proto, int loc_idx);
+        void ClearItemSearchNames() { m_itemSearchNames.clear(); }
+
         Item* GetAItem(uint32 id)
         {
             ItemMap::const_iterator itr = mAitems.find(id);
@@ -175,9 +199,13 @@ class AuctionHouseMgr
         void Update();
 
     private:
+        typedef std::unordered_map<uint32, std::wstring> ItemSearchNameMap;
+
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        std::map<int, ItemSearchNameMap> m_itemSearchNames;     // locale index -> item template -> name
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
@@ -18,6 +18,7 @@
 
 #include "Entities/Object.h"
 #include "Entities/Player.h"
+#include "Entities/CharacterPrefetch.h"
 #include "BattleGround.h"
 #include "BattleGroundMgr.h"
 #include "Entities/Creature.h"
@@ -299,6 +300,7 @@ void BattleGround::Update(uint32 diff)
             {
                 // add deserter at next login
                 CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", uint32(AT_LOGIN_ADD_BG_DESERTER), itr->first.GetCounter());
+                sCharacterPrefetch.Invalidate(itr->first);
 
                 RemovePlayerAtLeave(itr->first, true, true);// remove player from BG
                 m_offlineQueue.pop_front();                 // remove from offline queue
@@ -25,11 +25,17 @@
 #include "Maps/MapManager.h"
 #include "Server/WorldPacket.h"
 
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+
  /*********************************************************/
  /***            BATTLEGROUND QUEUE SYSTEM              ***/
  /*********************************************************/
 
-BattleGroundQueueItem::BattleGroundQueueItem()
+BattleGroundQueueItem::BattleGroundQueueItem() : m_frontOrder(0), m_backOrder(0)
 {
     for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
     {
@@ -135,10 +141,197 @@ bool BattleGroundQueueItem::SelectionPool::AddGroup(GroupQueueInfo* queueInfo, u
     return playerCount < desiredCount;
 }
 
+/*********************************************************/
+/***         BATTLEGROUND QUEUE SIZE INDEX             ***/
+/*********************************************************/
+
+void BattleGroundQueueSizeIndex::Insert(GroupQueueInfo* group)
+{
+    uint32 size = group->players.size();
+    if (!size)
+        return;
+
+    if (m_bySize.size() <= size)
+        m_bySize.resize(size + 1);
+
+    m_bySize[size][group->queueOrder] = group;
+    group->indexedSize = size;
+    m_playerCount += size;
+}
+
+void BattleGroundQueueSizeIndex::Erase(GroupQueueInfo* group)
+{
+    if (!group->indexedSize)
+        return;
+
+    m_bySize[group->indexedSize].erase(group->queueOrder);
+    m_playerCount -= group->indexedSize;
+    group->indexedSize = 0;
+}
+
+/**
+  Function that returns the group the queue walk would pick next - the first one behind afterOrder that fits
+  - returns nullptr when no such group is queued
+
+  @param    queue order of the last picked group
+  @param    free slots
+  @param    battleground client instance id
+*/
+GroupQueueInfo* BattleGroundQueueSizeIndex::FindOldestFitting(int64 afterOrder, uint32 maxSize, uint32 bgInstanceId) const
+{
+    GroupQueueInfo* oldest = nullptr;
+    uint32 sizeEnd = m_bySize.size() > maxSize ? maxSize + 1 : m_bySize.size();
+    for (uint32 size = 1; size < sizeEnd; ++size)
+    {
+        for (OrderedGroups::const_iterator itr = m_bySize[size].upper_bound(afterOrder); itr != m_bySize[size].end(); ++itr)
+        {
+            if (oldest && itr->first > oldest->queueOrder)
+                break;
+
+            GroupQueueInfo* group = itr->second;
+            if (!group->desiredInstanceId || group->desiredInstanceId == bgInstanceId)
+            {
+                oldest = group;
+                break;
+            }
+        }
+    }
+    return oldest;
+}
+
 /*********************************************************/
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
 
+/**
+  Method that puts group to the front or the back of a queue list and indexes it, when it still waits for invitation
+
+  @param    group queue info
+  @param    bracket id
+  @param    BG_QUEUE_* list
+  @param    front
+*/
+void BattleGroundQueueItem::LinkGroup(GroupQueueInfo* group, BattleGroundBracketId bracketId, uint32 queueIndex, bool front)
+{
+    GroupsQueueType& groups = m_queuedGroups[bracketId][queueIndex];
+    group->queueIndex = queueIndex;
+    group->indexedSize = 0;
+    if (front)
+    {
+        group->queueOrder = --m_frontOrder;
+        group->queueItr = groups.insert(groups.begin(), group);
+    }
+    else
+    {
+        group->queueOrder = ++m_backOrder;
+        group->queueItr = groups.insert(groups.end(), group);
+    }
+
+    if (!group->isInvitedToBgInstanceGuid)
+        m_sizeIndex[bracketId][queueIndex].Insert(group);
+}
+
+void BattleGroundQueueItem::UnlinkGroup(GroupQueueInfo* group)
+{
+    m_sizeIndex[group->bgBracketId][group->queueIndex].Erase(group);
+    m_queuedGroups[group->bgBracketId][group->queueIndex].erase(group->queueItr);
+}
+
+/**
+  Method that adds queued groups to selection pool in queue order, skipping groups which do not fit, until pool holds stopCount players
+  - same selection as walking the queue list with SelectionPool::AddGroup, but only fitting groups are visited
+
+  @param    selection pool
+  @param    bracket id
+  @param    BG_QUEUE_* list
+  @param    player count to stop at
+  @param    max player count of the pool
+  @param    battleground client instance id
+  @param    queue order of the last visited group, continued from and updated
+*/
+void BattleGroundQueueItem::FillSelectionPool(SelectionPool& pool, BattleGroundBracketId bracketId, uint32 queueIndex, uint32 stopCount, uint32 maxCount, uint32 bgInstanceId, int64& position)
+{
+    BattleGroundQueueSizeIndex const& sizeIndex = m_sizeIndex[bracketId][queueIndex];
+    while (pool.GetPlayerCount() < stopCount && pool.GetPlayerCount() < maxCount)
+    {
+        GroupQueueInfo* group = sizeIndex.FindOldestFitting(position, maxCount - pool.GetPlayerCount(), bgInstanceId);
+        if (!group)
+            break;
+
+        pool.AddGroup(group, maxCount, bgInstanceId);
+        position = group->queueOrder;
+    }
+}
+
+/**
+  Function that replaces the selection pool with the oldest combination of queued groups holding minCount to maxCount players
+  - greedy walk in queue order, backtracking over a bounded number of candidates when the greedy choice overshoots
+  - returns false (pool untouched) when no such combination was found
+
+  @param    selection pool
+  @param    bracket id
+  @param    BG_QUEUE_* list
+  @param    min player count
+  @param    max player count
+*/
+bool BattleGroundQueueItem::BalanceSelectionPool(SelectionPool& pool, BattleGroundBracketId bracketId, uint32 queueIndex, uint32 minCount, uint32 maxCount)
+{
+    uint32 const maxCandidates = 32;
+    uint32 const maxSteps = 1000;
+
+    std::vector<GroupQueueInfo*> candidates;
+    int64 position = std::numeric_limits<int64>::min();
+    while (candidates.size() < maxCandidates)
+    {
+        GroupQueueInfo* group = m_sizeIndex[bracketId][queueIndex].FindOldestFitting(position, maxCount, 0);
+        if (!group)
+            break;
+
+        candidates.push_back(group);
+        position = group->queueOrder;
+    }
+
+    // depth first over include / exclude of each candidate, including first keeps the oldest groups
+    std::vector<uint32> chosen;
+    std::vector<uint32> sums;
+    uint32 steps = 0;
+    uint32 next = 0;
+    uint32 sum = 0;
+    while (sum < minCount && steps < maxSteps)
+    {
+        ++steps;
+        if (next < candidates.size())
+        {
+            uint32 size = candidates[next]->players.size();
+            if (sum + size <= maxCount)
+            {
+                chosen.push_back(next);
+                sums.push_back(sum);
+                sum += size;
+            }
+            ++next;
+            continue;
+        }
+
+        // out of candidates - drop the youngest chosen group and continue behind it
+        if (chosen.empty())
+            break;
+
+        next = chosen.back() + 1;
+        sum = sums.back();
+        chosen.pop_back();
+        sums.pop_back();
+    }
+
+    if (sum < minCount || sum > maxCount)
+        return false;
+
+    pool.Init();
+    for (uint32 index : chosen)
+        pool.AddGroup(candidates[index], maxCount, 0);
+    return true;
+}
+
 /**
   Function that adds group or player (grp == nullptr) to battleground queue with the given leader and specifications
 
@@ -165,6 +358,7 @@ GroupQueueInfo* BattleGroundQueueItem::AddGroup(ObjectGuid leader, AddGroupToQue
     queueInfo->removeInviteTime = 0;
     queueInfo->groupTeam = groupInfo.team;
     queueInfo->desiredInstanceId = instanceId;
+    queueInfo->indexedSize = 0;
 
     queueInfo->players.clear();
 
@@ -202,7 +396,7 @@ GroupQueueInfo* BattleGroundQueueItem::AddGroup(ObjectGuid leader, AddGroupToQue
         }
 
         // add GroupInfo to m_QueuedGroups
-        m_queuedGroups[bracketId][index].push_back(queueInfo);
+        LinkGroup(queueInfo, bracketId, index, false);
 
         // announce to world, this code needs mutex
         if (!isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -211,18 +405,10 @@ GroupQueueInfo* BattleGroundQueueItem::AddGroup(ObjectGuid leader, AddGroupToQue
             {
                 char const* bgName = bg->GetName();
                 uint32 minPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_sizeIndex[bracketId][BG_QUEUE_NORMAL_HORDE].GetPlayerCount();
+                uint32 qAlliance = m_sizeIndex[bracketId][BG_QUEUE_NORMAL_ALLIANCE].GetPlayerCount();
                 uint32 q_min_level = sBattleGroundMgr.GetMinLevelForBattleGroundBracketId(bracketId, bgTypeId);
                 uint32 qMaxLevel = sBattleGroundMgr.GetMaxLevelForBattleGroundBracketId(bracketId, bgTypeId);
-                GroupsQueueType::const_iterator itr;
-                for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->isInvitedToBgInstanceGuid)
-                        qAlliance += (*itr)->players.size();
-
-                for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->isInvitedToBgInstanceGuid)
-                        qHorde += (*itr)->players.size();
 
                 sWorld.GetMessager().AddMessage([playerGuid = leader, bgName, q_min_level, qMaxLevel, qAlliance, minPlayers, qHorde](World* /*world*/)
                 {
@@ -257,6 +443,8 @@ GroupQueueInfo* BattleGroundQueueItem::AddGroup(ObjectGuid leader, AddGroupToQue
 void BattleGroundQueueItem::PlayerInvitedToBgUpdateAverageWaitTime(GroupQueueInfo* queueInfo, BattleGroundBracketId bracketId)
 {
     uint32 timeInQueue = WorldTimer::getMSTimeDiff(queueInfo->joinTime, WorldTimer::getMSTime());
+    sWorld.GetBGQueue().GetInviteLatency().Add(timeInQueue);
+
     uint8 teamIndex = TEAM_INDEX_ALLIANCE;                     // default set to BG_TEAM_ALLIANCE - or non rated arenas!
 
     if (queueInfo->groupTeam == HORDE)
@@ -307,8 +495,6 @@ uint32 BattleGroundQueueItem::GetAverageQueueWaitTime(GroupQueueInfo* queueInfo,
 */
 void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid guid, bool decreaseInvitedCount)
 {
-    int32 bracketId = -1;                                   // signed for proper for-loop finish
-
     // remove player from map, if he's there
     QueuedPlayersMap::iterator itr = m_queuedPlayers.find(guid);
     if (itr == m_queuedPlayers.end())
@@ -318,45 +504,18 @@ void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid gu
     }
 
     GroupQueueInfo* group = itr->second.groupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = GetTeamIndexByTeamId(group->groupTeam);
-
-    for (int8 bracketIdTmp = MAX_BATTLEGROUND_BRACKETS - 1; bracketIdTmp >= 0 && bracketId == -1; --bracketIdTmp)
-    {
-        // we must check premade and normal team's queue - because when players from premade are joining bg,
-        // they leave groupinfo so we can't use its players size to find out index
-        for (uint8 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (GroupsQueueType::iterator group_itr_tmp = m_queuedGroups[bracketIdTmp][j].begin(); group_itr_tmp != m_queuedGroups[bracketIdTmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracketId = bracketIdTmp;
-                    group_itr = group_itr_tmp;
-                    // we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-
-    // player can't be in queue without group, but just in case
-    if (bracketId == -1)
-    {
-        sLog.outError("BattleGroundQueueItem: ERROR Cannot find groupinfo for %s", guid.GetString().c_str());
-        return;
-    }
-    DEBUG_LOG("BattleGroundQueueItem: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)bracketId);
+    DEBUG_LOG("BattleGroundQueueItem: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)group->bgBracketId);
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
     // remove player from group
     // if only one player there, remove group
 
+    // size index buckets by player count, take the group out while it shrinks
+    BattleGroundQueueSizeIndex& sizeIndex = m_sizeIndex[group->bgBracketId][group->queueIndex];
+    bool indexed = group->indexedSize != 0;
+    sizeIndex.Erase(group);
+
     // remove player queue info from group queue info
     GroupQueueInfoPlayers::iterator pitr = group->players.find(guid);
     if (pitr != group->players.end())
@@ -375,9 +534,11 @@ void BattleGroundQueueItem::RemovePlayer(BattleGroundQueue& queue, ObjectGuid gu
     // remove group queue info if needed
     if (group->players.empty())
     {
-        m_queuedGroups[bracketId][index].erase(group_itr);
+        m_queuedGroups[group->bgBracketId][group->queueIndex].erase(group->queueItr);
         delete group;
     }
+    else if (indexed)
+        sizeIndex.Insert(group);
 }
 
 /**
@@ -431,6 +592,7 @@ bool BattleGroundQueueItem::InviteGroupToBg(GroupQueueInfo* groupInfo, BattleGro
         // not yet invited
         // set invitation
         groupInfo->isInvitedToBgInstanceGuid = queueInfo.GetInstanceId();
+        m_sizeIndex[groupInfo->bgBracketId][groupInfo->queueIndex].Erase(groupInfo);
         groupInfo->mapId = queueInfo.GetMapId();
         groupInfo->clientInstanceId = queueInfo.GetClientInstanceId();
         BattleGroundTypeId bgTypeId = queueInfo.GetTypeId();
@@ -496,21 +658,13 @@ void BattleGroundQueueItem::FillPlayersToBg(BattleGroundInQueueInfo& queueInfo,
     int32 hordeFree = queueInfo.GetFreeSlotsForTeam(HORDE);
     int32 aliFree = queueInfo.GetFreeSlotsForTeam(ALLIANCE);
 
-    // iterator for iterating through bg queue
-    GroupsQueueType::const_iterator Ali_itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin();
-    // count of groups in queue - used to stop cycles
-    uint32 aliCount = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].size();
-    // index to queue which group is current
-    uint32 aliIndex = 0;
-    for (; aliIndex < aliCount && m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), aliFree, queueInfo.GetClientInstanceId()); ++aliIndex)
-        ++Ali_itr;
+    // queue position of the last group added to the pool
+    int64 aliPosition = std::numeric_limits<int64>::min();
+    FillSelectionPool(m_selectionPools[TEAM_INDEX_ALLIANCE], bracketId, BG_QUEUE_NORMAL_ALLIANCE, aliFree, aliFree, queueInfo.GetClientInstanceId(), aliPosition);
 
     // the same thing for horde
-    GroupsQueueType::const_iterator Horde_itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin();
-    uint32 hordeCount = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].size();
-    uint32 hordeIndex = 0;
-    for (; hordeIndex < hordeCount && m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), hordeFree, queueInfo.GetClientInstanceId()); ++hordeIndex)
-        ++Horde_itr;
+    int64 hordePosition = std::numeric_limits<int64>::min();
+    FillSelectionPool(m_selectionPools[TEAM_INDEX_HORDE], bracketId, BG_QUEUE_NORMAL_HORDE, hordeFree, hordeFree, queueInfo.GetClientInstanceId(), hordePosition);
 
     // if ofc like BG queue invitation is set in config, then we are happy
     if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE) == 0)
@@ -535,8 +689,8 @@ void BattleGroundQueueItem::FillPlayersToBg(BattleGroundInQueueInfo& queueInfo,
             // kick alliance group, add to pool new group if needed
             if (m_selectionPools[TEAM_INDEX_ALLIANCE].KickGroup(diffHorde - diffAli))
             {
-                for (; aliIndex < aliCount && m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*Ali_itr), (aliFree >= diffHorde) ? aliFree - diffHorde : 0, queueInfo.GetClientInstanceId()); ++aliIndex)
-                    ++Ali_itr;
+                uint32 desired = (aliFree >= diffHorde) ? aliFree - diffHorde : 0;
+                FillSelectionPool(m_selectionPools[TEAM_INDEX_ALLIANCE], bracketId, BG_QUEUE_NORMAL_ALLIANCE, desired, desired, queueInfo.GetClientInstanceId(), aliPosition);
             }
             // if ali selection is already empty, then kick horde group, but if there are less horde than ali in bg - break;
             if (!m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
@@ -551,8 +705,8 @@ void BattleGroundQueueItem::FillPlayersToBg(BattleGroundInQueueInfo& queueInfo,
             // kick horde group, add to pool new group if needed
             if (m_selectionPools[TEAM_INDEX_HORDE].KickGroup(diffAli - diffHorde))
             {
-                for (; hordeIndex < hordeCount && m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*Horde_itr), (hordeFree >= diffAli) ? hordeFree - diffAli : 0, queueInfo.GetClientInstanceId()); ++hordeIndex)
-                    ++Horde_itr;
+                uint32 desired = (hordeFree >= diffAli) ? hordeFree - diffAli : 0;
+                FillSelectionPool(m_selectionPools[TEAM_INDEX_HORDE], bracketId, BG_QUEUE_NORMAL_HORDE, desired, desired, queueInfo.GetClientInstanceId(), hordePosition);
             }
             if (!m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
             {
@@ -584,30 +738,21 @@ bool BattleGroundQueueItem::CheckPremadeMatch(BattleGroundBracketId bracketId, u
     {
         // start premade match
         // if groups aren't invited
-        GroupsQueueType::const_iterator ali_group, horde_group;
-        for (ali_group = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].begin(); ali_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end(); ++ali_group)
-            if (!(*ali_group)->isInvitedToBgInstanceGuid)
-                break;
-
-        for (horde_group = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].begin(); horde_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end(); ++horde_group)
-            if (!(*horde_group)->isInvitedToBgInstanceGuid)
-                break;
+        int64 const queueStart = std::numeric_limits<int64>::min();
+        GroupQueueInfo* aliGroup = m_sizeIndex[bracketId][BG_QUEUE_PREMADE_ALLIANCE].FindOldestFitting(queueStart, maxPlayersPerTeam, 0);
+        GroupQueueInfo* hordeGroup = m_sizeIndex[bracketId][BG_QUEUE_PREMADE_HORDE].FindOldestFitting(queueStart, maxPlayersPerTeam, 0);
 
-        if (ali_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end() && horde_group != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end())
+        if (aliGroup && hordeGroup)
         {
-            m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*ali_group), maxPlayersPerTeam, 0);
-            m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*horde_group), maxPlayersPerTeam, 0);
+            m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup(aliGroup, maxPlayersPerTeam, 0);
+            m_selectionPools[TEAM_INDEX_HORDE].AddGroup(hordeGroup, maxPlayersPerTeam, 0);
 
             // add groups/players from normal queue to size of bigger group
             uint32 maxPlayers = std::max(m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount(), m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount());
             for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
             {
-                for (GroupsQueueType::const_iterator itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++itr)
-                {
-                    // if itr can join BG and player count is less that maxPlayers, then add group to selectionpool
-                    if (!(*itr)->isInvitedToBgInstanceGuid && !m_selectionPools[i].AddGroup((*itr), maxPlayers, 0))
-                        break;
-                }
+                int64 position = queueStart;
+                FillSelectionPool(m_selectionPools[i], bracketId, BG_QUEUE_NORMAL_ALLIANCE + i, maxPlayers, maxPlayers, 0, position);
             }
 
             // premade selection pools are set
@@ -623,12 +768,12 @@ bool BattleGroundQueueItem::CheckPremadeMatch(BattleGroundBracketId bracketId, u
     {
         if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
         {
-            GroupsQueueType::iterator itr = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->isInvitedToBgInstanceGuid && ((*itr)->joinTime < time_before || (*itr)->players.size() < minPlayersPerTeam))
+            GroupQueueInfo* group = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].front();
+            if (!group->isInvitedToBgInstanceGuid && (group->joinTime < time_before || group->players.size() < minPlayersPerTeam))
             {
                 // we must insert group to normal queue and erase pointer from premade queue
-                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                UnlinkGroup(group);
+                LinkGroup(group, bracketId, BG_QUEUE_NORMAL_ALLIANCE + i, true);
             }
         }
     }
@@ -647,19 +792,11 @@ bool BattleGroundQueueItem::CheckPremadeMatch(BattleGroundBracketId bracketId, u
 */
 bool BattleGroundQueueItem::CheckNormalMatch(BattleGroundQueue& queue, BattleGround* bgTemplate, BattleGroundBracketId bracketId, uint32 minPlayers, uint32 maxPlayers)
 {
-    GroupsQueueType::const_iterator itr_team[PVP_TEAM_COUNT];
+    int64 position[PVP_TEAM_COUNT];
     for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
     {
-        itr_team[i] = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].begin();
-        for (; itr_team[i] != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++(itr_team[i]))
-        {
-            if (!(*(itr_team[i]))->isInvitedToBgInstanceGuid)
-            {
-                m_selectionPools[i].AddGroup(*(itr_team[i]), maxPlayers, 0);
-                if (m_selectionPools[i].GetPlayerCount() >= minPlayers)
-                    break;
-            }
-        }
+        position[i] = std::numeric_limits<int64>::min();
+        FillSelectionPool(m_selectionPools[i], bracketId, BG_QUEUE_NORMAL_ALLIANCE + i, minPlayers, maxPlayers, 0, position[i]);
     }
 
     // try to invite same number of players - this cycle may cause longer wait time even if there are enough players in queue, but we want ballanced bg
@@ -671,16 +808,19 @@ bool BattleGroundQueueItem::CheckNormalMatch(BattleGroundQueue& queue, BattleGro
         && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() >= minPlayers && m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() >= minPlayers)
     {
         // we will try to invite more groups to team with less players indexed by j
-        ++(itr_team[j]);                                    // this will not cause a crash, because for cycle above reached break;
-        for (; itr_team[j] != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + j].end(); ++(itr_team[j]))
+        uint32 otherCount = m_selectionPools[(j + 1) % PVP_TEAM_COUNT].GetPlayerCount();
+        FillSelectionPool(m_selectionPools[j], bracketId, BG_QUEUE_NORMAL_ALLIANCE + j, otherCount, otherCount, 0, position[j]);
+
+        // do not allow to start bg with more than 2 players more on 1 faction
+        // the greedy walk overshot on the other faction, look for a smaller combination of its groups
+        uint32 smallCount = m_selectionPools[j].GetPlayerCount();
+        if (otherCount > smallCount + 2)
         {
-            if (!(*(itr_team[j]))->isInvitedToBgInstanceGuid)
-                if (!m_selectionPools[j].AddGroup(*(itr_team[j]), m_selectionPools[(j + 1) % PVP_TEAM_COUNT].GetPlayerCount(), 0))
-                    break;
+            uint32 k = (j + 1) % PVP_TEAM_COUNT;
+            uint32 minCount = std::max(minPlayers, smallCount > 2 ? smallCount - 2 : 0);
+            if (!BalanceSelectionPool(m_selectionPools[k], bracketId, BG_QUEUE_NORMAL_ALLIANCE + k, minCount, std::min(maxPlayers, smallCount + 2)))
+                return false;
         }
-        // do not allow to start bg with more than 2 players more on 1 faction
-        if (abs((int32)(m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() - m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())) > 2)
-            return false;
     }
 
     // allow 1v0 if debug bg
@@ -745,20 +885,9 @@ bool BattleGroundQueueItem::CheckSkirmishForSameFaction(BattleGroundBracketId br
         // set correct team
         (*itr)->groupTeam = otherTeamId;
 
-        // add team to other queue
-        m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx].push_front(*itr);
-
-        // remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].erase(itr2);
-                break;
-            }
-        }
+        // move team to the front of other queue
+        UnlinkGroup(*itr);
+        LinkGroup(*itr, bracketId, BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx, true);
     }
     return true;
 }
@@ -921,6 +1050,131 @@ void BattleGroundQueueItem::Update(BattleGroundQueue& queue, BattleGroundTypeId
     }
 }
 
+/**
+  Function that replays a synthetic queue trace on a private queue item - players join (mostly solo, some groups of 2-5),
+  now and then one leaves, and after each change the normal match check runs, popping the selection when it succeeds
+  - returns the timing report
+
+  @param    players kept in queue
+  @param    pops to replay
+*/
+std::string BattleGroundQueueItem::Benchmark(uint32 queuedPlayers, uint32 pops)
+{
+    uint32 const minPlayersPerTeam = 10;
+    uint32 const maxPlayersPerTeam = 15;
+    BattleGroundBracketId const bracketId = BG_BRACKET_ID_FIRST;
+    BattleGroundQueue& queue = sWorld.GetBGQueue();         // only asked whether testing is on
+
+    std::unique_ptr<BattleGroundQueueItem> item(new BattleGroundQueueItem);
+    std::vector<ObjectGuid> joined;
+    uint32 guidCounter = 0;
+
+    auto join = [&]()
+    {
+        uint32 team = urand(0, PVP_TEAM_COUNT - 1);
+        GroupQueueInfo* group = new GroupQueueInfo;
+        group->groupTeam = team == TEAM_INDEX_ALLIANCE ? ALLIANCE : HORDE;
+        group->bgTypeId = BATTLEGROUND_WS;
+        group->bgBracketId = bracketId;
+        group->mapId = 0;
+        group->clientInstanceId = 0;
+        group->joinTime = WorldTimer::getMSTime();
+        group->removeInviteTime = 0;
+        group->isInvitedToBgInstanceGuid = 0;
+        group->desiredInstanceId = 0;
+
+        uint32 size = urand(0, 3) ? 1 : urand(2, 5);
+        for (uint32 i = 0; i < size; ++i)
+        {
+            ObjectGuid guid(HIGHGUID_PLAYER, ++guidCounter);
+            PlayerQueueInfo& playerInfo = item->m_queuedPlayers[guid];
+            playerInfo.lastOnlineTime = group->joinTime;
+            playerInfo.groupInfo = group;
+            group->players[guid] = &playerInfo;
+            joined.push_back(guid);
+        }
+        item->LinkGroup(group, bracketId, BG_QUEUE_NORMAL_ALLIANCE + team, false);
+    };
+
+    auto leave = [&]()
+    {
+        while (!joined.empty())
+        {
+            uint32 index = urand(0, joined.size() - 1);
+            ObjectGuid guid = joined[index];
+            joined[index] = joined.back();
+            joined.pop_back();
+            if (item->m_queuedPlayers.find(guid) != item->m_queuedPlayers.end())
+            {
+                item->RemovePlayer(queue, guid, false);
+                return;
+            }
+        }
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration joinTime = Clock::duration::zero(), leaveTime = Clock::duration::zero(), checkTime = Clock::duration::zero(), maxCheckTime = Clock::duration::zero();
+    uint32 joinCount = 0, leaveCount = 0, checkCount = 0, popCount = 0, imbalance = 0;
+
+    while (popCount < pops && checkCount < pops * 4)
+    {
+        Clock::time_point start = Clock::now();
+        uint32 joins = 0;
+        while (item->m_queuedPlayers.size() < queuedPlayers)
+        {
+            join();
+            ++joins;
+        }
+        joinTime += Clock::now() - start;
+        joinCount += joins;
+
+        if (urand(0, 3) == 0)
+        {
+            start = Clock::now();
+            leave();
+            leaveTime += Clock::now() - start;
+            ++leaveCount;
+        }
+
+        item->m_selectionPools[TEAM_INDEX_ALLIANCE].Init();
+        item->m_selectionPools[TEAM_INDEX_HORDE].Init();
+        start = Clock::now();
+        bool match = item->CheckNormalMatch(queue, nullptr, bracketId, minPlayersPerTeam, maxPlayersPerTeam);
+        Clock::duration elapsed = Clock::now() - start;
+        checkTime += elapsed;
+        maxCheckTime = std::max(maxCheckTime, elapsed);
+        ++checkCount;
+
+        if (!match)
+            continue;
+
+        // pop - selected players leave the queue for the new battleground
+        ++popCount;
+        imbalance += abs(int32(item->m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount()) - int32(item->m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount()));
+        std::vector<ObjectGuid> popped;
+        for (SelectionPool const& pool : item->m_selectionPools)
+            for (GroupQueueInfo const* group : pool.selectedGroups)
+                for (auto const& player : group->players)
+                    popped.push_back(player.first);
+
+        for (ObjectGuid guid : popped)
+            item->RemovePlayer(queue, guid, false);
+    }
+
+    auto micros = [](Clock::duration duration, uint32 count)
+    {
+        return count ? std::chrono::duration<double, std::micro>(duration).count() / count : 0.0;
+    };
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2);
+    report << "BattleGround queue benchmark: " << queuedPlayers << " players queued, " << popCount << " pops in " << checkCount << " match checks\n";
+    report << "Match check: " << micros(checkTime, checkCount) << " us average, " << micros(maxCheckTime, 1) << " us max\n";
+    report << "Join: " << micros(joinTime, joinCount) << " us per group, leave: " << micros(leaveTime, leaveCount) << " us per player\n";
+    report << "Average faction imbalance per pop: " << (popCount ? double(imbalance) / popCount : 0.0);
+    return report.str();
+}
+
 /*********************************************************/
 /***            BATTLEGROUND QUEUE EVENTS              ***/
 /*********************************************************/
@@ -1053,17 +1307,19 @@ void BgQueueRemoveEvent::Abort(uint64 /*e_time*/)
     // do nothing
 }
 
-BattleGroundQueue::BattleGroundQueue() : m_testing(false)
+BattleGroundQueue::BattleGroundQueue() : m_testing(false), m_updateCount(0)
 {
 
 }
 
 void BattleGroundQueue::Update()
 {
-    TimePoint previously = sWorld.GetCurrentClockTime();
     while (!World::IsStopped())
     {
-        TimePoint now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+        // nothing in here is timed, invite reminders and timeouts are player events which send a message when due
+        GetMessager().WaitForMessages();
+
+        ++m_updateCount;
         GetMessager().Execute(this);
 
         // update scheduled queues
@@ -1085,8 +1341,6 @@ void BattleGroundQueue::Update()
                 m_battleGroundQueues[bgQueueTypeId].Update(*this, bgTypeId, bracket_id);
             }
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
     };
 }
 
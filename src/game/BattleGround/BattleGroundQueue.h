@@ -21,6 +21,9 @@
 
 #include "Common.h"
 #include "BattleGround/BattleGround.h"
+#include "Util/LatencyStats.h"
+
+#include <atomic>
 
 struct GroupQueueInfo;                                      // type predefinition
 struct PlayerQueueInfo                                      // stores information for players in queue
@@ -51,6 +54,35 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  removeInviteTime;                               // time when we will remove invite for players in group
     uint32  isInvitedToBgInstanceGuid;                      // was invited to certain BG
     uint32  desiredInstanceId;                              // queued for this instance specifically
+    uint32  queueIndex;                                     // BG_QUEUE_* list the group is queued in
+    int64   queueOrder;                                     // position in that list, growing from front to back
+    uint32  indexedSize;                                    // size the group is indexed with, 0 when not indexed (invited)
+    std::list<GroupQueueInfo*>::iterator queueItr;          // position in that list, for constant time removal
+};
+
+/*
+    Index of the not yet invited groups of one queue list, bucketed by group size and ordered by queue position.
+    Finding the oldest group fitting into a given number of free slots costs one lookup per group size,
+    instead of a walk over the whole list.
+*/
+class BattleGroundQueueSizeIndex
+{
+    public:
+        BattleGroundQueueSizeIndex() : m_playerCount(0) {}
+
+        void Insert(GroupQueueInfo* group);
+        void Erase(GroupQueueInfo* group);
+        void Clear();
+
+        // oldest group queued behind afterOrder with at most maxSize players which may join the given instance
+        GroupQueueInfo* FindOldestFitting(int64 afterOrder, uint32 maxSize, uint32 bgInstanceId) const;
+
+        uint32 GetPlayerCount() const { return m_playerCount; }
+
+    private:
+        typedef std::map<int64, GroupQueueInfo*> OrderedGroups;
+        std::vector<OrderedGroups> m_bySize;                // index = group size
+        uint32 m_playerCount;
 };
 
 struct BattleGroundInQueueInfo
@@ -131,6 +163,9 @@ class BattleGroundQueueItem
         void PlayerInvitedToBgUpdateAverageWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
         uint32 GetAverageQueueWaitTime(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
 
+        // replays a synthetic join / leave / match trace on a private queue and reports the timings
+        static std::string Benchmark(uint32 queuedPlayers, uint32 pops);
+
     private:
         typedef std::map<ObjectGuid, PlayerQueueInfo> QueuedPlayersMap;
         QueuedPlayersMap m_queuedPlayers;
@@ -166,6 +201,16 @@ class BattleGroundQueueItem
         // one selection pool for horde, other one for alliance
         SelectionPool m_selectionPools[PVP_TEAM_COUNT];
 
+        // not invited groups of m_queuedGroups, by size
+        BattleGroundQueueSizeIndex m_sizeIndex[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+        int64 m_frontOrder;
+        int64 m_backOrder;
+
+        void LinkGroup(GroupQueueInfo* group, BattleGroundBracketId bracketId, uint32 queueIndex, bool front);
+        void UnlinkGroup(GroupQueueInfo* group);
+        void FillSelectionPool(SelectionPool& pool, BattleGroundBracketId bracketId, uint32 queueIndex, uint32 stopCount, uint32 maxCount, uint32 bgInstanceId, int64& position);
+        bool BalanceSelectionPool(SelectionPool& pool, BattleGroundBracketId bracketId, uint32 queueIndex, uint32 minCount, uint32 maxCount);
+
         bool InviteGroupToBg(GroupQueueInfo* groupInfo, BattleGroundInQueueInfo& queueInfo, Team side);
 
         uint32 m_waitTimes[PVP_TEAM_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
@@ -232,6 +277,10 @@ class BattleGroundQueue
 
         Messager<BattleGroundQueue>& GetMessager() { return m_messager; }
 
+        // time from joining the queue to the battleground invite
+        LatencyStats& GetInviteLatency() { return m_inviteLatency; }
+        uint64 GetUpdateCount() const { return m_updateCount; }
+
         void ScheduleQueueUpdate(BattleGroundQueueTypeId /*bgQueueTypeId*/, BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/);
 
         void AddBgToFreeSlots(BattleGroundInQueueInfo const& info);
@@ -266,6 +315,9 @@ class BattleGroundQueue
 
         bool m_testing;
 
+        LatencyStats m_inviteLatency;
+        std::atomic<uint64> m_updateCount;
+
         typedef std::set<uint32> ClientBattleGroundIdSet;
         ClientBattleGroundIdSet m_clientBattleGroundIds[MAX_BATTLEGROUND_TYPE_ID][MAX_BATTLEGROUND_BRACKETS]; // the instanceids just visible for the client
 };
@@ -733,16 +733,19 @@ void Channel::SendToOne(WorldPacket const& data, ObjectGuid receiver) const
 
 void Channel::SendToAll(WorldPacket const& data) const
 {
+    SharedWorldPacket sharedData(data);
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        SendToOne(data, i->first);
+        if (Player* plr = sObjectMgr.GetPlayer(i->first))
+            plr->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::SendMessage(WorldPacket const& data, ObjectGuid sender) const
 {
+    SharedWorldPacket sharedData(data);
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
         if (Player* plr = sObjectMgr.GetPlayer(i->first))
             if (!sender || !plr->GetSocial()->HasIgnore(sender))
-                plr->GetSession()->SendPacket(data);
+                plr->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::MakeNotifyPacket(WorldPacket& data, const std::string& channel, ChatNotify type)
@@ -22,6 +22,7 @@
 #include "Server/WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Server/Opcodes.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Log/Log.h"
 #include "World/World.h"
 #include "Globals/ObjectMgr.h"
@@ -273,6 +274,16 @@ ChatCommand* ChatHandler::getCommandTable()
         { "spawn",          SEC_GAMEMASTER,     true,  nullptr,                                             "", debugSpawnsCommandtable },
         { "debugflags",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugObjectFlags,                "", nullptr },
         { "packetlog",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugPacketLog,                  "", nullptr },
+        { "vmapbench",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugVmapBenchCommand,           "", nullptr },
+        { "fanoutbench",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugFanoutBenchCommand,         "", nullptr },
+        { "accessorstats",  SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugAccessorStatsCommand,       "", nullptr },
+        { "queuestats",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugQueueStatsCommand,          "", nullptr },
+        { "bgqueuebench",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugBgQueueBenchCommand,        "", nullptr },
+        { "movementbench",  SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugMovementBenchCommand,       "", nullptr },
+        { "spellmapbench",  SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugSpellMapBenchCommand,       "", nullptr },
+        { "messagerstats",  SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugMessagerStatsCommand,       "", nullptr },
+        { "bufferpool",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugBufferPoolCommand,          "", nullptr },
+        { "loginstats",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugLoginStatsCommand,          "", nullptr },
         { "dbscript",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugDbscript,                   "", nullptr },
         { "dbscripttargeted", SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugDbscriptTargeted,         "", nullptr },
         { "dbscriptsourced", SEC_ADMINISTRATOR, true,  &ChatHandler::HandleDebugDbscriptSourced,            "", nullptr },
@@ -439,6 +450,7 @@ ChatCommand* ChatHandler::getCommandTable()
     {
         { "stats",          SEC_GAMEMASTER,     true,  &ChatHandler::HandleLootStatsCommand,           "", nullptr },
         { "fullstats",      SEC_GAMEMASTER,     true,  &ChatHandler::HandleLootFullStatsCommand,       "", nullptr },
+        { "audit",          SEC_GAMEMASTER,     true,  &ChatHandler::HandleLootAuditCommand,           "", nullptr },
 
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
@@ -3272,6 +3284,10 @@ bool ChatHandler::ExtractPlayerTarget(char** args, Player** player /*= nullptr*/
         // if need guid value from DB (in name case for check player existence)
         ObjectGuid guid = !pl && (player_guid || player_name) ? sObjectMgr.GetPlayerGuidByName(name) : ObjectGuid();
 
+        // the command may change the offline character
+        if (guid)
+            sCharacterPrefetch.Invalidate(guid);
+
         // if allowed player guid (if no then only online players allowed)
         if (player_guid)
             *player_guid = pl ? pl->GetObjectGuid() : guid;
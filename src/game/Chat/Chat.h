@@ -278,6 +278,7 @@ class ChatHandler
         bool LootStatsHelper(char* args, bool full);
         bool HandleLootStatsCommand(char* args);
         bool HandleLootFullStatsCommand(char* args);
+        bool HandleLootAuditCommand(char* args);
 
         bool HandleDebugOverflowCommand(char* args);
         bool HandleDebugChatFreezeCommand(char* args);
@@ -319,6 +320,16 @@ class ChatHandler
         bool HandleDebugRespawnDynguid(char* args);
 
         bool HandleDebugPacketLog(char* args);
+        bool HandleDebugVmapBenchCommand(char* args);
+        bool HandleDebugFanoutBenchCommand(char* args);
+        bool HandleDebugAccessorStatsCommand(char* args);
+        bool HandleDebugQueueStatsCommand(char* args);
+        bool HandleDebugBgQueueBenchCommand(char* args);
+        bool HandleDebugMovementBenchCommand(char* args);
+        bool HandleDebugSpellMapBenchCommand(char* args);
+        bool HandleDebugMessagerStatsCommand(char* args);
+        bool HandleDebugBufferPoolCommand(char* args);
+        bool HandleDebugLoginStatsCommand(char* args);
         bool HandleDebugDbscript(char* args);
         bool HandleDebugDbscriptTargeted(char* args);
         bool HandleDebugDbscriptSourced(char* args);
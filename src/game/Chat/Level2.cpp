@@ -5082,6 +5082,16 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
     PSendSysMessage(" %u triangles (%u vertices)", triCount, triVertCount);
     PSendSysMessage(" %.2f MB of data (not including pointers)", ((float)dataSize / sizeof(unsigned char)) / 1048576);
 
+    if (MMAP::PathCache* pathCache = mmap->GetPathCache(m_session->GetPlayer()->GetMapId()))
+    {
+        uint64 hits, misses;
+        uint32 size;
+        pathCache->GetStats(hits, misses, size);
+        uint64 total = hits + misses;
+        PSendSysMessage(" path cache: %u corridors, " UI64FMTD " hits, " UI64FMTD " misses (%.1f%% hit rate)",
+                        size, hits, misses, total ? float(hits) * 100.f / total : 0.f);
+    }
+
     return true;
 }
 
@@ -5148,6 +5158,30 @@ bool ChatHandler::HandleBattlegroundStopCommand(char* args)
     return true;
 }
 
+// loot store names accepted by LootMgr from the (possibly shortened) lootType of the loot commands, empty if unknown
+static std::string GetLootStoreNameByPrefix(std::string const& lootType)
+{
+    if (lootType.rfind("c", 0) == 0)
+        return "creature";
+    if (lootType.rfind("g", 0) == 0)
+        return "gameobject";
+    if (lootType.rfind("f", 0) == 0)
+        return "fishing";
+    if (lootType.rfind("i", 0) == 0)
+        return "item";
+    if (lootType.rfind("pi", 0) == 0)
+        return "pickpocketing";
+    if (lootType.rfind("s", 0) == 0)
+        return "skinning";
+    if (lootType.rfind("dis", 0) == 0)
+        return "disenchanting";
+    if (lootType.rfind("m", 0) == 0)
+        return "mail";
+    if (lootType.rfind("r", 0) == 0)
+        return "reference";
+    return "";
+}
+
 bool ChatHandler::LootStatsHelper(char* args, bool full)
 {
     uint32 amountOfCheck = 100000;
@@ -5193,25 +5227,8 @@ bool ChatHandler::LootStatsHelper(char* args, bool full)
             std::string lootType(argsStr);
 
             // check if lootType start with correct store name
-            if (lootType.rfind("c", 0) == 0)
-                lootStore = "creature";
-            else if (lootType.rfind("g", 0) == 0)
-                lootStore = "gameobject";
-            else if (lootType.rfind("f", 0) == 0)
-                lootStore = "fishing";
-            else if (lootType.rfind("i", 0) == 0)
-                lootStore = "item";
-            else if (lootType.rfind("pi", 0) == 0)
-                lootStore = "pickpocketing";
-            else if (lootType.rfind("s", 0) == 0)
-                lootStore = "skinning";
-            else if (lootType.rfind("dis", 0) == 0)
-                lootStore = "disenchanting";
-            else if (lootType.rfind("m", 0) == 0)
-                lootStore = "mail";
-            else if (lootType.rfind("r", 0) == 0)
-                lootStore = "reference";
-            else
+            lootStore = GetLootStoreNameByPrefix(lootType);
+            if (lootStore.empty())
             {
                 showError();
                 return true;
@@ -5240,3 +5257,26 @@ bool ChatHandler::HandleLootFullStatsCommand(char* args)
 {
     return LootStatsHelper(args, true);
 }
+
+bool ChatHandler::HandleLootAuditCommand(char* args)
+{
+    char* lootTypeStr = ExtractLiteralArg(&args);
+    std::string lootStore = lootTypeStr ? GetLootStoreNameByPrefix(lootTypeStr) : "";
+    if (lootStore.empty())
+    {
+        SendSysMessage("Usage: '.loot audit lootType [#amountOfDropCheck] [#tolerance]'\n"
+            " -> simulates every template of the loot type without rates and lists the entries dropping off their chance\n"
+            " -> tolerance is in percent points, deviations within the statistical noise of the simulation are never listed");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    uint32 amountOfCheck = 10000;
+    float tolerance = 0.0f;
+    ExtractOptUInt32(&args, amountOfCheck, 10000);
+    if (*args && !ExtractFloat(&args, tolerance))
+        return false;
+
+    sLootMgr.AuditDropStats(*this, lootStore, amountOfCheck, tolerance);
+    return true;
+}
@@ -25,6 +25,7 @@
 #include "Tools/PlayerDump.h"
 #include "Spells/SpellMgr.h"
 #include "Entities/Player.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Entities/GameObject.h"
 #include "Chat/Chat.h"
 #include "Log/Log.h"
@@ -33,6 +34,7 @@
 #include "Globals/ObjectAccessor.h"
 #include "Maps/MapManager.h"
 #include "Mails/MassMailMgr.h"
+#include "AuctionHouse/AuctionHouseMgr.h"
 #include "DBScripts/ScriptMgr.h"
 #include "Tools/Language.h"
 #include "Grids/GridNotifiersImpl.h"
@@ -952,6 +954,7 @@ bool ChatHandler::HandleReloadLocalesItemCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Item ... ");
     sObjectMgr.LoadItemLocales();
+    sAuctionMgr.ClearItemSearchNames();
     SendGlobalSysMessage("DB table `locales_item` reloaded.");
     return true;
 }
@@ -4601,6 +4604,7 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
+    sCharacterPrefetch.InvalidateAll();
     HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
     for (const auto& itr : plist)
         itr.second->SetAtLoginFlag(atLogin);
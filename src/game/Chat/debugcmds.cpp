@@ -17,6 +17,7 @@
  */
 
 #include "Common.h"
+#include "Database/DatabaseEnv.h"
 #include "Server/WorldPacket.h"
 #include "Server/DBCStores.h"
 #include "Entities/Player.h"
@@ -29,6 +30,8 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <fstream>
 #include "Maps/MapManager.h"
+#include "Globals/ObjectAccessor.h"
+#include "World/World.h"
 #include "Globals/ObjectMgr.h"
 #include "Entities/ObjectGuid.h"
 #include "Spells/SpellMgr.h"
@@ -36,7 +39,13 @@
 #include "Maps/InstanceData.h"
 #include "Cinematics/M2Stores.h"
 #include "Entities/Transports.h"
+#include "vmap/VMapFactory.h"
+#include "vmap/RayIntersection.h"
+#include "vmap/WorldModel.h"
 #include <string>
+#include <chrono>
+#include <future>
+#include <sstream>
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1771,6 +1780,367 @@ bool ChatHandler::HandleDebugPacketLog(char* args)
     return true;
 }
 
+// replays one set of random rays against a local triangle set around the player with every ray kernel the cpu supports
+// the kernels are called directly, so the one used by the map threads is not switched
+// .debug vmapbench [count]
+bool ChatHandler::HandleDebugVmapBenchCommand(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 5000))
+        return false;
+    count = std::max(100u, std::min(count, 20000u));            // runs on the world thread, keep it short
+
+    Player* player = m_session->GetPlayer();
+    G3D::Vector3 center(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ());
+
+    // small triangles scattered around the player, tested in leaves of 8 as the BIH does
+    uint32 const triangleCount = 512;
+    uint32 const leafSize = 8;
+    std::vector<G3D::Vector3> vertices;
+    std::vector<VMAP::MeshTriangle> triangles;
+    std::vector<uint32> indices(triangleCount);
+    vertices.reserve(triangleCount * 3);
+    triangles.reserve(triangleCount);
+    for (uint32 i = 0; i < triangleCount; ++i)
+    {
+        G3D::Vector3 corner = center + G3D::Vector3(frand(-40.f, 40.f), frand(-40.f, 40.f), frand(-5.f, 10.f));
+        uint32 first = vertices.size();
+        vertices.push_back(corner);
+        vertices.push_back(corner + G3D::Vector3(frand(-4.f, 4.f), frand(-4.f, 4.f), frand(-2.f, 2.f)));
+        vertices.push_back(corner + G3D::Vector3(frand(-4.f, 4.f), frand(-4.f, 4.f), frand(-2.f, 2.f)));
+        triangles.emplace_back(first, first + 1, first + 2);
+        indices[i] = i;
+    }
+
+    std::vector<G3D::AABox> leafBoxes;
+    for (uint32 leaf = 0; leaf < triangleCount; leaf += leafSize)
+    {
+        G3D::AABox box(vertices[triangles[leaf].idx0]);
+        for (uint32 i = leaf; i < leaf + leafSize; ++i)
+        {
+            box.merge(vertices[triangles[i].idx0]);
+            box.merge(vertices[triangles[i].idx1]);
+            box.merge(vertices[triangles[i].idx2]);
+        }
+        leafBoxes.push_back(box);
+    }
+
+    std::vector<G3D::Ray> rays;
+    rays.reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        G3D::Vector3 from = center + G3D::Vector3(frand(-40.f, 40.f), frand(-40.f, 40.f), frand(-5.f, 10.f));
+        G3D::Vector3 to = center + G3D::Vector3(frand(-40.f, 40.f), frand(-40.f, 40.f), frand(-5.f, 10.f));
+        rays.push_back(G3D::Ray::fromOriginAndDirection(from, (to - from).directionOrZero()));
+    }
+
+    std::vector<float> referenceDistance(count);
+    uint64 referenceTime = 0;
+    for (uint32 kernel = VMAP::RAY_KERNEL_SCALAR; kernel <= uint32(VMAP::GetBestRayKernel()); ++kernel)
+    {
+        uint32 mismatches = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float distance = 100.f;
+            for (uint32 leaf = 0; leaf < leafBoxes.size(); ++leaf)
+                if (VMAP::RayMayHitBoxWith(VMAP::RayKernel(kernel), rays[i], leafBoxes[leaf]))
+                    VMAP::IntersectTrianglesWith(VMAP::RayKernel(kernel), rays[i], vertices.data(), triangles.data(), &indices[leaf * leafSize], leafSize, distance, false);
+
+            if (kernel == VMAP::RAY_KERNEL_SCALAR)
+                referenceDistance[i] = distance;
+            else if (referenceDistance[i] != distance)
+                ++mismatches;
+        }
+        uint64 elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if (kernel == VMAP::RAY_KERNEL_SCALAR)
+            referenceTime = elapsed;
+
+        PSendSysMessage("%s: %u rays against %u triangles in " UI64FMTD " us (%.2fx scalar), %u mismatches",
+                        VMAP::GetRayKernelName(VMAP::RayKernel(kernel)), count, triangleCount, elapsed,
+                        elapsed ? float(referenceTime) / elapsed : 1.f, mismatches);
+    }
+
+    PSendSysMessage("Active kernel: %s", VMAP::GetRayKernelName(VMAP::GetRayKernel()));
+    return true;
+}
+
+// Compares per receiver buffers (WorldSocket::SendPacket) against one shared body (SharedWorldPacket)
+// for a full length channel message, up to the point where buffers are handed to the socket
+bool ChatHandler::HandleDebugFanoutBenchCommand(char* args)
+{
+    uint32 repeats;
+    if (!ExtractOptUInt32(&args, repeats, 100))
+        return false;
+    repeats = std::max(1u, std::min(repeats, 10000u));
+
+    WorldPacket data(SMSG_MESSAGECHAT, 300);
+    data << uint8(CHAT_MSG_CHANNEL);
+    data << uint32(LANG_UNIVERSAL);
+    data << std::string("world");
+    data << uint32(0);
+    data << ObjectGuid();
+    data << uint32(256);
+    data << std::string(255, 'x');
+    data << uint8(0);
+
+    uint32 const headerSize = 4;
+    for (uint32 members : { 1000u, 5000u })
+    {
+        std::vector<std::shared_ptr<std::vector<char>>> copies;
+        copies.reserve(members);
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < repeats; ++i)
+        {
+            for (uint32 j = 0; j < members; ++j)
+            {
+                std::shared_ptr<std::vector<char>> fullMessage = std::make_shared<std::vector<char>>(headerSize + data.size());
+                std::memset(fullMessage->data(), 0, headerSize);
+                std::memcpy(fullMessage->data() + headerSize, data.contents(), data.size());
+                copies.push_back(std::move(fullMessage));
+            }
+            copies.clear();
+        }
+        uint64 copyTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<std::shared_ptr<std::array<char, 4>>> headers;
+        std::vector<std::shared_ptr<WorldPacket const>> bodies;
+        headers.reserve(members);
+        bodies.reserve(members);
+        start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < repeats; ++i)
+        {
+            SharedWorldPacket sharedData(data);
+            for (uint32 j = 0; j < members; ++j)
+            {
+                headers.push_back(std::make_shared<std::array<char, 4>>());
+                bodies.push_back(sharedData.GetBody());
+            }
+            headers.clear();
+            bodies.clear();
+        }
+        uint64 sharedTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        PSendSysMessage("%u members, %u byte packet, %u sends: copied " UI64FMTD " us (" UI64FMTD " bytes/send), shared " UI64FMTD " us (" UI64FMTD " bytes/send), %.2fx",
+                        members, uint32(data.size()), repeats, copyTime, uint64(members) * (headerSize + data.size()),
+                        sharedTime, uint64(members) * headerSize + data.size(), sharedTime ? float(copyTime) / sharedTime : 1.f);
+    }
+    return true;
+}
+
+bool ChatHandler::HandleDebugAccessorStatsCommand(char* args)
+{
+    bool reset = false;
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+        reset = true;
+    }
+
+    HashMapHolder<Player>::LookupStats players = HashMapHolder<Player>::GetLookupStats();
+    HashMapHolder<Corpse>::LookupStats corpses = HashMapHolder<Corpse>::GetLookupStats();
+
+    PSendSysMessage("Object accessor lookups are %s", sWorld.getConfig(CONFIG_BOOL_LOCKFREE_OBJECT_LOOKUP) ? "lock-free" : "locked");
+    PSendSysMessage("Players: " UI64FMTD " lookups, " UI64FMTD " contended, " UI64FMTD " grace period waits",
+                    players.lookups, players.contendedLookups, players.gracePeriodWaits);
+    PSendSysMessage("Corpses: " UI64FMTD " lookups, " UI64FMTD " contended, " UI64FMTD " grace period waits",
+                    corpses.lookups, corpses.contendedLookups, corpses.gracePeriodWaits);
+
+    if (reset)
+    {
+        HashMapHolder<Player>::ResetLookupStats();
+        HashMapHolder<Corpse>::ResetLookupStats();
+    }
+    return true;
+}
+
+static void SendQueueLatency(ChatHandler* handler, char const* name, LatencyStats const& stats, uint64 updates)
+{
+    LatencyStats::Snapshot snapshot = stats.GetSnapshot();
+    handler->PSendSysMessage("%s: " UI64FMTD " queue passes, " UI64FMTD " matched, wait avg %u ms, p50 <= %u ms, p95 <= %u ms, max %u ms",
+                             name, updates, snapshot.count, snapshot.GetAverage(), snapshot.GetPercentile(50), snapshot.GetPercentile(95), snapshot.maximum);
+}
+
+bool ChatHandler::HandleDebugQueueStatsCommand(char* args)
+{
+    bool reset = false;
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+        reset = true;
+    }
+
+    SendQueueLatency(this, "Battleground join to invite", sWorld.GetBGQueue().GetInviteLatency(), sWorld.GetBGQueue().GetUpdateCount());
+    SendQueueLatency(this, "LFG join to group", sWorld.GetLFGQueue().GetMatchLatency(), sWorld.GetLFGQueue().GetUpdateCount());
+
+    if (reset)
+    {
+        sWorld.GetBGQueue().GetInviteLatency().Reset();
+        sWorld.GetLFGQueue().GetMatchLatency().Reset();
+    }
+    return true;
+}
+
+template <class T>
+static void SendMessagerStats(ChatHandler* handler, char const* name, Messager<T>& messager, bool reset)
+{
+    LatencyStats::Snapshot latency = messager.GetLatency().GetSnapshot();
+    handler->PSendSysMessage("%s: %u queued (max %u), " UI64FMTD " messages in " UI64FMTD " batches (max %u), delivery avg %u us, p95 <= %u us, max %u us",
+                             name, messager.GetDepth(), messager.GetMaxDepth(), latency.count, messager.GetBatchCount(), messager.GetMaxBatch(),
+                             latency.GetAverage(), latency.GetPercentile(95), latency.maximum);
+    if (reset)
+        messager.ResetStats();
+}
+
+bool ChatHandler::HandleDebugMessagerStatsCommand(char* args)
+{
+    bool reset = false;
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+        reset = true;
+    }
+
+    SendMessagerStats(this, "World", sWorld.GetMessager(), reset);
+    SendMessagerStats(this, "Battleground manager", sBattleGroundMgr.GetMessager(), reset);
+    SendMessagerStats(this, "Battleground queue", sWorld.GetBGQueue().GetMessager(), reset);
+    SendMessagerStats(this, "LFG queue", sWorld.GetLFGQueue().GetMessager(), reset);
+    if (m_session && m_session->GetPlayer()->IsInWorld())
+        SendMessagerStats(this, "Current map", m_session->GetPlayer()->GetMap()->GetMessager(), reset);
+    return true;
+}
+
+bool ChatHandler::HandleDebugBufferPoolCommand(char* args)
+{
+    bool reset = false;
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+        reset = true;
+    }
+
+    BufferPool::ClassStats stats[BufferPool::CLASS_COUNT];
+    uint64 unpooled;
+    BufferPool::GetStats(stats, unpooled);
+    for (BufferPool::ClassStats const& classStats : stats)
+    {
+        uint64 total = classStats.hits + classStats.misses;
+        PSendSysMessage("%u byte buffers: " UI64FMTD " allocations, " UI64FMTD " from pool (%.1f%%), " UI64FMTD " returned from other threads, " UI64FMTD " released to heap",
+                        uint32(classStats.size), total, classStats.hits, total ? 100.f * classStats.hits / total : 0.f, classStats.returns, classStats.releases);
+    }
+    PSendSysMessage("Larger buffers: " UI64FMTD " heap allocations", unpooled);
+
+    if (reset)
+        BufferPool::ResetStats();
+    return true;
+}
+
+bool ChatHandler::HandleDebugLoginStatsCommand(char* args)
+{
+    bool reset = false;
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+        reset = true;
+    }
+
+    LatencyStats::Snapshot load = CharacterDatabase.GetHolderLatency().GetSnapshot();
+    LatencyStats::Snapshot login = sWorld.GetLoginLatency().GetSnapshot();
+    if (CharacterDatabase.GetHolderLoaderCount())
+        PSendSysMessage("Character loads on %u loader connections: " UI64FMTD " loads, avg %u ms, p50 <= %u ms, p95 <= %u ms, max %u ms",
+                        CharacterDatabase.GetHolderLoaderCount(), load.count, load.GetAverage(), load.GetPercentile(50), load.GetPercentile(95), load.maximum);
+    else
+        SendSysMessage("Character loads run on the async connection (CharacterDatabaseLoaderConnections = 0)");
+    PSendSysMessage("Login request to in world: " UI64FMTD " logins, avg %u ms, p50 <= %u ms, p95 <= %u ms, max %u ms",
+                    login.count, login.GetAverage(), login.GetPercentile(50), login.GetPercentile(95), login.maximum);
+
+    if (reset)
+    {
+        CharacterDatabase.GetHolderLatency().Reset();
+        sWorld.GetLoginLatency().Reset();
+    }
+    return true;
+}
+
+bool ChatHandler::HandleDebugBgQueueBenchCommand(char* args)
+{
+    uint32 players;
+    if (!ExtractOptUInt32(&args, players, 1000))
+        return false;
+
+    uint32 pops;
+    if (!ExtractOptUInt32(&args, pops, 1000))
+        return false;
+
+    players = std::max(30u, std::min(players, 100000u));
+    pops = std::max(1u, std::min(pops, 100000u));
+
+    // the benchmark shares the queue's settings and helpers with the battleground queue thread, so it runs there
+    std::shared_ptr<std::promise<std::string>> result = std::make_shared<std::promise<std::string>>();
+    std::future<std::string> report = result->get_future();
+    sWorld.GetBGQueue().GetMessager().AddMessage([result, players, pops](BattleGroundQueue* /*queue*/)
+    {
+        result->set_value(BattleGroundQueueItem::Benchmark(players, pops));
+    });
+
+    if (report.wait_for(std::chrono::minutes(1)) != std::future_status::ready)
+    {
+        SendSysMessage("Battleground queue thread did not run the benchmark in time");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::istringstream lines(report.get());
+    std::string line;
+    while (std::getline(lines, line))
+        SendSysMessage(line.c_str());
+    return true;
+}
+
+bool ChatHandler::HandleDebugMovementBenchCommand(char* args)
+{
+    uint32 players;
+    if (!ExtractOptUInt32(&args, players, 80))
+        return false;
+
+    uint32 seconds;
+    if (!ExtractOptUInt32(&args, seconds, 30))
+        return false;
+
+    // runs on the world thread, the simulation is quadratic in players
+    players = std::max(2u, std::min(players, 200u));
+    seconds = std::max(1u, std::min(seconds, 30u));
+
+    std::string report = MovementRelayShaper::Benchmark(players, seconds, sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_RELAY_FULL_RANGE),
+                         sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_INTERVAL), sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_BUDGET));
+    std::istringstream lines(report);
+    std::string line;
+    while (std::getline(lines, line))
+        SendSysMessage(line.c_str());
+    return true;
+}
+
+bool ChatHandler::HandleDebugSpellMapBenchCommand(char* args)
+{
+    uint32 lookups;
+    if (!ExtractOptUInt32(&args, lookups, 100000))
+        return false;
+
+    lookups = std::max(1000u, std::min(lookups, 1000000u));     // runs on the world thread, keep it short
+
+    std::string report = sSpellMgr.BenchmarkLookupTables(lookups);
+    std::istringstream lines(report);
+    std::string line;
+    while (std::getline(lines, line))
+        SendSysMessage(line.c_str());
+    return true;
+}
+
 bool ChatHandler::HandleDebugDbscript(char* args)
 {
     Unit* target = getSelectedUnit();
@@ -40,6 +40,7 @@
 #include "Chat/Chat.h"
 #include "Spells/SpellMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/CharacterPrefetch.h"
 
 #ifdef BUILD_DEPRECATED_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotMgr.h"
@@ -63,11 +64,16 @@ class LoginQueryHolder : public SqlQueryHolder
     private:
         uint32 m_accountId;
         ObjectGuid m_guid;
+        std::chrono::steady_clock::time_point m_requestTime;
     public:
         LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-            : m_accountId(accountId), m_guid(guid) { }
+            : m_accountId(accountId), m_guid(guid), m_requestTime(std::chrono::steady_clock::now()) { }
         ObjectGuid GetGuid() const { return m_guid; }
         uint32 GetAccountId() const { return m_accountId; }
+        // prefetched holders are created before the login request
+        void SetRequestTime() { m_requestTime = std::chrono::steady_clock::now(); }
+        // milliseconds since the login request
+        uint32 GetElapsedTime() const { return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_requestTime).count()); }
         bool Initialize();
 };
 
@@ -207,6 +213,8 @@ bool LoginQueryHolder::Initialize()
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSKILLS,          "SELECT skill, value, max FROM character_skills WHERE guid = '%u'", m_guid.GetCounter());
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILS,           "SELECT id,messageType,sender,receiver,subject,itemTextId,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC", m_guid.GetCounter());
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,     "SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
+    // mail items must belong to the mails read, a mail sent between both queries would load its items without the mail
+    res &= RunWith(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS, PLAYER_LOGIN_QUERY_LOADMAILS);
     res &= SetPQuery(PLAYER_LOGIN_QUERY_FORGOTTEN_SKILLS,    "SELECT skill, value FROM character_forgotten_skills WHERE guid = '%u'", m_guid.GetCounter());
 
     return res;
@@ -254,9 +262,40 @@ class CharacterHandler
 #else
             if (WorldSession* session = sWorld.FindSession(((LoginQueryHolder*)holder)->GetAccountId()))
                 session->HandlePlayerLogin((LoginQueryHolder*)holder);
+            else
+                delete holder;
 #endif
         }
 
+        void HandlePlayerPrefetchCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder) return;
+
+            LoginQueryHolder* loginHolder = (LoginQueryHolder*)holder;
+            switch (sCharacterPrefetch.Complete(loginHolder->GetGuid(), holder))
+            {
+                case CHARACTER_PREFETCH_LOGIN:
+                    HandlePlayerLoginCallback(nullptr, holder);
+                    break;
+                case CHARACTER_PREFETCH_RELOAD:
+                {
+                    // the character changed while loading, the waiting login needs a fresh load
+                    uint32 accountId = loginHolder->GetAccountId();
+                    ObjectGuid guid = loginHolder->GetGuid();
+                    LoginQueryHolder* reload = new LoginQueryHolder(accountId, guid);
+                    if (!reload->Initialize())
+                    {
+                        delete reload;
+                        break;
+                    }
+                    CharacterDatabase.DelayQueryHolder(this, &CharacterHandler::HandlePlayerLoginCallback, (SqlQueryHolder*)reload);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
 #ifdef BUILD_DEPRECATED_PLAYERBOT
         // This callback is different from the normal HandlePlayerLoginCallback in that it
         // sets up the bot's world session and also stores the pointer to the bot player in the master's
@@ -294,6 +333,10 @@ void WorldSession::HandleCharEnum(QueryResult* result)
 
     data << num;
 
+    // the last played character is likely the one to enter the world with
+    uint32 prefetchGuid = 0;
+    uint64 prefetchLogoutTime = 0;
+
     if (result)
     {
         do
@@ -301,7 +344,17 @@ void WorldSession::HandleCharEnum(QueryResult* result)
             uint32 guidlow = (*result)[0].GetUInt32();
             DETAIL_LOG("Build enum data for char guid %u from account %u.", guidlow, GetAccountId());
             if (Player::BuildEnumData(result, data))
+            {
                 ++num;
+
+                // characters with pending at login changes are modified before they can log in
+                uint64 logoutTime = (*result)[20].GetUInt64();
+                if ((*result)[15].GetUInt32() == AT_LOGIN_NONE && (!prefetchGuid || logoutTime > prefetchLogoutTime))
+                {
+                    prefetchGuid = guidlow;
+                    prefetchLogoutTime = logoutTime;
+                }
+            }
         }
         while (result->NextRow());
 
@@ -311,6 +364,19 @@ void WorldSession::HandleCharEnum(QueryResult* result)
     data.put<uint8>(0, num);
 
     m_anticheat->SendCharEnum(std::move(data));
+
+    if (prefetchGuid && sWorld.getConfig(CONFIG_UINT32_CHARACTER_PREFETCH_CACHE_SIZE))
+    {
+        ObjectGuid guid(HIGHGUID_PLAYER, prefetchGuid);
+        if (!ObjectAccessor::FindPlayer(guid, false))       // still in world, a login would reconnect to it
+        {
+            LoginQueryHolder* holder = new LoginQueryHolder(GetAccountId(), guid);
+            if (holder->Initialize() && sCharacterPrefetch.Start(GetAccountId(), guid, holder))
+                CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandlePlayerPrefetchCallback, (SqlQueryHolder*)holder);
+            else
+                delete holder;
+        }
+    }
 }
 
 void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recv_data*/)
@@ -321,8 +387,8 @@ void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recv_data*/)
                                   "SELECT characters.guid, characters.name, characters.race, characters.class, characters.gender, characters.playerBytes, characters.playerBytes2, characters.level, "
                                   //   8                9               10                     11                     12                     13                    14
                                   "characters.zone, characters.map, characters.position_x, characters.position_y, characters.position_z, guild_member.guildid, characters.playerFlags, "
-                                  //  15                    16                   17                     18                   19
-                                  "characters.at_login, character_pet.entry, character_pet.modelid, character_pet.level, characters.equipmentCache "
+                                  //  15                    16                   17                     18                   19                         20
+                                  "characters.at_login, character_pet.entry, character_pet.modelid, character_pet.level, characters.equipmentCache, characters.logout_time "
                                   "FROM characters LEFT JOIN character_pet ON characters.guid=character_pet.owner AND character_pet.slot='%u' "
                                   "LEFT JOIN guild_member ON characters.guid = guild_member.guid "
                                   "WHERE characters.account = '%u' ORDER BY characters.guid",
@@ -660,6 +726,20 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recv_data)
 
     DEBUG_LOG("WORLD: Received opcode Player Logon Message");
 
+    SqlQueryHolder* prefetched = nullptr;
+    switch (sCharacterPrefetch.Take(GetAccountId(), playerGuid, prefetched))
+    {
+        case CHARACTER_PREFETCH_READY:
+            ((LoginQueryHolder*)prefetched)->SetRequestTime();
+            chrHandler.HandlePlayerLoginCallback(nullptr, prefetched);
+            return;
+        case CHARACTER_PREFETCH_PENDING:                    // the prefetch callback logs in
+            ((LoginQueryHolder*)prefetched)->SetRequestTime();
+            return;
+        default:
+            break;
+    }
+
     LoginQueryHolder* holder = new LoginQueryHolder(GetAccountId(), playerGuid);
     if (!holder->Initialize())
     {
@@ -939,6 +1019,8 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
     if (!pCurrChar->IsStandState() && !pCurrChar->IsStunned())
         pCurrChar->SetStandState(UNIT_STAND_STATE_STAND);
 
+    sWorld.GetLoginLatency().Add(holder->GetElapsedTime());
+
     m_playerLoading = false;
     delete holder;
 }
@@ -1219,6 +1301,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult* result, uin
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_RENAME), guidLow);
     CharacterDatabase.CommitTransaction();
+    sCharacterPrefetch.Invalidate(guid);
 
     sLog.outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", session->GetAccountId(), session->GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
 
@@ -0,0 +1,177 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/CharacterPrefetch.h"
+#include "Policies/Singleton.h"
+#include "Database/DatabaseEnv.h"
+#include "World/World.h"
+
+INSTANTIATE_SINGLETON_1(CharacterPrefetchCache);
+
+CharacterPrefetchCache::~CharacterPrefetchCache()
+{
+    // holders in flight are owned by their callbacks
+    for (auto& itr : m_entries)
+        if (itr.second.loaded)
+            delete itr.second.holder;
+}
+
+bool CharacterPrefetchCache::Start(uint32 accountId, ObjectGuid guid, SqlQueryHolder* holder)
+{
+    uint32 const maxSize = sWorld.getConfig(CONFIG_UINT32_CHARACTER_PREFETCH_CACHE_SIZE);
+    if (!maxSize)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // still valid results or a load in flight, the latter may just have been invalidated but never loads twice
+    if (m_entries.find(guid.GetCounter()) != m_entries.end())
+        return false;
+
+    m_lru.push_front(guid.GetCounter());
+    m_entries.emplace(guid.GetCounter(), Entry{ holder, accountId, TimePoint(), false, false, false, m_lru.begin() });
+    Shrink(maxSize, World::GetCurrentClockTime());
+    return true;
+}
+
+CharacterPrefetchResult CharacterPrefetchCache::Complete(ObjectGuid guid, SqlQueryHolder* holder)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_entries.find(guid.GetCounter());
+    MANGOS_ASSERT(itr != m_entries.end() && itr->second.holder == holder);
+
+    Entry& entry = itr->second;
+    if (entry.loginWaiting)
+    {
+        CharacterPrefetchResult result = entry.invalidated ? CHARACTER_PREFETCH_RELOAD : CHARACTER_PREFETCH_LOGIN;
+        if (entry.invalidated)
+            delete holder;
+        Drop(itr);
+        return result;
+    }
+
+    if (entry.invalidated)
+    {
+        delete holder;
+        Drop(itr);
+        return CHARACTER_PREFETCH_DISCARDED;
+    }
+
+    entry.loaded = true;
+    entry.loadedTime = World::GetCurrentClockTime();
+    return CHARACTER_PREFETCH_KEPT;
+}
+
+CharacterPrefetchState CharacterPrefetchCache::Take(uint32 accountId, ObjectGuid guid, SqlQueryHolder*& holder)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_entries.find(guid.GetCounter());
+    if (itr == m_entries.end() || itr->second.accountId != accountId)
+        return CHARACTER_PREFETCH_NONE;
+
+    Entry& entry = itr->second;
+    if (!entry.loaded)
+    {
+        // an invalidated load still gets the waiting login, its callback starts the real load
+        entry.loginWaiting = true;
+        holder = entry.holder;
+        return CHARACTER_PREFETCH_PENDING;
+    }
+
+    uint32 const timeout = sWorld.getConfig(CONFIG_UINT32_CHARACTER_PREFETCH_TIMEOUT);
+    if (World::GetCurrentClockTime() - entry.loadedTime > std::chrono::seconds(timeout))
+    {
+        delete entry.holder;
+        Drop(itr);
+        return CHARACTER_PREFETCH_NONE;
+    }
+
+    holder = entry.holder;
+    Drop(itr);
+    return CHARACTER_PREFETCH_READY;
+}
+
+void CharacterPrefetchCache::Invalidate(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_entries.find(guid.GetCounter());
+    if (itr == m_entries.end())
+        return;
+
+    if (itr->second.loaded)
+    {
+        delete itr->second.holder;
+        Drop(itr);
+    }
+    else
+        itr->second.invalidated = true;
+}
+
+void CharacterPrefetchCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    for (auto itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        auto current = itr++;
+        if (current->second.loaded)
+        {
+            delete current->second.holder;
+            Drop(current);
+        }
+        else
+            current->second.invalidated = true;
+    }
+}
+
+void CharacterPrefetchCache::Drop(EntryMap::iterator itr)
+{
+    if (itr->second.lruPos != m_lru.end())
+        m_lru.erase(itr->second.lruPos);
+    m_entries.erase(itr);
+}
+
+// drops expired results and the least recently started entries above the size limit
+void CharacterPrefetchCache::Shrink(uint32 maxSize, TimePoint now)
+{
+    auto const timeout = std::chrono::seconds(sWorld.getConfig(CONFIG_UINT32_CHARACTER_PREFETCH_TIMEOUT));
+    while (!m_lru.empty())
+    {
+        auto itr = m_entries.find(m_lru.back());
+        Entry& entry = itr->second;
+        bool expired = entry.loaded && now - entry.loadedTime > timeout;
+        if (m_lru.size() <= maxSize && !expired)
+            break;
+
+        if (entry.loaded)
+        {
+            delete entry.holder;
+            Drop(itr);
+        }
+        else
+        {
+            // the callback finds it invalidated and deletes the holder
+            m_lru.pop_back();
+            entry.lruPos = m_lru.end();
+            entry.invalidated = true;
+        }
+    }
+}
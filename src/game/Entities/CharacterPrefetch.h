@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CHARACTERPREFETCH_H
+#define MANGOS_CHARACTERPREFETCH_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+class SqlQueryHolder;
+
+enum CharacterPrefetchState
+{
+    CHARACTER_PREFETCH_NONE,                                // nothing usable, load the character as usual
+    CHARACTER_PREFETCH_READY,                               // the loaded holder is handed out
+    CHARACTER_PREFETCH_PENDING,                             // the load is in flight, its callback continues the login
+};
+
+enum CharacterPrefetchResult
+{
+    CHARACTER_PREFETCH_KEPT,                                // cached for a later login
+    CHARACTER_PREFETCH_DISCARDED,                           // invalidated or evicted while loading, the holder is deleted
+    CHARACTER_PREFETCH_LOGIN,                               // a login waits for it, continue the login with the holder
+    CHARACTER_PREFETCH_RELOAD,                              // a login waits but the data changed while loading, the holder is deleted
+};
+
+/**
+ * Login query holders loaded speculatively when the character list is sent, so the login after pressing
+ * "Enter World" only has to build the player. Bounded LRU, entries expire after a timeout.
+ *
+ * Loading, saving or adding a character to the world by any path (session or bot) drops its entry. Other writes
+ * to the data of a character that is not in world must call Invalidate, the cached results would silently
+ * overwrite it at the next save otherwise.
+ */
+class CharacterPrefetchCache
+{
+    public:
+        CharacterPrefetchCache() {}
+        ~CharacterPrefetchCache();
+
+        // registers a holder about to be queued, false if the character is already cached or loading (holder is not taken)
+        bool Start(uint32 accountId, ObjectGuid guid, SqlQueryHolder* holder);
+        // called from the holder callback
+        CharacterPrefetchResult Complete(ObjectGuid guid, SqlQueryHolder* holder);
+        // at login: hands out a loaded holder or registers the login as waiting for the load in flight
+        CharacterPrefetchState Take(uint32 accountId, ObjectGuid guid, SqlQueryHolder*& holder);
+
+        void Invalidate(ObjectGuid guid);
+        void InvalidateAll();
+
+    private:
+        struct Entry
+        {
+            SqlQueryHolder* holder;
+            uint32 accountId;
+            TimePoint loadedTime;
+            bool loaded;
+            bool invalidated;                               // set on a load in flight, its results are dropped
+            bool loginWaiting;
+            std::list<uint32>::iterator lruPos;             // m_lru.end() once evicted or invalidated
+        };
+
+        typedef std::unordered_map<uint32, Entry> EntryMap;
+
+        void Drop(EntryMap::iterator itr);
+        void Shrink(uint32 maxSize, TimePoint now);
+
+        std::mutex m_lock;
+        EntryMap m_entries;
+        std::list<uint32> m_lru;                            // guid counters, most recent first
+};
+
+#define sCharacterPrefetch MaNGOS::Singleton<CharacterPrefetchCache>::Instance()
+
+#endif
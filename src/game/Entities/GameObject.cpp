@@ -2027,6 +2027,7 @@ void GameObject::UpdateCollisionState() const
         return;
 
     m_model->enable(IsCollisionEnabled() ? true : false);
+    GetMap()->InvalidateLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
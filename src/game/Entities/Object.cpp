@@ -107,7 +107,7 @@ void Object::_InitValues()
     m_uint32Values = new uint32[ m_valuesCount ];
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
-    m_changedValues.resize(m_valuesCount, false);
+    m_changedValues.SetCount(m_valuesCount);
 
     m_objectUpdated = false;
 }
@@ -215,6 +215,9 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
 
 void Object::SendCreateUpdateToPlayer(Player* player) const
 {
+    if (!player->GetSession()->HasPacketInterest(SMSG_UPDATE_OBJECT))
+        return;
+
     // send create update to player
     UpdateData updateData;
     BuildCreateUpdateBlockForPlayer(&updateData, player);
@@ -420,321 +423,306 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
 
     *data << (uint8)updateMask->GetBlockCount();
     data->append(updateMask->GetMask(), updateMask->GetLength());
+    data->reserve(data->size() + updateMask->GetSetBitCount() * sizeof(uint32));
 
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == UNIT_NPC_FLAGS)
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+                uint32 appendValue = m_uint32Values[index];
 
-                    if (GetTypeId() == TYPEID_UNIT)
+                if (GetTypeId() == TYPEID_UNIT)
+                {
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
                     {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
-                        }
+                        if (!((Creature*)this)->IsTrainerOf(target, false))
+                            appendValue &= ~UNIT_NPC_FLAG_TRAINER;
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
+                    if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+                    {
+                        if (target->getClass() != CLASS_HUNTER)
+                            appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    {
+                        QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                         {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanSeeStartQuest(pQuest))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
+                        }
 
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        {
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanRewardQuest(pQuest, false))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
                         }
                     }
+                }
+
+                *data << uint32(appendValue);
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
 
-                    *data << uint32(appendValue);
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
+                     (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                     (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                     (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[index]);
+            }
+            else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // Fog of War: replace absolute health values with percentages for non-allied units according to settings
+                if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target) &&
+                    !target->CanSeeSpecialInfoOf(static_cast<const Unit*>(this)))
+                {
+                    switch (index)
+                    {
+                        case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
+                        case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
+                    }
                 }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+
+                *data << value;
+            }
+            else if (index == UNIT_FIELD_FLAGS)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // For gamemasters in GM mode:
+                if (target->IsGameMaster())
                 {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+                    // Gamemasters should be always able to select units - remove not selectable flag:
+                    value &= ~UNIT_FLAG_UNINTERACTIBLE;
                 }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
+                // Client bug workaround: Fix for missing chat channels when resuming taxi flight on login
+                // Client does not send any chat joining attempts by itself when taxi flag is on
+                if (target == this && (value & UNIT_FLAG_TAXI_FLIGHT))
                 {
-                    *data << uint32(m_floatValues[index]);
+                    if (sWorld.getConfig(CONFIG_BOOL_TAXI_FLIGHT_CHAT_FIX))
+                        if (WorldSession* session = static_cast<Player const*>(this)->GetSession())
+                            if (!session->IsInitialZoneUpdated())
+                                value &= ~UNIT_FLAG_TAXI_FLIGHT;
                 }
-                else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+
+                // On login/reconnect: delay combat state application at client UI to not interfere with secure frames init
+                if (target == this && (value & UNIT_FLAG_IN_COMBAT))
                 {
-                    uint32 value = m_uint32Values[index];
+                    if (static_cast<Player const*>(this)->GetSession()->PlayerLoading())
+                        value &= ~UNIT_FLAG_IN_COMBAT;
+                }
 
-                    // Fog of War: replace absolute health values with percentages for non-allied units according to settings
-                    if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target) &&
-                        !target->CanSeeSpecialInfoOf(static_cast<const Unit*>(this)))
-                    {
-                        switch (index)
-                        {
-                            case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
-                            case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
-                        }
-                    }
+                *data << value;
+            }
+            // Hide lootable animation for unallowed players
+            // Handle tapped flag
+            else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+            {
+                Creature* creature = (Creature*)this;
+                uint32 dynflagsValue = m_uint32Values[index];
+                bool setTapFlags = false;
 
-                    *data << value;
-                }
-                else if (index == UNIT_FIELD_FLAGS)
+                if (creature->IsAlive())
                 {
-                    uint32 value = m_uint32Values[index];
-
-                    // For gamemasters in GM mode:
-                    if (target->IsGameMaster())
-                    {
-                        // Gamemasters should be always able to select units - remove not selectable flag:
-                        value &= ~UNIT_FLAG_UNINTERACTIBLE;
-                    }
+                    // creature is alive so, not lootable
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
 
-                    // Client bug workaround: Fix for missing chat channels when resuming taxi flight on login
-                    // Client does not send any chat joining attempts by itself when taxi flag is on
-                    if (target == this && (value & UNIT_FLAG_TAXI_FLIGHT))
+                    if (creature->IsInCombat())
                     {
-                        if (sWorld.getConfig(CONFIG_BOOL_TAXI_FLIGHT_CHAT_FIX))
-                            if (WorldSession* session = static_cast<Player const*>(this)->GetSession())
-                                if (!session->IsInitialZoneUpdated())
-                                    value &= ~UNIT_FLAG_TAXI_FLIGHT;
+                        // as creature is in combat we have to manage tap flags
+                        setTapFlags = true;
                     }
-
-                    // On login/reconnect: delay combat state application at client UI to not interfere with secure frames init
-                    if (target == this && (value & UNIT_FLAG_IN_COMBAT))
+                    else
                     {
-                        if (static_cast<Player const*>(this)->GetSession()->PlayerLoading())
-                            value &= ~UNIT_FLAG_IN_COMBAT;
+                        // creature is not in combat so its not tapped
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
-
-                    *data << value;
                 }
-                // Hide lootable animation for unallowed players
-                // Handle tapped flag
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+                else
                 {
-                    Creature* creature = (Creature*)this;
-                    uint32 dynflagsValue = m_uint32Values[index];
-                    bool setTapFlags = false;
-
-                    if (creature->IsAlive())
+                    // check loot flag
+                    if (creature->m_loot && creature->m_loot->CanLoot(target))
                     {
-                        // creature is alive so, not lootable
-                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-
-                        if (creature->IsInCombat())
-                        {
-                            // as creature is in combat we have to manage tap flags
-                            setTapFlags = true;
-                        }
-                        else
-                        {
-                            // creature is not in combat so its not tapped
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
+                        // creature is dead and this player can loot it
+                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                        //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
                     else
                     {
-                        // check loot flag
-                        if (creature->m_loot && creature->m_loot->CanLoot(target))
-                        {
-                            // creature is dead and this player can loot it
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
-                        else
-                        {
-                            // creature is dead but this player cannot loot it
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
-
-                        // as creature is died we have to manage tap flags
-                        setTapFlags = true;
+                        // creature is dead but this player cannot loot it
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                        //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
 
-                    // check tap flags
-                    if (setTapFlags)
+                    // as creature is died we have to manage tap flags
+                    setTapFlags = true;
+                }
+
+                // check tap flags
+                if (setTapFlags)
+                {
+                    if (creature->IsTappedBy(target))
                     {
-                        if (creature->IsTappedBy(target))
-                        {
-                            // creature is in combat or died and tapped by this player
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
-                        else
-                        {
-                            // creature is in combat or died but not tapped by this player
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
+                        // creature is in combat or died and tapped by this player
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
-
-                    if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                    else
                     {
-                        Unit const* unit = static_cast<const Unit*>(this); // hunters mark effects should only be visible to owners and not all players
-                        if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
-                            dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
+                        // creature is in combat or died but not tapped by this player
+                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
+                }
 
-                    *data << dynflagsValue;
+                if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                {
+                    Unit const* unit = static_cast<const Unit*>(this); // hunters mark effects should only be visible to owners and not all players
+                    if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
+                        dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
                 }
-                else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+
+                *data << dynflagsValue;
+            }
+            else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
+                if (this != target && GetTypeId() == TYPEID_PLAYER)
                 {
-                    uint32 value = m_uint32Values[index];
+                    Player const* thisPlayer = static_cast<Player const*>(this);
 
-                    // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
-                    if (this != target && GetTypeId() == TYPEID_PLAYER)
+                    if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP) && target->IsInGroup(thisPlayer))
                     {
-                        Player const* thisPlayer = static_cast<Player const*>(this);
+                        const uint32 targetTeam = target->GetTeam();
 
-                        if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP) && target->IsInGroup(thisPlayer))
+                        if (thisPlayer->GetTeam() != targetTeam && value == Player::getFactionForRace(thisPlayer->getRace()))
                         {
-                            const uint32 targetTeam = target->GetTeam();
-
-                            if (thisPlayer->GetTeam() != targetTeam && value == Player::getFactionForRace(thisPlayer->getRace()))
+                            switch (targetTeam)
                             {
-                                switch (targetTeam)
-                                {
-                                    case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
-                                    case HORDE:     value = 1495;   break;  // "Horde Generic"
-                                }
+                                case ALLIANCE:  value = 1054;   break;      // "Alliance Generic"
+                                case HORDE:     value = 1495;   break;      // "Horde Generic"
                             }
                         }
                     }
-
-                    *data << value;
-                }
-                else                                        // Unhandled index, just send
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
                 }
+
+                *data << value;
+            }
+            else                                            // Unhandled index, just send
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
             }
         }
     }
     else if (isType(TYPEMASK_CORPSE))                       // corpse case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == CORPSE_FIELD_BYTES_1)
             {
-                if (index == CORPSE_FIELD_BYTES_1)
+                uint32 value = m_uint32Values[index];
+
+                // [XFACTION]: Alter race field if detected crossfaction group interaction:
+                if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
                 {
-                    uint32 value = m_uint32Values[index];
+                    Corpse const* thisCorpse = static_cast<Corpse const*>(this);
+                    ObjectGuid const& ownerGuid = thisCorpse->GetOwnerGuid();
+                    Group const* targetGroup = target->GetGroup();
 
-                    // [XFACTION]: Alter race field if detected crossfaction group interaction:
-                    if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+                    if (ownerGuid != target->GetObjectGuid() && targetGroup && targetGroup->IsMember(ownerGuid))
                     {
-                        Corpse const* thisCorpse = static_cast<Corpse const*>(this);
-                        ObjectGuid const& ownerGuid = thisCorpse->GetOwnerGuid();
-                        Group const* targetGroup = target->GetGroup();
+                        const uint8 targetRace = target->getRace();
 
-                        if (ownerGuid != target->GetObjectGuid() && targetGroup && targetGroup->IsMember(ownerGuid))
-                        {
-                            const uint8 targetRace = target->getRace();
-
-                            if (Player::TeamForRace(thisCorpse->getRace()) != Player::TeamForRace(targetRace))
-                                value = ((value &~ uint32(0xFF << 8)) | (uint32(targetRace) << 8));
-                        }
+                        if (Player::TeamForRace(thisCorpse->getRace()) != Player::TeamForRace(targetRace))
+                            value = ((value &~ uint32(0xFF << 8)) | (uint32(targetRace) << 8));
                     }
-
-                    *data << value;
                 }
-                else
-                    *data << m_uint32Values[index];         // other cases
+
+                *data << value;
             }
+            else
+                *data << m_uint32Values[index];             // other cases
         }
     }
     else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            // send in current format (float as float, uint32 as uint32)
+            if (index == GAMEOBJECT_DYN_FLAGS)
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
+                if (IsActivateToQuest)
                 {
-                    if (IsActivateToQuest)
+                    GameObject const* gameObject = static_cast<GameObject const*>(this);
+                    switch (((GameObject*)this)->GetGoType())
                     {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                        case GAMEOBJECT_TYPE_QUESTGIVER:
+                        case GAMEOBJECT_TYPE_CHEST:
+                            if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
+                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            else
                                 *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
+                            *data << uint16(0);
+                            break;
+                        case GAMEOBJECT_TYPE_GENERIC:
+                        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                        case GAMEOBJECT_TYPE_GOOBER:
+                            *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                            *data << uint16(0);
+                            break;
+                        default:
+                            *data << uint32(0);             // unknown, not happen.
+                            break;
                     }
-                    else
-                        *data << uint32(0);                 // disable quest object
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                    *data << uint32(0);                     // disable quest object
             }
+            else
+                *data << m_uint32Values[index];             // other cases
         }
     }
     else                                                    // other objects case (no special index checks)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
-            }
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values[index];
         }
     }
 }
 
 void Object::ClearUpdateMask(bool remove)
 {
-    if (m_uint32Values)
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-            m_changedValues[index] = false;
-    }
+    m_changedValues.Clear();
 
     if (m_objectUpdated)
     {
@@ -828,9 +816,8 @@ void Object::_SetUpdateBits(UpdateMask& updateMask, Player* target) const
     uint16 visibleFlag = GetUpdateFieldFlagsForTarget(target, flags);
     MANGOS_ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (m_changedValues[index] && (flags[index] & visibleFlag))
-            updateMask.SetBit(index);
+    // changed fields are tracked as they are set, the target only selects its precomputed visibility mask
+    updateMask.SetToAnd(m_changedValues, UpdateFields::GetUpdateFieldVisibilityMask(GetTypeId(), visibleFlag));
 }
 
 void Object::_SetCreateBits(UpdateMask& updateMask, Player* target) const
@@ -851,7 +838,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -863,7 +850,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -875,8 +862,8 @@ void Object::SetUInt64Value(uint16 index, const uint64& value)
     {
         m_uint32Values[index] = *((uint32*)&value);
         m_uint32Values[index + 1] = *(((uint32*)&value) + 1);
-        m_changedValues[index] = true;
-        m_changedValues[index + 1] = true;
+        m_changedValues.SetBit(index);
+        m_changedValues.SetBit(index + 1);
         MarkForClientUpdate();
     }
 }
@@ -888,7 +875,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -907,7 +894,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -926,7 +913,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -988,7 +975,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -1002,7 +989,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -1020,7 +1007,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> (offset * 8)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -1038,7 +1025,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> (offset * 8)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -1050,7 +1037,7 @@ void Object::SetShortFlag(uint16 index, bool highpart, uint16 newFlag)
     if (!(uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -1062,7 +1049,7 @@ void Object::RemoveShortFlag(uint16 index, bool highpart, uint16 oldFlag)
     if (uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -1130,7 +1117,7 @@ void Object::MarkForClientUpdate()
 
 void Object::ForceValuesUpdateAtIndex(uint16 index)
 {
-    m_changedValues[index] = true;
+    m_changedValues.SetBit(index);
     if (m_inWorld && !m_objectUpdated)
     {
         AddToClientUpdateList();
@@ -1182,7 +1169,7 @@ WorldObject::WorldObject() :
     m_transport(nullptr), m_isOnEventNotified(false),
     m_visibilityData(this), m_currMap(nullptr),
     m_mapId(0), m_InstanceId(0),
-    m_isActiveObject(false), m_debugFlags(0), m_castCounter(0)
+    m_isActiveObject(false), m_debugFlags(0), m_castCounter(0), m_deferredUpdateDiff(0)
 {
 }
 
@@ -2502,7 +2489,8 @@ struct WorldObjectChangeAccumulator
 #ifdef ENABLE_PLAYERBOTS
             if (plr->isRealPlayer())
 #endif
-            i_object.BuildUpdateDataForPlayer(plr, i_updateDatas);
+            if (plr->GetSession()->HasPacketInterest(SMSG_UPDATE_OBJECT))
+                i_object.BuildUpdateDataForPlayer(plr, i_updateDatas);
         }
     }
 
@@ -2515,7 +2503,7 @@ struct WorldObjectChangeAccumulator
             if (owner->isRealPlayer())
             {
 #endif
-            if (owner != &i_object && owner->HasAtClient(&i_object))
+            if (owner != &i_object && owner->HasAtClient(&i_object) && owner->GetSession()->HasPacketInterest(SMSG_UPDATE_OBJECT))
                 i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
 #ifdef ENABLE_PLAYERBOTS
             }
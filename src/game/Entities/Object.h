@@ -24,6 +24,7 @@
 #include "Util/ByteBuffer.h"
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
+#include "Entities/UpdateMask.h"
 #include "Entities/ObjectGuid.h"
 #include "Entities/EntitiesMgr.h"
 #include "Globals/SharedDefines.h"
@@ -102,7 +103,6 @@ class Player;
 class Unit;
 class Group;
 class Map;
-class UpdateMask;
 class InstanceData;
 class TerrainInfo;
 struct MangosStringLocale;
@@ -636,7 +636,7 @@ class Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        UpdateMask m_changedValues;                         // fields changed since last client update
 
         uint16 m_valuesCount;
 
@@ -1179,6 +1179,10 @@ class WorldObject : public Object
 
         virtual uint32 GetRespawnDelay() const { return 0; }
 
+        // time not yet passed to Update() because of the object's map update tier, see MapUpdateLod
+        uint32 GetDeferredUpdateDiff() const { return m_deferredUpdateDiff; }
+        void SetDeferredUpdateDiff(uint32 diff) { m_deferredUpdateDiff = diff; }
+
     protected:
         explicit WorldObject();
 
@@ -1223,6 +1227,8 @@ class WorldObject : public Object
         uint32 m_castCounter;                               // count casts chain of triggered spells for prevent infinity cast crashes
 
         std::set<uint32> m_stringIds;
+
+        uint32 m_deferredUpdateDiff;
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include "Log/Log.h"
 #include "Server/Opcodes.h"
 #include "Spells/SpellMgr.h"
+#include "Entities/CharacterPrefetch.h"
 #include "World/World.h"
 #include "Server/WorldPacket.h"
 #include "Server/WorldSession.h"
@@ -1380,6 +1381,9 @@ void Player::Update(const uint32 diff)
     if (WorldSession* session = GetSession())
         session->m_ticketSquelchTimer.Update(diff);
 
+    // Movement of far players held back since last update
+    FlushMovementRelay();
+
     // Undelivered mail
     if (m_nextMailDelivereTime && m_nextMailDelivereTime <= time(nullptr))
     {
@@ -1703,8 +1707,8 @@ bool Player::BuildEnumData(QueryResult* result, WorldPacket& p_data)
     //    "SELECT characters.guid, characters.name, characters.race, characters.class, characters.gender, characters.playerBytes, characters.playerBytes2, characters.level, "
     //     8                9               10                     11                     12                     13                    14
     //    "characters.zone, characters.map, characters.position_x, characters.position_y, characters.position_z, guild_member.guildid, characters.playerFlags, "
-    //    15                    16                   17                     18                   19
-    //    "characters.at_login, character_pet.entry, character_pet.modelid, character_pet.level, characters.equipmentCache "
+    //    15                    16                   17                     18                   19                         20
+    //    "characters.at_login, character_pet.entry, character_pet.modelid, character_pet.level, characters.equipmentCache, characters.logout_time "
 
     Field* fields = result->Fetch();
 
@@ -2246,11 +2250,28 @@ void Player::RemoveFromWorld()
     {
         GetSession()->GetAnticheat()->LeaveWorld();
         GetCamera().ResetView();
+        m_movementRelay.Clear();
     }
 
     Unit::RemoveFromWorld();
 }
 
+void Player::FlushMovementRelay()
+{
+    MovementRelayShaper::HeldPackets packets;
+    m_movementRelay.Flush(WorldTimer::getMSTime(), sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_INTERVAL), sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_BUDGET), packets);
+
+    WorldSession* session = GetSession();
+    for (auto& held : packets)
+    {
+        // mover went out of sight meanwhile
+        if (m_clientGUIDs.find(held.first) == m_clientGUIDs.end())
+            continue;
+
+        session->SendPacket(SharedWorldPacket(std::move(held.second)));
+    }
+}
+
 float Player::GetNativeScale() const
 {
     CreatureDisplayInfoEntry const* displayInfo = sCreatureDisplayInfoStore.LookupEntry(GetNativeDisplayId());
@@ -4012,6 +4033,8 @@ TrainerSpellState Player::GetTrainerSpellState(TrainerSpell const* trainer_spell
  */
 void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally)
 {
+    sCharacterPrefetch.Invalidate(playerguid);
+
     // for nonexistent account avoid update realm
     if (accountId == 0)
         updateRealmChars = false;
@@ -13999,6 +14022,9 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
     //"health, power1, power2, power3, power4, power5, exploredZones, equipmentCache, ammoId, actionBars, fishingSteps FROM characters WHERE guid = '%u'", GUID_LOPART(m_guid));
     auto queryResult = holder->GetResult(PLAYER_LOGIN_QUERY_LOADFROM);
 
+    // loaded by any path (login, bot, reconnect) - a prefetched copy would be stale after this character plays
+    sCharacterPrefetch.Invalidate(guid);
+
     Object::_Create(guid.GetCounter(), guid.GetCounter(), 0, HIGHGUID_PLAYER);
 
     if (!queryResult)
@@ -15520,6 +15546,9 @@ void Player::SaveToDB()
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
 
+    // results loaded before this save must not be used for a later login
+    sCharacterPrefetch.Invalidate(GetObjectGuid());
+
     // lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
     {
@@ -16307,6 +16336,8 @@ void Player::SendAttackSwingNotInRange() const
 
 void Player::SavePositionInDB(ObjectGuid guid, uint32 mapid, float x, float y, float z, float o, uint32 zone)
 {
+    sCharacterPrefetch.Invalidate(guid);
+
     std::ostringstream ss;
     ss << "UPDATE characters SET position_x='" << x << "',position_y='" << y
        << "',position_z='" << z << "',orientation='" << o << "',map='" << mapid
@@ -17922,7 +17953,8 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
         if (target->isVisibleForInState(this, viewPoint, false))
         {
             visibleNow.insert(target);
-            target->BuildCreateUpdateBlockForPlayer(&data, this);
+            if (GetSession()->HasPacketInterest(SMSG_UPDATE_OBJECT))
+                target->BuildCreateUpdateBlockForPlayer(&data, this);
             AddAtClient(target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(TemplateV): %s is visible now for %s. Distance = %f", target->GetGuidStr().c_str(), GetGuidStr().c_str(), GetDistance(target));
@@ -30,6 +30,7 @@
 #include "Entities/Bag.h"
 #include "Entities/Taxi.h"
 #include "Server/WorldSession.h"
+#include "Server/MovementRelay.h"
 #include "Entities/Pet.h"
 #include "Maps/MapReference.h"
 #include "Util/Util.h"                                           // for Tokens typedef
@@ -2068,6 +2069,10 @@ class Player : public Unit
         void RemoveAtClient(WorldObject* target);
         GuidSet& GetClientGuids() { return m_clientGUIDs; }
 
+        // movement packets of other players relayed to this player, see MovementMessageDeliverer
+        MovementRelayShaper& GetMovementRelay() { return m_movementRelay; }
+        void FlushMovementRelay();
+
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* u) const;
 
@@ -2549,6 +2554,7 @@ class Player : public Unit
         std::set<SpellModifierPair>* m_consumedMods;
 
         GuidSet m_clientGUIDs;
+        MovementRelayShaper m_movementRelay;
 
         std::unordered_map<uint32, TimePoint> m_enteredInstances;
         uint32 m_createdInstanceClearTimer;
@@ -10888,20 +10888,9 @@ class UnitVisitObjectsInRangeNotifyEvent : public BasicEvent
 
         bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
         {
-            float radius = std::max(m_owner.GetDetectionRange(), uint32(MAX_CREATURE_ATTACK_RADIUS)) * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-            if (m_owner.IsPlayer())
-            {
-                MaNGOS::PlayerVisitObjectsNotifier notify(static_cast<Player&>(m_owner));
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            else // if(m_owner.GetTypeId() == TYPEID_UNIT)
-            {
-                Creature& creature = static_cast<Creature&>(m_owner);
-                //since visitor was called we override can aggro with true if creature is alive
-                creature.SetCanAggro(creature.IsAlive());
-                MaNGOS::CreatureVisitObjectsNotifier notify(creature);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
+            // the range visit itself is done for all relocated units of the map at once, see Map::ProcessAINotifies
+            if (m_owner.IsInWorld())
+                m_owner.GetMap()->QueueAINotify(&m_owner);
             m_owner.FinalizeAINotifyEvent();
             return true;
         }
@@ -20,6 +20,7 @@
 #include "UpdateFields.h"
 #include "Log/Log.h"
 #include "ObjectGuid.h"
+#include "UpdateMask.h"
 #include <array>
 #include <vector>
 
@@ -415,6 +416,74 @@ uint16 const* UpdateFields::GetUpdateFieldFlagsArray(uint8 objectTypeId)
     return 0;
 }
 
+// flags Object::GetUpdateFieldFlagsForTarget may add to UF_FLAG_PUBLIC | UF_FLAG_DYNAMIC, each combination is a visibility class
+static std::array<uint16, 5> constexpr g_visibilityClassFlags = {{ UF_FLAG_PRIVATE, UF_FLAG_OWNER_ONLY, UF_FLAG_UNK2, UF_FLAG_SPECIAL_INFO, UF_FLAG_GROUP_ONLY }};
+static uint32 constexpr VISIBILITY_CLASS_COUNT = 1 << g_visibilityClassFlags.size();
+
+struct UpdateFieldVisibilityMasks
+{
+    UpdateFieldVisibilityMasks(uint16 const* flags, uint32 count)
+    {
+        for (uint32 visibilityClass = 0; visibilityClass < VISIBILITY_CLASS_COUNT; ++visibilityClass)
+        {
+            uint16 visibleFlags = UF_FLAG_PUBLIC | UF_FLAG_DYNAMIC;
+            for (uint32 i = 0; i < g_visibilityClassFlags.size(); ++i)
+                if (visibilityClass & (1 << i))
+                    visibleFlags |= g_visibilityClassFlags[i];
+
+            UpdateMask& mask = masks[visibilityClass];
+            mask.SetCount(count);
+            for (uint32 index = 0; index < count; ++index)
+                if (flags[index] & visibleFlags)
+                    mask.SetBit(index);
+        }
+    }
+
+    UpdateMask masks[VISIBILITY_CLASS_COUNT];
+};
+
+UpdateMask const& UpdateFields::GetUpdateFieldVisibilityMask(uint8 objectTypeId, uint16 visibleFlags)
+{
+    uint32 visibilityClass = 0;
+    for (uint32 i = 0; i < g_visibilityClassFlags.size(); ++i)
+        if (visibleFlags & g_visibilityClassFlags[i])
+            visibilityClass |= 1 << i;
+
+    switch (objectTypeId)
+    {
+        case TYPEID_ITEM:
+        case TYPEID_CONTAINER:
+        {
+            static UpdateFieldVisibilityMasks const containerMasks(g_containerUpdateFieldFlags.data(), CONTAINER_END);
+            return containerMasks.masks[visibilityClass];
+        }
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+        {
+            static UpdateFieldVisibilityMasks const playerMasks(g_playerUpdateFieldFlags.data(), PLAYER_END);
+            return playerMasks.masks[visibilityClass];
+        }
+        case TYPEID_GAMEOBJECT:
+        {
+            static UpdateFieldVisibilityMasks const gameObjectMasks(g_gameObjectUpdateFieldFlags.data(), GAMEOBJECT_END);
+            return gameObjectMasks.masks[visibilityClass];
+        }
+        case TYPEID_DYNAMICOBJECT:
+        {
+            static UpdateFieldVisibilityMasks const dynamicObjectMasks(g_dynamicObjectUpdateFieldFlags.data(), DYNAMICOBJECT_END);
+            return dynamicObjectMasks.masks[visibilityClass];
+        }
+        case TYPEID_CORPSE:
+        {
+            static UpdateFieldVisibilityMasks const corpseMasks(g_corpseUpdateFieldFlags.data(), CORPSE_END);
+            return corpseMasks.masks[visibilityClass];
+        }
+    }
+    sLog.outError("Unhandled object type id (%hhu) in GetUpdateFieldVisibilityMask!", objectTypeId);
+    static UpdateMask const noFields;
+    return noFields;
+}
+
 UpdateFieldData const* UpdateFields::GetUpdateFieldDataByName(char const* name)
 {
     for (const auto& itr : g_updateFieldsData)
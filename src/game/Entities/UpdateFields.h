@@ -357,9 +357,13 @@ struct UpdateFieldData
     uint16 flags = UF_FLAG_NONE;
 };
 
+class UpdateMask;
+
 namespace UpdateFields
 {
     uint16 const* GetUpdateFieldFlagsArray(uint8 objectTypeId);
+    // fields of the object type visible with the UF_FLAG_* returned by Object::GetUpdateFieldFlagsForTarget
+    UpdateMask const& GetUpdateFieldVisibilityMask(uint8 objectTypeId, uint16 visibleFlags);
     UpdateFieldData const* GetUpdateFieldDataByName(char const* name);
     UpdateFieldData const* GetUpdateFieldDataByTypeMaskAndOffset(uint8 objectTypeMask, uint16 offset);
 };
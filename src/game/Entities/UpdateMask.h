@@ -19,12 +19,18 @@
 #ifndef __UPDATEMASK_H
 #define __UPDATEMASK_H
 
+#include "Platform/Define.h"
 #include "Util/Errors.h"
 
+#include <bitset>
+#include <cstring>
+
+// Bit per update field, sent as 32 bit blocks. Bits are addressed through the byte view so the wire layout
+// does not depend on endianness, whole mask operations work on 64 bit words of the same memory.
 class UpdateMask
 {
     public:
-        UpdateMask() : mHasData(false), mCount(0), mBlocks(0), mUpdateMask(nullptr) { }
+        UpdateMask() : mHasData(false), mCount(0), mBlocks(0), mWords(0), mUpdateMask(nullptr) { }
         UpdateMask(const UpdateMask& mask) : mUpdateMask(nullptr) { *this = mask; }
 
         ~UpdateMask()
@@ -48,6 +54,40 @@ class UpdateMask
             return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
         }
 
+        // first set bit at or after index, GetCount() if there is none
+        uint32 GetNextSetBit(uint32 index) const
+        {
+            uint8 const* bytes = (uint8 const*)mUpdateMask;
+            while (index < mCount)
+            {
+                if (!(index & 0x3F) && !mUpdateMask[index >> 6])
+                {
+                    index += 64;
+                    continue;
+                }
+
+                uint8 byte = bytes[index >> 3] >> (index & 0x7);
+                if (!byte)
+                {
+                    index = (index | 0x7) + 1;
+                    continue;
+                }
+
+                for (; !(byte & 1); byte >>= 1)
+                    ++index;
+                return index < mCount ? index : mCount;
+            }
+            return mCount;
+        }
+
+        uint32 GetSetBitCount() const
+        {
+            uint32 count = 0;
+            for (uint32 i = 0; i < mWords; ++i)
+                count += uint32(std::bitset<64>(mUpdateMask[i]).count());
+            return count;
+        }
+
         uint32 GetBlockCount() const { return mBlocks; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
@@ -60,22 +100,37 @@ class UpdateMask
 
             mCount = valuesCount;
             mBlocks = (valuesCount + 31) / 32;
+            mWords = (valuesCount + 63) / 64;
 
-            mUpdateMask = new uint32[mBlocks];
-            memset(mUpdateMask, 0, mBlocks << 2);
+            mUpdateMask = new uint64[mWords];
+            memset(mUpdateMask, 0, mWords << 3);
         }
 
         void Clear()
         {
             if (mUpdateMask)
-                memset(mUpdateMask, 0, mBlocks << 2);
+                memset(mUpdateMask, 0, mWords << 3);
             mHasData = false;
         }
 
+        // this = changed & visible, visible may be longer than this mask (e.g. unit fields in the player field table)
+        void SetToAnd(const UpdateMask& changed, const UpdateMask& visible)
+        {
+            MANGOS_ASSERT(changed.mCount == mCount && visible.mCount >= mCount);
+            uint64 any = 0;
+            for (uint32 i = 0; i < mWords; ++i)
+            {
+                mUpdateMask[i] = changed.mUpdateMask[i] & visible.mUpdateMask[i];
+                any |= mUpdateMask[i];
+            }
+            mHasData = any != 0;
+        }
+
         UpdateMask& operator = (const UpdateMask& mask)
         {
             SetCount(mask.mCount);
-            memcpy(mUpdateMask, mask.mUpdateMask, mBlocks << 2);
+            memcpy(mUpdateMask, mask.mUpdateMask, mWords << 3);
+            mHasData = mask.mHasData;
 
             return *this;
         }
@@ -83,14 +138,14 @@ class UpdateMask
         void operator &= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
-            for (uint32 i = 0; i < mBlocks; ++i)
-                mUpdateMask[i] &= mask.mUpdateMask[i];
+            for (uint32 i = 0; i < mWords; ++i)
+                mUpdateMask[i] &= i < mask.mWords ? mask.mUpdateMask[i] : 0;
         }
 
         void operator |= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
-            for (uint32 i = 0; i < mBlocks; ++i)
+            for (uint32 i = 0; i < mask.mWords; ++i)
                 mUpdateMask[i] |= mask.mUpdateMask[i];
         }
 
@@ -117,7 +172,8 @@ class UpdateMask
     private:
         bool mHasData;
         uint32 mCount;
-        uint32 mBlocks;
-        uint32* mUpdateMask;
+        uint32 mBlocks;                                     // 32 bit blocks sent to the client
+        uint32 mWords;                                      // 64 bit words allocated
+        uint64* mUpdateMask;
 };
 #endif
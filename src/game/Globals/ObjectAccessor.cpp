@@ -22,6 +22,7 @@
 #include "Entities/Player.h"
 #include "Entities/Item.h"
 #include "Entities/Corpse.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Maps/MapManager.h"
 #include "Maps/Map.h"
 #include "Grids/CellImpl.h"
@@ -30,6 +31,7 @@
 #include "World/World.h"
 
 #include <mutex>
+#include <thread>
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<ObjectAccessor, std::mutex>
 INSTANTIATE_SINGLETON_2(ObjectAccessor, CLASS_LOCK);
@@ -40,23 +42,149 @@ void HashMapHolder<T>::Insert(T* o)
 {
     WriteGuard guard(i_lock);
     m_objectMap[o->GetObjectGuid()] = o;
+    m_snapshotDirty = true;
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap.erase(o->GetObjectGuid());
+    {
+        WriteGuard guard(i_lock);
+        m_objectMap.erase(o->GetObjectGuid());
+        m_snapshotDirty = true;
+    }
+
+    // lock-free readers which saw a clean snapshot just before may still find the object there
+    WaitForReaders();
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    ReadGuard guard(i_lock);
+    ReaderSlot& slot = GetReaderSlot();
+    slot.lookups.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_lockFreeLookup.load(std::memory_order_relaxed))
+    {
+        uint32 phase = m_snapshotPhase.load() & 1;
+        slot.readers[phase].fetch_add(1);
+        // objects added or removed since the last publication are only in m_objectMap
+        if (!m_snapshotDirty.load())
+        {
+            T* object = nullptr;
+            if (MapType const* snapshot = m_snapshot.load())
+            {
+                typename MapType::const_iterator itr = snapshot->find(guid);
+                if (itr != snapshot->end())
+                    object = itr->second;
+            }
+            slot.readers[phase].fetch_sub(1);
+            return object;
+        }
+        slot.readers[phase].fetch_sub(1);
+    }
+
+    std::unique_lock<LockType> guard(i_lock, std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+        slot.contendedLookups.fetch_add(1, std::memory_order_relaxed);
+        guard.lock();
+    }
     typename MapType::iterator itr = m_objectMap.find(guid);
     return (itr != m_objectMap.end()) ? itr->second : nullptr;
 }
 
+template<class T>
+typename HashMapHolder<T>::ReaderSlot& HashMapHolder<T>::GetReaderSlot()
+{
+    thread_local uint32 slot = m_nextReaderSlot.fetch_add(1) % READER_SLOTS;
+    return m_readerSlots[slot];
+}
+
+template<class T>
+void HashMapHolder<T>::PublishSnapshot()
+{
+    MapType const* old;
+    {
+        WriteGuard guard(i_lock);
+        if (!m_snapshotDirty.load())
+            return;
+
+        old = m_snapshot.exchange(new MapType(m_objectMap));
+        m_snapshotDirty = false;
+    }
+
+    if (!old)
+        return;
+
+    WaitForReaders();
+    delete old;
+}
+
+template<class T>
+void HashMapHolder<T>::FreeSnapshot()
+{
+    MapType const* old;
+    {
+        WriteGuard guard(i_lock);
+        old = m_snapshot.exchange(nullptr);
+        m_snapshotDirty = true;
+    }
+
+    WaitForReaders();
+    delete old;
+}
+
+// returns once no reader that started before the call can still be inside the lock-free part of Find
+template<class T>
+void HashMapHolder<T>::WaitForReaders()
+{
+    std::lock_guard<std::mutex> guard(m_gracePeriodLock);
+
+    // A reader may have read the phase just before a flip and count itself in the phase being waited for next,
+    // so wait for both phases to drain (as in userspace RCU)
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        uint32 oldPhase = m_snapshotPhase.fetch_add(1) & 1;
+        for (ReaderSlot& slot : m_readerSlots)
+        {
+            while (slot.readers[oldPhase].load() != 0)
+            {
+                ++m_gracePeriodWaits;
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+template<class T>
+typename HashMapHolder<T>::LookupStats HashMapHolder<T>::GetLookupStats()
+{
+    LookupStats stats = {};
+    for (ReaderSlot const& slot : m_readerSlots)
+    {
+        stats.lookups += slot.lookups.load(std::memory_order_relaxed);
+        stats.contendedLookups += slot.contendedLookups.load(std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> guard(m_gracePeriodLock);
+    stats.gracePeriodWaits = m_gracePeriodWaits;
+    return stats;
+}
+
+template<class T>
+void HashMapHolder<T>::ResetLookupStats()
+{
+    for (ReaderSlot& slot : m_readerSlots)
+    {
+        slot.lookups.store(0, std::memory_order_relaxed);
+        slot.contendedLookups.store(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> guard(m_gracePeriodLock);
+    m_gracePeriodWaits = 0;
+}
+
 template<class T>
 typename HashMapHolder<T>::MapType& HashMapHolder<T>::GetContainer() { return m_objectMap; }
 
@@ -71,6 +199,15 @@ ObjectAccessor::~ObjectAccessor()
         itr->second->RemoveFromWorld();
         delete itr->second;
     }
+
+    HashMapHolder<Player>::FreeSnapshot();
+    HashMapHolder<Corpse>::FreeSnapshot();
+}
+
+void ObjectAccessor::PublishLookupSnapshots()
+{
+    HashMapHolder<Player>::PublishSnapshot();
+    HashMapHolder<Corpse>::PublishSnapshot();
 }
 
 Unit*
@@ -140,6 +277,13 @@ ObjectAccessor::SaveAllPlayers() const
     }
 }
 
+void ObjectAccessor::AddObject(Player* object)
+{
+    // whoever puts the character in world (session or bot) owns its data now
+    sCharacterPrefetch.Invalidate(object->GetObjectGuid());
+    HashMapHolder<Player>::Insert(object);
+}
+
 void ObjectAccessor::KickPlayer(ObjectGuid guid)
 {
     if (Player* p = ObjectAccessor::FindPlayer(guid, false))
@@ -306,6 +450,14 @@ void ObjectAccessor::RemoveOldCorpses()
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
 template <class T> std::mutex HashMapHolder<T>::i_lock;
+template <class T> std::atomic<typename HashMapHolder<T>::MapType const*> HashMapHolder<T>::m_snapshot(nullptr);
+template <class T> std::atomic<bool> HashMapHolder<T>::m_snapshotDirty(true);
+template <class T> std::atomic<uint32> HashMapHolder<T>::m_snapshotPhase(0);
+template <class T> typename HashMapHolder<T>::ReaderSlot HashMapHolder<T>::m_readerSlots[HashMapHolder<T>::READER_SLOTS];
+template <class T> std::atomic<uint32> HashMapHolder<T>::m_nextReaderSlot(0);
+template <class T> std::atomic<bool> HashMapHolder<T>::m_lockFreeLookup(true);
+template <class T> std::mutex HashMapHolder<T>::m_gracePeriodLock;
+template <class T> uint64 HashMapHolder<T>::m_gracePeriodWaits = 0;
 
 /// Global definitions for the hashmap storage
 
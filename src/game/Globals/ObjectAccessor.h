@@ -31,6 +31,7 @@
 #include "Entities/Player.h"
 #include "Entities/Corpse.h"
 
+#include <atomic>
 #include <mutex>
 
 class Unit;
@@ -53,17 +54,56 @@ class HashMapHolder
 
         static T* Find(ObjectGuid guid);
 
+        // iteration over the container must hold the lock, only Find is lock-free
         static MapType& GetContainer();
 
         static LockType& GetLock();
 
+        struct LookupStats
+        {
+            uint64 lookups;
+            uint64 contendedLookups;                        // lookups that had to wait for i_lock
+            uint64 gracePeriodWaits;                        // Remove/PublishSnapshot waits for lock-free readers of the old snapshot
+        };
+
+        static void SetLockFreeLookup(bool enable) { m_lockFreeLookup = enable; }
+        // copies the container for lock-free Find if it changed, once per world tick
+        static void PublishSnapshot();
+        static void FreeSnapshot();
+        static LookupStats GetLookupStats();
+        static void ResetLookupStats();
+
     private:
 
         // Non instanceable only static
         HashMapHolder() {}
 
+        static constexpr uint32 READER_SLOTS = 32;
+
+        // per thread group reader counts and lookup counters, one cache line each so map threads do not share writes
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<uint32> readers[2];                 // readers inside Find per snapshot phase
+            std::atomic<uint64> lookups;
+            std::atomic<uint64> contendedLookups;
+        };
+
+        static ReaderSlot& GetReaderSlot();
+        static void WaitForReaders();
+
         static LockType i_lock;
         static MapType  m_objectMap;
+
+        // Read only copy of m_objectMap used by lock-free Find, replaced once per tick if changed (read-copy-update)
+        // Until then Find takes i_lock. The replaced copy is deleted once no reader can still use it, readers are counted per phase
+        static std::atomic<MapType const*> m_snapshot;
+        static std::atomic<bool> m_snapshotDirty;           // m_objectMap changed since m_snapshot was copied
+        static std::atomic<uint32> m_snapshotPhase;
+        static ReaderSlot m_readerSlots[READER_SLOTS];
+        static std::atomic<uint32> m_nextReaderSlot;
+        static std::atomic<bool> m_lockFreeLookup;
+        static std::mutex m_gracePeriodLock;                // one grace period at a time, held without i_lock
+        static uint64 m_gracePeriodWaits;                   // guarded by m_gracePeriodLock
 };
 
 class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, std::mutex> >
@@ -94,6 +134,9 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         void SaveAllPlayers() const;
 
+        // makes players and corpses added or removed during the last tick visible to lock-free lookups
+        static void PublishLookupSnapshots();
+
         // Corpse access
         Corpse* GetCorpseForPlayerGUID(ObjectGuid guid);
         static Corpse* GetCorpseInMap(ObjectGuid guid, uint32 mapid);
@@ -105,7 +148,7 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse* object) { HashMapHolder<Corpse>::Insert(object); }
-        void AddObject(Player* object) { HashMapHolder<Player>::Insert(object); }
+        void AddObject(Player* object);
         void RemoveObject(Corpse* object) { HashMapHolder<Corpse>::Remove(object); }
         void RemoveObject(Player* object) { HashMapHolder<Player>::Remove(object); }
 
@@ -29,6 +29,7 @@
 #include "World/World.h"
 #include "Groups/Group.h"
 #include "Entities/Transports.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Util/ProgressBar.h"
 #include "Tools/Language.h"
 #include "Pools/PoolManager.h"
@@ -3822,6 +3823,7 @@ void ObjectMgr::FlushRankPoints(uint32 dateTop)
                 CharacterDatabase.PExecute("UPDATE characters SET stored_honorable_kills = stored_honorable_kills + %u WHERE guid = %u", kills, guid);
             else if (type == DISHONORABLE)
                 CharacterDatabase.PExecute("UPDATE characters SET stored_dishonorable_kills = stored_dishonorable_kills + %u WHERE guid = %u", kills, guid);
+            sCharacterPrefetch.Invalidate(ObjectGuid(HIGHGUID_PLAYER, guid));
         }
         while (queryResult->NextRow());
     }
@@ -3867,6 +3869,7 @@ void ObjectMgr::DistributeRankPoints(uint32 team, uint32 dateBegin, bool flush /
             CharacterDatabase.PExecute("DELETE FROM character_honor_cp WHERE guid = %u AND TYPE = %u AND date BETWEEN %u AND %u", itr->guid, HONORABLE, dateBegin, dateBegin + 7);
             CharacterDatabase.PExecute("UPDATE characters SET stored_honor_rating = %f , stored_honorable_kills = %u WHERE guid = %u", finiteAlways(RP + itr->rpEarning), HK + itr->honorKills, itr->guid);
             CharacterDatabase.CommitTransaction();
+            sCharacterPrefetch.Invalidate(ObjectGuid(HIGHGUID_PLAYER, itr->guid));
         }
     }
 }
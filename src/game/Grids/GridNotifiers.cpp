@@ -26,6 +26,7 @@
 #include "Globals/ObjectAccessor.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "AI/BaseAI/UnitAI.h"
+#include "World/World.h"
 
 using namespace MaNGOS;
 
@@ -98,10 +99,13 @@ void VisibleNotifier::Notify()
     if (i_data.HasData())
     {
         // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
-        for (size_t i = 0; i < i_data.GetPacketCount(); ++i)
+        if (player.GetSession()->HasPacketInterest(SMSG_UPDATE_OBJECT))
         {
-            WorldPacket packet = i_data.BuildPacket(i);
-            player.GetSession()->SendPacket(packet);
+            for (size_t i = 0; i < i_data.GetPacketCount(); ++i)
+            {
+                WorldPacket packet = i_data.BuildPacket(i);
+                player.GetSession()->SendPacket(packet);
+            }
         }
 
         // send out of range to other players if need
@@ -145,6 +149,34 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
     }
 }
 
+MovementMessageDeliverer::MovementMessageDeliverer(Unit const& mover, WorldPacket const& msg, Player const* skipped)
+    : i_mover(mover), i_message(msg), i_skipped_receiver(skipped),
+      i_fullRange(sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_RELAY_FULL_RANGE)), i_now(WorldTimer::getMSTime()),
+      i_interval(sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_INTERVAL)), i_budget(sWorld.getConfig(CONFIG_UINT32_MOVEMENT_RELAY_BUDGET))
+{
+}
+
+void MovementMessageDeliverer::Visit(CameraMapType& m)
+{
+    for (auto& iter : m)
+    {
+        Player* owner = iter.getSource()->GetOwner();
+
+        if (owner == i_skipped_receiver)
+            continue;
+
+        WorldSession* session = owner->GetSession();
+        if (!session)
+            continue;
+
+        bool fullRate = owner->GetSelectionGuid() == i_mover.GetObjectGuid() ||
+                        iter.getSource()->GetBody()->IsWithinDist(&i_mover, i_fullRange);
+
+        if (owner->GetMovementRelay().Relay(i_mover.GetObjectGuid(), i_message, fullRate, i_now, i_interval, i_budget))
+            session->SendPacket(i_message);
+    }
+}
+
 void ObjectMessageDeliverer::Visit(CameraMapType& m)
 {
     for (auto& iter : m)
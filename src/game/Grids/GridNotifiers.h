@@ -27,6 +27,7 @@
 #include "Entities/GameObject.h"
 #include "Entities/Player.h"
 #include "Entities/Unit.h"
+#include "Server/WorldPacket.h"
 
 #include <memory>
 
@@ -61,7 +62,7 @@ namespace MaNGOS
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
         MessageDeliverer(Player const& pl, WorldPacket const& msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
@@ -70,7 +71,7 @@ namespace MaNGOS
 
     struct MessageDelivererExcept
     {
-        WorldPacket const&  i_message;
+        SharedWorldPacket i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldPacket const& msg, Player const* skipped)
@@ -80,9 +81,26 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    // relays the movement of a player controlled unit, shaped per receiver (MovementRelayShaper)
+    struct MovementMessageDeliverer
+    {
+        Unit const& i_mover;
+        SharedWorldPacket i_message;
+        Player const* i_skipped_receiver;
+        float i_fullRange;
+        uint32 i_now;
+        uint32 i_interval;
+        uint32 i_budget;
+
+        MovementMessageDeliverer(Unit const& mover, WorldPacket const& msg, Player const* skipped);
+
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    };
+
     struct ObjectMessageDeliverer
     {
-        WorldPacket const& i_message;
+        SharedWorldPacket i_message;
         explicit ObjectMessageDeliverer(WorldPacket const& msg) : i_message(msg) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
@@ -91,7 +109,7 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
@@ -105,7 +123,7 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket const& i_message;
+        SharedWorldPacket i_message;
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket const& msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
@@ -126,21 +144,11 @@ namespace MaNGOS
             uint32 m_timeDiff;
     };
 
-    struct PlayerVisitObjectsNotifier
-    {
-        Player& i_player;
-        PlayerVisitObjectsNotifier(Player& pl) : i_player(pl) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
-#ifdef _MSC_VER
-        template<> void Visit(PlayerMapType&);
-        template<> void Visit(CreatureMapType&);
-#endif
-    };
-
-    struct CreatureVisitObjectsNotifier
+    // collects the units of the visited cells together with their cell, used by Map::ProcessAINotifies
+    struct AINotifyUnitCollector
     {
-        Creature& i_creature;
-        CreatureVisitObjectsNotifier(Creature& c) : i_creature(c) {}
+        std::vector<std::pair<Unit*, CellPair>>& i_units;
+        AINotifyUnitCollector(std::vector<std::pair<Unit*, CellPair>>& units) : i_units(units) {}
         template<class T> void Visit(GridRefManager<T>&) {}
 #ifdef _MSC_VER
         template<> void Visit(PlayerMapType&);
@@ -1443,10 +1451,8 @@ namespace MaNGOS
     };
 
 #ifndef _MSC_VER
-    template<> void PlayerVisitObjectsNotifier::Visit<Player>(PlayerMapType&);
-    template<> void PlayerVisitObjectsNotifier::Visit<Creature>(CreatureMapType&);
-    template<> void CreatureVisitObjectsNotifier::Visit<Player>(PlayerMapType&);
-    template<> void CreatureVisitObjectsNotifier::Visit<Creature>(CreatureMapType&);
+    template<> void AINotifyUnitCollector::Visit<Player>(PlayerMapType&);
+    template<> void AINotifyUnitCollector::Visit<Creature>(CreatureMapType&);
     template<> inline void DynamicObjectUpdater::Visit<Creature>(CreatureMapType&);
     template<> inline void DynamicObjectUpdater::Visit<Player>(PlayerMapType&);
 #endif
@@ -102,82 +102,72 @@ inline void CreatureVisitCreatureWorker(Creature* c1, Creature* c2)
 }
 
 template<>
-inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(CreatureMapType& m)
+inline void MaNGOS::AINotifyUnitCollector::Visit(CreatureMapType& m)
 {
-    if (!i_player.IsAlive() || i_player.IsTaxiFlying())
-        return;
-
-    bool playerHasAI = i_player.AI() != nullptr;
-
     for (auto& iter : m)
     {
         Creature* creature = iter.getSource();
-        if (!creature->IsAlive())
-            continue;
-
-        UnitVisitObjectsNotifierWorker(creature, &i_player);
-
-        if (playerHasAI)
-            UnitVisitObjectsNotifierWorker(&i_player, creature);
+        i_units.emplace_back(creature, MaNGOS::ComputeCellPair(creature->GetPositionX(), creature->GetPositionY()));
     }
 }
 
 template<>
-inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(PlayerMapType& m)
+inline void MaNGOS::AINotifyUnitCollector::Visit(PlayerMapType& m)
 {
-    if (!i_player.IsAlive() || i_player.IsTaxiFlying())
-        return;
-
-    bool playerHasAI = i_player.AI() != nullptr;
-
     for (auto& iter : m)
     {
         Player* player = iter.getSource();
-        if (player->IsAlive() && !player->IsTaxiFlying())
-            continue;
-
-        if (player->AI())
-            UnitVisitObjectsNotifierWorker(player, &i_player);
-
-        if (playerHasAI)
-            UnitVisitObjectsNotifierWorker(&i_player, player);
+        i_units.emplace_back(player, MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY()));
     }
 }
 
-template<>
-inline void MaNGOS::CreatureVisitObjectsNotifier::Visit(PlayerMapType& m)
+// relocation AI notify between a unit that moved and a unit standing in its notify range
+inline void UnitRelocationAINotifyWorker(Unit* moved, Unit* other)
 {
-    if (!i_creature.IsAlive())
+    if (!moved->IsInWorld() || !other->IsInWorld() || !moved->IsAlive())
         return;
 
-    for (auto& iter : m)
+    if (moved->GetTypeId() == TYPEID_PLAYER)
     {
-        Player* player = iter.getSource();
-        if (!player->IsAlive() || player->IsTaxiFlying())
-            continue;
+        if (moved->IsTaxiFlying())
+            return;
 
-        if (player->AI())
-            UnitVisitObjectsNotifierWorker(player, &i_creature);
+        if (other->GetTypeId() == TYPEID_PLAYER)
+        {
+            if (other->IsAlive() && !other->IsTaxiFlying())
+                return;
 
-        UnitVisitObjectsNotifierWorker(&i_creature, player);
-    }
-}
+            if (other->AI())
+                UnitVisitObjectsNotifierWorker(other, moved);
+        }
+        else
+        {
+            if (!other->IsAlive())
+                return;
 
-template<>
-inline void MaNGOS::CreatureVisitObjectsNotifier::Visit(CreatureMapType& m)
-{
-    if (!i_creature.IsAlive())
-        return;
+            UnitVisitObjectsNotifierWorker(other, moved);
+        }
 
-    for (auto& iter : m)
+        if (moved->AI())
+            UnitVisitObjectsNotifierWorker(moved, other);
+    }
+    else
     {
-        Creature* creature = iter.getSource();
-        if (creature == &i_creature || !creature->IsAlive())
-            continue;
+        if (!other->IsAlive())
+            return;
 
-        UnitVisitObjectsNotifierWorker(creature, &i_creature);
+        if (other->GetTypeId() == TYPEID_PLAYER)
+        {
+            if (other->IsTaxiFlying())
+                return;
+
+            if (other->AI())
+                UnitVisitObjectsNotifierWorker(other, moved);
+        }
+        else
+            UnitVisitObjectsNotifierWorker(other, moved);
 
-        UnitVisitObjectsNotifierWorker(&i_creature, creature);
+        UnitVisitObjectsNotifierWorker(moved, other);
     }
 }
 
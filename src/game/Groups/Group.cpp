@@ -22,6 +22,7 @@
 #include "Server/WorldSession.h"
 #include "Entities/Player.h"
 #include "Globals/ObjectMgr.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Entities/ObjectGuid.h"
 #include "Entities/UpdateData.h"
 #include "Entities/UpdateMask.h"
@@ -776,6 +777,7 @@ void Group::UpdateOfflineLeader(time_t time, uint32 delay)
 
 void Group::BroadcastPacket(WorldPacket const& packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore) const
 {
+    SharedWorldPacket sharedPacket(packet);
     for (GroupReference const* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* pl = itr->getSource();
@@ -783,12 +785,13 @@ void Group::BroadcastPacket(WorldPacket const& packet, bool ignorePlayersInBGRai
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            pl->GetSession()->SendPacket(sharedPacket);
     }
 }
 
 void Group::BroadcastPacketInRange(WorldObject const* who, WorldPacket const& packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore) const
 {
+    SharedWorldPacket sharedPacket(packet);
     for (auto itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* pl = itr->getSource();
@@ -799,7 +802,7 @@ void Group::BroadcastPacketInRange(WorldObject const* who, WorldPacket const& pa
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            pl->GetSession()->SendPacket(sharedPacket);
     }
 }
 
@@ -839,6 +842,8 @@ bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant)
 
 bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant, uint8 group)
 {
+    sCharacterPrefetch.Invalidate(guid);
+
     if (IsFull())
         return false;
 
@@ -914,6 +919,8 @@ bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant, uint
 
 bool Group::_removeMember(ObjectGuid guid)
 {
+    sCharacterPrefetch.Invalidate(guid);
+
     Player* player = sObjectMgr.GetPlayer(guid);
     if (player)
     {
@@ -22,6 +22,7 @@
 #include "Entities/Player.h"
 #include "Server/Opcodes.h"
 #include "Globals/ObjectMgr.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Guilds/Guild.h"
 #include "Guilds/GuildMgr.h"
 #include "Chat/Chat.h"
@@ -166,6 +167,8 @@ void Guild::CreateDefaultGuildRanks(int locale_idx)
 
 bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 {
+    sCharacterPrefetch.Invalidate(plGuid);
+
     Player* pl = sObjectMgr.GetPlayer(plGuid);
     if (pl)
     {
@@ -492,6 +495,8 @@ void Guild::SetLeader(ObjectGuid guid)
  */
 bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
 {
+    sCharacterPrefetch.Invalidate(guid);
+
     uint32 lowguid = guid.GetCounter();
 
     // guild master can be deleted when loading guild and guid doesn't exist in characters table
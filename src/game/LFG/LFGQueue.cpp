@@ -63,19 +63,36 @@ LfgRolePriority LFGPlayerQueueInfo::GetRolePriority(LfgRoles role)
 void LFGQueue::Update()
 {
     TimePoint previously = sWorld.GetCurrentClockTime();
+    bool matchAgain = false;
     while (!World::IsStopped())
     {
+        // sleep until something joins or leaves, or the next queue timer is due. a pass which matched someone
+        // is repeated right away, as only one group is filled or formed per pass
+        if (!matchAgain)
+        {
+            if (m_queuedGroups.empty() && m_queuedPlayers.empty())
+            {
+                GetMessager().WaitForMessages();
+                // nobody was queued while sleeping, the idle time must not count as time in queue
+                previously = sWorld.GetCurrentClockTime();
+            }
+            else
+                GetMessager().WaitForMessages(std::chrono::steady_clock::now() + std::chrono::milliseconds(GetNextTimerDelay()));
+        }
+
+        ++m_updateCount;
         GetMessager().Execute(this);
 
         TimePoint now = sWorld.GetCurrentClockTime();
         uint32 diff = (now - previously).count();
         previously = now;
 
+        size_t const queuedGroups = m_queuedGroups.size();
+        size_t const queuedPlayers = m_queuedPlayers.size();
+        matchAgain = false;
+
         if (m_queuedGroups.empty() && m_queuedPlayers.empty())
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
             continue;
-        }
 
         // Iterate over QueuedPlayersMap to update players timers and remove offline/disconnected players.
         for (auto itr = m_queuedPlayers.begin(); itr != m_queuedPlayers.end();)
@@ -186,6 +203,9 @@ void LFGQueue::Update()
                 ObjectGuid memberGuid = playersInArea.front();
                 uint32 areaId = leader->second.areaId;
 
+                m_matchLatency.Add(leader->second.timeInLFG);
+                m_matchLatency.Add(m_queuedPlayers[memberGuid].timeInLFG);
+
                 RemovePlayerFromQueue(leaderGuid, PLAYER_SYSTEM_LEAVE);
                 RemovePlayerFromQueue(memberGuid, PLAYER_SYSTEM_LEAVE);
 
@@ -220,8 +240,30 @@ void LFGQueue::Update()
             }
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        matchAgain = m_queuedGroups.size() != queuedGroups || m_queuedPlayers.size() != queuedPlayers;
+    }
+}
+
+uint32 LFGQueue::GetNextTimerDelay() const
+{
+    uint32 delay = std::numeric_limits<uint32>::max();
+
+    uint32 const priorityTime = 30 * MINUTE * IN_MILLISECONDS;
+    uint32 const matchmakingTime = sWorld.getConfig(CONFIG_BOOL_LFG_MATCHMAKING) ? sWorld.getConfig(CONFIG_UINT32_LFG_MATCHMAKING_TIMER) * IN_MILLISECONDS : 0;
+
+    for (auto const& queued : m_queuedPlayers)
+    {
+        if (!queued.second.hasQueuePriority && queued.second.timeInLFG < priorityTime)
+            delay = std::min(delay, priorityTime - queued.second.timeInLFG);
+
+        if (queued.second.timeInLFG < matchmakingTime)
+            delay = std::min(delay, matchmakingTime - queued.second.timeInLFG);
     }
+
+    for (auto const& queued : m_queuedGroups)
+        delay = std::min(delay, queued.second.groupTimer);
+
+    return delay;
 }
 
 bool LFGQueue::IsPlayerInQueue(ObjectGuid const& plrGuid) const
@@ -364,6 +406,8 @@ bool LFGQueue::FindRoleToGroup(ObjectGuid playerGuid, uint32 groupId, LfgRoles r
             }
         }
 
+        m_matchLatency.Add(qPlayer->second.timeInLFG);
+
         // Remove player from queue.
         RemovePlayerFromQueue(qPlayer->first, PLAYER_SYSTEM_LEAVE);
 
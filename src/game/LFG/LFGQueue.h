@@ -24,6 +24,9 @@
 #include "Entities/ObjectGuid.h"
 #include "Globals/SharedDefines.h"
 #include "Multithreading/Messager.h"
+#include "Util/LatencyStats.h"
+
+#include <atomic>
 
 class Player;
 
@@ -84,6 +87,10 @@ class LFGQueue
 
         Messager<LFGQueue>& GetMessager() { return m_messager; }
 
+        // time spent in queue by players who were put into a group by the queue
+        LatencyStats& GetMatchLatency() { return m_matchLatency; }
+        uint64 GetUpdateCount() const { return m_updateCount; }
+
         void AddGroup(LFGGroupQueueInfo const& groupInfo, uint32 groupId);
         void AddPlayer(LFGPlayerQueueInfo const& playerInfo, ObjectGuid playerGuid);
 
@@ -99,6 +106,9 @@ class LFGQueue
         void FindInArea(std::list<ObjectGuid>& players, uint32 area, uint32 team, ObjectGuid const& exclude);
         bool FindRoleToGroup(ObjectGuid playerGuid, uint32 groupId, LfgRoles role);
 
+        // milliseconds until the next player or group timer of the queue runs out
+        uint32 GetNextTimerDelay() const;
+
         typedef std::map<ObjectGuid, LFGPlayerQueueInfo> QueuedPlayersMap;
         QueuedPlayersMap m_queuedPlayers;
         QueuedPlayersMap m_offlinePlayers;
@@ -110,6 +120,9 @@ class LFGQueue
 
         uint32 m_groupSize = 5;
 
+        LatencyStats m_matchLatency;
+        std::atomic<uint64> m_updateCount = 0;
+
 #ifdef ENABLE_PLAYERBOTS
         typedef std::map<uint32, MeetingStoneInfo> MeetingStonesMap;
         MeetingStonesMap m_MeetingStonesMap;
@@ -32,6 +32,8 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <sstream>
 #include <iomanip>
+#include <cmath>
+#include <mutex>
 
 INSTANTIATE_SINGLETON_1(LootMgr);
 
@@ -128,6 +130,9 @@ void LootStore::LoadLootTable()
     uint32 count = 0;
     std::map<uint32, uint32> validItems;
 
+    // a drop simulation may still be reading the templates (for reloading case)
+    sLootMgr.StopDropStats();
+
     // Clearing store (for reloading case)
     Clear();
 
@@ -184,6 +189,9 @@ void LootStore::LoadLootTable()
         }
         while (queryResult->NextRow());
 
+        for (auto& tab : m_LootTemplates)
+            tab.second.Compile();
+
         Verify();                                           // Checks validity of the loot store
 
         sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, m_LootTemplates.size(), GetName());
@@ -460,6 +468,12 @@ LootItem::LootItem(uint32 _itemId, uint32 _count, uint32 _randomSuffix, int32 _r
 
 
 // Basic checks for player/item compatibility - if false no chance to see the item in the loot
+// items AllowedForPlayer gives to any player, whatever its quests, conditions or loot role
+bool LootItem::AllowedForAnyPlayer() const
+{
+    return itemProto && lootItemType != LOOTITEM_TYPE_CONDITIONNAL && lootItemType != LOOTITEM_TYPE_QUEST && !itemProto->StartQuest;
+}
+
 bool LootItem::AllowedForPlayer(Player const* player, WorldObject const* lootTarget, Player const* masterLooter) const
 {
     if (!itemProto)
@@ -968,22 +982,29 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
 
     tab->Process(*this, lootOwner, store.IsRatesAllowed()); // Processing is done there, callback via Loot::AddItem()
 
-    // fill the loot owners right here so its impossible from this point to change loot result
+    SetItemRights(m_ownerSet, false);
+    return true;
+}
+
+// fill the loot owners right here so its impossible from this point to change loot result
+// deferred rolls happen after the owners were chosen, those gone offline meanwhile keep the items their state can not affect
+void Loot::SetItemRights(GuidSet const& owners, bool deferred)
+{
     Player* masterLooter = nullptr;
     if (m_lootMethod == MASTER_LOOT)
         masterLooter = ObjectAccessor::FindPlayer(m_masterOwnerGuid);
 
-    for (auto playerGuid : m_ownerSet)
+    for (auto playerGuid : owners)
     {
         Player* player = ObjectAccessor::FindPlayer(playerGuid);
 
         // assign permission for non chest items
         for (auto lootItem : m_lootItems)
         {
-            if (player && (lootItem->AllowedForPlayer(player, GetLootTarget(), masterLooter)))
+            if (player ? lootItem->AllowedForPlayer(player, GetLootTarget(), masterLooter) : deferred && lootItem->AllowedForAnyPlayer())
             {
                 if (!m_isChest)
-                    lootItem->allowedGuid.emplace(player->GetObjectGuid());
+                    lootItem->allowedGuid.emplace(playerGuid);
             }
             else
             {
@@ -1023,8 +1044,33 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
             }
         }
     }
+}
 
-    return true;
+// Rolls corpse items that were deferred at creation, must be called before any access to m_lootItems
+void Loot::FillDeferredLoot()
+{
+    if (!m_pendingLootStore)
+        return;
+
+    LootStore const& store = *m_pendingLootStore;
+    m_pendingLootStore = nullptr;
+
+    LootTemplate const* tab = store.GetLootFor(m_pendingLootId);
+    if (!tab)
+        return;
+
+    // conditions are checked against the killer, or any other owner still online, the items are rolled even with none
+    Player* lootOwner = ObjectAccessor::FindPlayer(m_pendingLootOwnerGuid);
+    for (auto itr = m_pendingOwnerSet.begin(); !lootOwner && itr != m_pendingOwnerSet.end(); ++itr)
+        lootOwner = ObjectAccessor::FindPlayer(*itr);
+
+    m_lootItems.reserve(MAX_NR_LOOT_ITEMS);
+    tab->Process(*this, lootOwner, store.IsRatesAllowed());
+
+    // rights go to the owners taken at death, not to who is online now
+    GuidSet owners;
+    owners.swap(m_pendingOwnerSet);
+    SetItemRights(owners, true);
 }
 
 // Get loot status for a specified player
@@ -1225,6 +1271,8 @@ void Loot::SetPlayerIsNotLooting(Player* player)
 
 void Loot::Release(Player* player)
 {
+    FillDeferredLoot();
+
     bool updateClients = false;
     if (player->GetObjectGuid() == m_currentLooterGuid)
     {
@@ -1458,6 +1506,8 @@ void Loot::Release(Player* player)
 // Popup windows with loot content
 void Loot::ShowContentTo(Player* plr)
 {
+    FillDeferredLoot();
+
     if (!m_isChest)
     {
         // for item loot that might be empty we should not display error but instead send empty loot window
@@ -1665,7 +1715,8 @@ void Loot::SetGroupLootRight(Player* player)
 Loot::Loot(Player* player, Creature* creature, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
     if (!creature)
     {
@@ -1699,9 +1750,27 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
                 SetGroupLootRight(player);
             m_clientLootType = CLIENT_LOOT_CORPSE;
 
-            if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+            // most corpses with money are never opened (aoe farming), their items are rolled on first access.
+            // money alone already makes the corpse lootable for every owner, so nothing visible depends on the items before that
+            bool const deferItems = creatureInfo->LootId && player && creatureInfo->MaxLootGold > 0
+                                    && !creature->GetSettings().HasFlag(CreatureStaticFlags::CAN_WIELD_LOOT) && LootTemplates_Creature.HaveLootFor(creatureInfo->LootId);
+
+            if (deferItems || (creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
             {
                 GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
+                if (deferItems)
+                {
+                    if (m_gold)
+                    {
+                        m_pendingLootStore = &LootTemplates_Creature;
+                        m_pendingLootId = creatureInfo->LootId;
+                        m_pendingLootOwnerGuid = player->GetObjectGuid();
+                        m_pendingOwnerSet = m_ownerSet;
+                    }
+                    else
+                        FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false);
+                }
+
                 // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
                 bool isLootedForAll = IsLootedForAll();
                 if (isLootedForAll)
@@ -1771,7 +1840,8 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
 Loot::Loot(Player* player, GameObject* gameObject, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1858,7 +1928,8 @@ Loot::Loot(Player* player, GameObject* gameObject, LootType type) :
 Loot::Loot(Player* player, Corpse* corpse, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1907,7 +1978,8 @@ Loot::Loot(Player* player, Corpse* corpse, LootType type) :
 Loot::Loot(Player* player, Item* item, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1946,7 +2018,8 @@ Loot::Loot(Player* player, Item* item, LootType type) :
 Loot::Loot(Unit* unit, Item* item) :
     m_lootTarget(nullptr), m_itemTarget(item), m_gold(0), m_maxSlot(0),
     m_lootType(LOOT_SKINNING), m_clientLootType(CLIENT_LOOT_PICKPOCKETING), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0),
-    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
     m_ownerSet.insert(unit->GetObjectGuid());
     m_guidTarget = item->GetObjectGuid();
@@ -1955,7 +2028,8 @@ Loot::Loot(Unit* unit, Item* item) :
 Loot::Loot(Player* player, uint32 id, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
     m_ownerSet.insert(player->GetObjectGuid());
     switch (type)
@@ -1977,7 +2051,8 @@ Loot::Loot(Player* player, uint32 id, LootType type) :
 Loot::Loot(LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_pendingLootStore(nullptr), m_pendingLootId(0)
 {
 
 }
@@ -2083,6 +2158,8 @@ InventoryResult Loot::SendItem(Player* target, LootItem* lootItem, bool sendErro
 
 std::tuple<uint32, uint32, uint32> Loot::GetQualifiedWeapons()
 {
+    FillDeferredLoot();
+
     uint32 mh = 0, oh = 0, ranged = 0;
     uint32 mhType = 0;
     for (auto const& itr : m_lootItems)
@@ -2125,6 +2202,8 @@ std::tuple<uint32, uint32, uint32> Loot::GetQualifiedWeapons()
 
 bool Loot::AutoStore(Player* player, bool broadcast /*= false*/, uint32 bag /*= NULL_BAG*/, uint32 slot /*= NULL_SLOT*/)
 {
+    FillDeferredLoot();
+
     bool result = true;
     for (LootItemList::const_iterator lootItemItr = m_lootItems.begin(); lootItemItr != m_lootItems.end(); ++lootItemItr)
     {
@@ -2194,6 +2273,8 @@ void Loot::ForceLootAnimationClientUpdate() const
 // will return the pointer of item in loot slot provided without any right check
 LootItem* Loot::GetLootItemInSlot(uint32 itemSlot)
 {
+    FillDeferredLoot();
+
     for (auto lootItem : m_lootItems)
     {
         if (lootItem->lootSlot == itemSlot)
@@ -2205,6 +2286,8 @@ LootItem* Loot::GetLootItemInSlot(uint32 itemSlot)
 // Will return available loot item for specific player. Use only for own loot like loot in item and mail
 void Loot::GetLootItemsListFor(Player* player, LootItemList& lootList)
 {
+    FillDeferredLoot();
+
     for (LootItemList::const_iterator lootItemItr = m_lootItems.begin(); lootItemItr != m_lootItems.end(); ++lootItemItr)
     {
         LootItem* lootItem = *lootItemItr;
@@ -2237,6 +2320,8 @@ void Loot::Clear()
     m_haveItemOverThreshold = false;
     m_isChecked = false;
     m_maxSlot = 0;
+    m_pendingLootStore = nullptr;
+    m_pendingOwnerSet.clear();
 }
 
 // only used from explicitly loaded loot
@@ -2248,6 +2333,8 @@ void Loot::SetGoldAmount(uint32 _gold)
 
 void Loot::SendGold(Player* player)
 {
+    FillDeferredLoot();
+
     NotifyMoneyRemoved();
 
     if (m_lootMethod != NOT_GROUP_TYPE_LOOT)           // item can be looted only single player
@@ -2301,8 +2388,10 @@ bool Loot::IsItemAlreadyIn(uint32 itemId) const
     return false;
 }
 
-void Loot::PrintLootList(ChatHandler& chat, WorldSession* session) const
+void Loot::PrintLootList(ChatHandler& chat, WorldSession* session)
 {
+    FillDeferredLoot();
+
     if (!session)
     {
         chat.SendSysMessage("Error you have to be in game for this command.");
@@ -2395,7 +2484,17 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem const& item)
 // Rolls an item from the group, returns nullptr if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player const* lootOwner) const
 {
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    if (!ExplicitAliasTable.empty())                        // Same distribution as the walk below in one step
+    {
+        uint32 index = urand(0, ExplicitAliasTable.size() - 1);
+        AliasSlot const& slot = ExplicitAliasTable[index];
+        if (rand_norm_f() >= slot.probability)
+            index = slot.alias;
+
+        if (index < ExplicitlyChanced.size())
+            return &ExplicitlyChanced[index];
+    }
+    else if (!ExplicitlyChanced.empty())                    // First explicitly chanced entries are checked
     {
         std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
 
@@ -2436,13 +2535,11 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player cons
         for (auto& itr : EqualChanced)
             lootStoreItemVector.push_back(&itr);
 
-        // randomize the new vector
-        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
-
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+        // walk the entries in random order, only shuffling as far as needed (usually the first one is taken)
+        for (uint32 i = 0; i < lootStoreItemVector.size(); ++i)
         {
-            LootStoreItem const* lsi = *itr;
+            std::swap(lootStoreItemVector[i], lootStoreItemVector[urand(i, lootStoreItemVector.size() - 1)]);
+            LootStoreItem const* lsi = lootStoreItemVector[i];
 
             //check if we already have that item in the loot list
             if (loot.IsItemAlreadyIn(lsi->itemid))
@@ -2570,6 +2667,75 @@ void LootTemplate::LootGroup::Verify(LootStore const& lootstore, uint32 id, uint
     }
 }
 
+// Builds a Vose alias table over the explicitly chanced entries and the no drop chance, so Roll takes
+// one index and one float instead of a shuffle and a walk. Only done when the table gives exactly the
+// walk's distribution: no conditions (they skip entries), no 100% entries and a total of at most 100%
+void LootTemplate::LootGroup::Compile()
+{
+    ExplicitAliasTable.clear();
+    if (ExplicitlyChanced.empty())
+        return;
+
+    double total = 0.0;
+    for (auto const& lsi : ExplicitlyChanced)
+    {
+        if (lsi.conditionId || lsi.chance >= 100.0f)
+            return;
+        total += lsi.chance;
+    }
+    if (total > 100.0)
+        return;
+
+    uint32 const size = ExplicitlyChanced.size() + 1;
+    std::vector<double> scaled(size);
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        scaled[i] = ExplicitlyChanced[i].chance * size / 100.0;
+    scaled[size - 1] = (100.0 - total) * size / 100.0;
+
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < size; ++i)
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+
+    ExplicitAliasTable.resize(size);
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+        ExplicitAliasTable[less] = { float(scaled[less]), more };
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // what is left is 1 up to rounding
+    for (uint32 i : large)
+        ExplicitAliasTable[i] = { 1.0f, i };
+    for (uint32 i : small)
+        ExplicitAliasTable[i] = { 1.0f, i };
+}
+
+// Explicit entries drop with their own chance as long as none of them is rolled before the others can be (chance >= 100%)
+// and the group total does not cut the last ones, equal chanced entries depend on all of them and are left out
+void LootTemplate::LootGroup::GetIndependentChances(uint32 groupId, LootChanceMap& chances) const
+{
+    float total = 0.0f;
+    for (auto const& lsi : ExplicitlyChanced)
+    {
+        if (lsi.chance >= 100.0f)
+            return;
+        total += lsi.chance;
+    }
+    if (total > 100.0f)
+        return;
+
+    for (auto const& lsi : ExplicitlyChanced)
+        chances[std::make_pair(groupId, std::make_pair(lsi.mincountOrRef > 0 ? int32(lsi.itemid) : lsi.mincountOrRef, lsi.itemIndex))] = lsi.chance;
+}
+
 // Will try to find invalid reference and looped reference
 // If loop is detected (Reference call itself) the reference will be set to invalid one
 bool LootTemplate::LootGroup::CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevRefs)
@@ -2592,6 +2758,23 @@ bool LootTemplate::LootGroup::CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevR
 // --------- LootTemplate ---------
 //
 
+// Builds the groups alias tables (at loading stage, after all entries are added)
+void LootTemplate::Compile()
+{
+    for (auto& group : Groups)
+        group.Compile();
+}
+
+// Non-grouped entries always roll on their own, groups only when their explicit chances are not cut (see LootGroup)
+void LootTemplate::GetIndependentChances(LootChanceMap& chances) const
+{
+    for (auto const& entry : Entries)
+        chances[std::make_pair(0u, std::make_pair(entry.mincountOrRef > 0 ? int32(entry.itemid) : entry.mincountOrRef, entry.itemIndex))] = std::min(entry.chance, 100.0f);
+
+    for (uint32 i = 0; i < Groups.size(); ++i)
+        Groups[i].GetIndependentChances(i + 1, chances);
+}
+
 // Adds an entry to the group (at loading stage)
 void LootTemplate::AddEntry(LootStoreItem const& item)
 {
@@ -3069,63 +3252,35 @@ Loot* LootMgr::GetLoot(Player* player, ObjectGuid const& targetGuid) const
     return loot;
 }
 
-void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore, bool full) const
-{
-    // choose correct loot template
-    LootStore* store = &LootTemplates_Creature;
-    if (lootStore != "creature")
-    {
-        if (lootStore == "gameobject")
-            store = &LootTemplates_Gameobject;
-        else if (lootStore == "fishing")
-            store = &LootTemplates_Fishing;
-        else if (lootStore == "item")
-            store = &LootTemplates_Item;
-        else if (lootStore == "pickpocketing")
-            store = &LootTemplates_Pickpocketing;
-        else if (lootStore == "skinning")
-            store = &LootTemplates_Skinning;
-        else if (lootStore == "disenchanting")
-            store = &LootTemplates_Disenchant;
-        else if (lootStore == "mail")
-            store = &LootTemplates_Mail;
-        else if (lootStore == "reference")
-            store = &LootTemplates_Reference;
-        else
-            return;
-    }
-
-    if (amountOfCheck < 1)
-        amountOfCheck = 1;
-
-    std::unique_ptr<Loot> loot = std::make_unique<Loot>(LOOT_DEBUG);
-
-    // get loot table for provided loot id
-    LootTemplate const* lootTable = store->GetLootFor(lootId);
-    if (!lootTable)
-    {
-        if (chat.GetSession())
-            chat.PSendSysMessage("No table loot found for lootId(%u) in table loot table '%s'.", lootId, store->GetName());
-        sLog.outError("No table loot found for lootId(%u) in table loot table '%s'.", lootId, store->GetName());
-        return;
-    }
-
-    LootStats lootStats;
-    LootStatsData lootStatsData(lootId, &lootStats);
-
-    // do the loot drop simulation
-    std::unordered_map<uint32, uint32> itemStatsMap;
-    for (uint32 i = 1; i <= amountOfCheck; ++i)
-    {
-        lootTable->Process(*loot, nullptr, store->IsRatesAllowed(), &lootStatsData);
-        for (auto lootItem : loot->m_lootItems)
-            ++itemStatsMap[lootItem->itemId];
-        loot->Clear();
-    }
+static LootStore* GetLootStoreByName(std::string const& lootStore)
+{
+    if (lootStore == "creature")
+        return &LootTemplates_Creature;
+    if (lootStore == "gameobject")
+        return &LootTemplates_Gameobject;
+    if (lootStore == "fishing")
+        return &LootTemplates_Fishing;
+    if (lootStore == "item")
+        return &LootTemplates_Item;
+    if (lootStore == "pickpocketing")
+        return &LootTemplates_Pickpocketing;
+    if (lootStore == "skinning")
+        return &LootTemplates_Skinning;
+    if (lootStore == "disenchanting")
+        return &LootTemplates_Disenchant;
+    if (lootStore == "mail")
+        return &LootTemplates_Mail;
+    if (lootStore == "reference")
+        return &LootTemplates_Reference;
+    return nullptr;
+}
 
+// runs on the world thread, chat is nullptr for console requests (the log output goes to console anyway)
+static void ReportDropStats(ChatHandler* chat, LootStore const* store, uint32 lootId, uint32 amountOfCheck, bool full, LootSimulation const& simulation)
+{
     // sort the result
     auto comp = [](std::pair<uint32, uint32> const& a, std::pair<uint32, uint32> const& b) { return a.second > b.second; };
-    std::set<std::pair<uint32, uint32>, decltype(comp)> sortedResult(itemStatsMap.begin(), itemStatsMap.end(), comp);
+    std::set<std::pair<uint32, uint32>, decltype(comp)> sortedResult(simulation.itemCounts.begin(), simulation.itemCounts.end(), comp);
 
     if (full)
     {
@@ -3140,7 +3295,7 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
 
         std::list<LootStatsInfo> sortedStats;
 
-        for (auto& lootRef : lootStats.groupStatsMap)
+        for (auto& lootRef : simulation.stats.groupStatsMap)
         {
             int32 lootIdOrRef = lootRef.first;
 
@@ -3216,14 +3371,14 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
 
         if (store == &LootTemplates_Reference)
         {
-            if (chat.GetSession())
-                chat.PSendSysMessage("Results for %u drops simulation of loot reference id[%u] in %s:", amountOfCheck, lootId, LootTemplates_Reference.GetName());
+            if (chat)
+                chat->PSendSysMessage("Results for %u drops simulation of loot reference id[%u] in %s:", amountOfCheck, lootId, LootTemplates_Reference.GetName());
             sLog.outString("Results for %u drops simulation of loot reference id[%u] in %s:", amountOfCheck, lootId, LootTemplates_Reference.GetName());
         }
         else
         {
-            if (chat.GetSession())
-                chat.PSendSysMessage("Results for %u drops simulation of loot id[%u] in %s:", amountOfCheck, lootId, store->GetName());
+            if (chat)
+                chat->PSendSysMessage("Results for %u drops simulation of loot id[%u] in %s:", amountOfCheck, lootId, store->GetName());
             sLog.outString("Results for %u drops simulation of loot id[%u] in %s:", amountOfCheck, lootId, store->GetName());
         }
 
@@ -3240,14 +3395,14 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
                 if (refNameItr != refNames.end())
                     refName = &refNameItr->second;
 
-                if (chat.GetSession())
-                    chat.PSendSysMessage("In %s[%d] '%s':", LootTemplates_Reference.GetName(), -lootIdOrRef, (*refName).c_str());
+                if (chat)
+                    chat->PSendSysMessage("In %s[%d] '%s':", LootTemplates_Reference.GetName(), -lootIdOrRef, (*refName).c_str());
                 sLog.outString("In %s[%d] '%s':", LootTemplates_Reference.GetName(), -lootIdOrRef, (*refName).c_str());
             }
             else
             {
-                if (chat.GetSession())
-                    chat.PSendSysMessage("In %s[%d]:", store->GetName(), lootIdOrRef);
+                if (chat)
+                    chat->PSendSysMessage("In %s[%d]:", store->GetName(), lootIdOrRef);
                 sLog.outString("In %s[%d]:", store->GetName(), lootIdOrRef);
             }
 
@@ -3257,8 +3412,8 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
                 uint32 groupId = groupStats.first;
                 auto& itemsStats = groupStats.second;
 
-                if (chat.GetSession())
-                    chat.PSendSysMessage("Group %u:", groupId);
+                if (chat)
+                    chat->PSendSysMessage("Group %u:", groupId);
                 sLog.outString("Group %u:", groupId);
 
                 for (auto& stats : itemsStats)
@@ -3281,8 +3436,8 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
                         stream << std::hex << std::setw(8) << std::setfill('0') << color;
                         stream << "|Hitem:" << std::dec << itemId << ":0:0:0:0:0:0:0|h[" << name << "]|h|r ";
 
-                        if (chat.GetSession())
-                            chat.PSendSysMessage("%s", stream.str().c_str());
+                        if (chat)
+                            chat->PSendSysMessage("%s", stream.str().c_str());
                         sLog.outString("%8d - %-45s \tfound %6u/%-6u \tso %8s%% drop", itemId, name.c_str(), count, amountOfCheck, std::to_string(computedStats).c_str());
                     }
                     else
@@ -3294,23 +3449,23 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
                         // Build the format string -> "%d - Reference [%d] %f%%"
                         stream << "  - |cffffffff" << std::fixed << std::setprecision(4) << std::setw(8) << std::setfill(' ') << computedStats << "%%|r - [";
                         stream << std::dec << -itemId << "] - " << *refName;
-                        if (chat.GetSession())
-                            chat.PSendSysMessage("%s", stream.str().c_str());
+                        if (chat)
+                            chat->PSendSysMessage("%s", stream.str().c_str());
                         sLog.outString("%8d - %-45s \tfound %6u/%-6u \tso %8s%% drop", itemId, (*refName).c_str(), count, amountOfCheck, std::to_string(computedStats).c_str());
                     }
                 }
             }
 
-            if (chat.GetSession())
-                chat.PSendSysMessage("----------------------");
+            if (chat)
+                chat->PSendSysMessage("----------------------");
             sLog.outString("----------------------");
         }
     }
     else
     {
         // report the result in both chat client and console
-        if (chat.GetSession())
-            chat.PSendSysMessage("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
+        if (chat)
+            chat->PSendSysMessage("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
         sLog.outString("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
         std::stringstream ss;
         for (auto itemStat : sortedResult)
@@ -3332,13 +3487,254 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
             ss << std::hex << std::setw(8) << std::setfill('0') << color;
             ss << "|Hitem:" << std::dec << itemId << ":0:0:0:0:0:0:0|h[" << name << "]|h|r ";
 
-            if (chat.GetSession())
-                chat.PSendSysMessage("%s", ss.str().c_str());
+            if (chat)
+                chat->PSendSysMessage("%s", ss.str().c_str());
             sLog.outString("%6u - %-45s \tfound %6u/%-6u \tso %8s%% drop", itemStat.first, name.c_str(), itemStat.second, amountOfCheck, ss.str().c_str());
         }
     }
 }
 
+// sends a line to the requester (account 0 is the console) and the log, from the world thread
+static void SendDropStatsMessage(uint32 accountId, std::string const& text)
+{
+    sWorld.GetMessager().AddMessage([accountId, text](World* world)
+    {
+        if (accountId)
+            if (WorldSession* session = world->FindSession(accountId))
+                ChatHandler(session).SendSysMessage(text.c_str());
+        sLog.outString("%s", text.c_str());
+    });
+}
+
+void LootMgr::SimulateDrops(LootTemplate const& lootTable, uint32 lootId, bool rate, uint32 amount, LootSimulation& result)
+{
+    std::unique_ptr<Loot> loot = std::make_unique<Loot>(LOOT_DEBUG);
+    LootStatsData lootStatsData(lootId, &result.stats);
+
+    uint32 done = 0;
+    for (uint32 i = 0; i < amount && !m_dropStatsCancel; ++i)
+    {
+        lootTable.Process(*loot, nullptr, rate, &lootStatsData);
+        for (auto lootItem : loot->m_lootItems)
+            ++result.itemCounts[lootItem->itemId];
+        loot->Clear();
+
+        // progress is shared by all threads, do not touch it every drop
+        if (++done == 1024)
+        {
+            m_dropStatsDone += done;
+            done = 0;
+        }
+    }
+    m_dropStatsDone += done;
+}
+
+bool LootMgr::StartDropStats(ChatHandler& chat, uint64 total, std::function<void()>&& job)
+{
+    if (m_dropStatsRunning)
+    {
+        chat.SendSysMessage("A drop simulation is already running, try again when it is done.");
+        return false;
+    }
+
+    if (m_dropStatsThread.joinable())
+        m_dropStatsThread.join();
+
+    m_dropStatsCancel = false;
+    m_dropStatsDone = 0;
+    m_dropStatsTotal = total;
+    m_dropStatsRunning = true;
+    m_dropStatsThread = std::thread([this, job = std::move(job)]()
+    {
+        job();
+        m_dropStatsRunning = false;
+    });
+
+    chat.SendSysMessage("Drop simulation started, results will be sent when it is done.");
+    return true;
+}
+
+// runs work(threadIndex) on the simulation threads, reporting progress every few seconds until all of them are done
+void LootMgr::RunDropStatsWorkers(uint32 accountId, std::function<void(uint32)> const& work)
+{
+    // leave cores for the map updaters
+    uint32 const threadCount = std::max(1u, std::min(8u, std::thread::hardware_concurrency() / 2));
+
+    std::atomic<uint32> finished(0);
+    std::vector<std::thread> workers;
+    for (uint32 i = 0; i < threadCount; ++i)
+    {
+        workers.emplace_back([&work, &finished, i]()
+        {
+            work(i);
+            ++finished;
+        });
+    }
+
+    auto lastReport = std::chrono::steady_clock::now();
+    while (finished < threadCount)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReport >= std::chrono::seconds(5) && !m_dropStatsCancel)
+        {
+            lastReport = now;
+            SendDropStatsMessage(accountId, "Drop simulation " + std::to_string(m_dropStatsDone * 100 / std::max<uint64>(m_dropStatsTotal, 1)) + "% done");
+        }
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void LootMgr::StopDropStats()
+{
+    m_dropStatsCancel = true;
+    if (m_dropStatsThread.joinable())
+        m_dropStatsThread.join();
+}
+
+void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore, bool full)
+{
+    // choose correct loot template
+    LootStore* store = GetLootStoreByName(lootStore);
+    if (!store)
+        return;
+
+    if (amountOfCheck < 1)
+        amountOfCheck = 1;
+
+    // get loot table for provided loot id
+    LootTemplate const* lootTable = store->GetLootFor(lootId);
+    if (!lootTable)
+    {
+        if (chat.GetSession())
+            chat.PSendSysMessage("No table loot found for lootId(%u) in table loot table '%s'.", lootId, store->GetName());
+        sLog.outError("No table loot found for lootId(%u) in table loot table '%s'.", lootId, store->GetName());
+        return;
+    }
+
+    uint32 accountId = chat.GetSession() ? chat.GetSession()->GetAccountId() : 0;
+    StartDropStats(chat, amountOfCheck, [this, store, lootTable, lootId, amountOfCheck, full, accountId]()
+    {
+        // do the loot drop simulation, split between the threads
+        std::vector<LootSimulation> results(std::max(1u, std::min(8u, std::thread::hardware_concurrency() / 2)));
+        RunDropStatsWorkers(accountId, [&](uint32 index)
+        {
+            uint32 amount = amountOfCheck / results.size() + (index < amountOfCheck % results.size() ? 1 : 0);
+            SimulateDrops(*lootTable, lootId, store->IsRatesAllowed(), amount, results[index]);
+        });
+
+        if (m_dropStatsCancel)
+            return;
+
+        auto simulation = std::make_shared<LootSimulation>();
+        for (auto const& result : results)
+            simulation->Merge(result);
+
+        sWorld.GetMessager().AddMessage([store, lootId, amountOfCheck, full, accountId, simulation](World* world)
+        {
+            WorldSession* session = accountId ? world->FindSession(accountId) : nullptr;
+            std::unique_ptr<ChatHandler> chat = session ? std::make_unique<ChatHandler>(session) : nullptr;
+            ReportDropStats(chat.get(), store, lootId, amountOfCheck, full, *simulation);
+        });
+    });
+}
+
+// Simulates every template of a store without rates and reports the entries whose drop rate is off their db chance
+// by more than the tolerance (in percent points) or 4 standard deviations of the simulation, whichever is larger
+void LootMgr::AuditDropStats(ChatHandler& chat, std::string lootStore, uint32 amountOfCheck, float tolerance)
+{
+    LootStore* store = GetLootStoreByName(lootStore);
+    if (!store)
+        return;
+
+    if (amountOfCheck < 1)
+        amountOfCheck = 1;
+
+    auto templates = std::make_shared<std::vector<std::pair<uint32, LootTemplate const*>>>();
+    for (auto const& itr : store->GetLootTemplates())
+        templates->emplace_back(itr.first, &itr.second);
+    std::sort(templates->begin(), templates->end());
+
+    uint32 accountId = chat.GetSession() ? chat.GetSession()->GetAccountId() : 0;
+    StartDropStats(chat, uint64(templates->size()) * amountOfCheck, [this, store, templates, amountOfCheck, tolerance, accountId]()
+    {
+        std::atomic<uint32> nextTemplate(0);
+        std::mutex resultLock;
+        std::vector<std::pair<uint32, std::string>> deviations;
+        uint32 checkedEntries = 0;
+
+        RunDropStatsWorkers(accountId, [&](uint32 /*index*/)
+        {
+            std::vector<std::pair<uint32, std::string>> found;
+            uint32 checked = 0;
+            for (uint32 i = nextTemplate++; i < templates->size() && !m_dropStatsCancel; i = nextTemplate++)
+            {
+                uint32 lootId = (*templates)[i].first;
+                LootTemplate const* lootTable = (*templates)[i].second;
+
+                LootChanceMap chances;
+                lootTable->GetIndependentChances(chances);
+                if (chances.empty())
+                {
+                    m_dropStatsDone += amountOfCheck;
+                    continue;
+                }
+
+                LootSimulation simulation;
+                SimulateDrops(*lootTable, lootId, false, amountOfCheck, simulation);
+                LootStats::GroupStats& stats = *simulation.stats.GetStatsForLootId(lootId);
+
+                for (auto const& chance : chances)
+                {
+                    ++checked;
+                    uint32 count = stats.groups[chance.first.first][chance.first.second];
+                    double expected = chance.second / 100.0;
+                    double observed = count / double(amountOfCheck);
+                    double allowed = std::max(tolerance / 100.0, 4.0 * std::sqrt(expected * (1.0 - expected) / amountOfCheck));
+                    if (std::abs(observed - expected) <= allowed)
+                        continue;
+
+                    int32 itemOrRef = chance.first.second.first;
+                    char line[256];
+                    snprintf(line, sizeof(line), "%s[%u] group %u %s %d: expected %.3f%% got %.3f%%", store->GetName(), lootId, chance.first.first,
+                             itemOrRef < 0 ? "reference" : "item", itemOrRef < 0 ? -itemOrRef : itemOrRef, expected * 100.0, observed * 100.0);
+                    found.emplace_back(lootId, line);
+                }
+            }
+
+            std::lock_guard<std::mutex> guard(resultLock);
+            deviations.insert(deviations.end(), found.begin(), found.end());
+            checkedEntries += checked;
+        });
+
+        if (m_dropStatsCancel)
+            return;
+
+        std::sort(deviations.begin(), deviations.end());
+
+        // the full list goes to the log, chat gets the first lines
+        uint32 const maxChatLines = 50;
+        auto lines = std::make_shared<std::vector<std::string>>();
+        lines->push_back("Drop audit of " + std::to_string(templates->size()) + " templates in " + store->GetName() + " with " + std::to_string(amountOfCheck) +
+                         " drops each: " + std::to_string(checkedEntries) + " entries checked, " + std::to_string(deviations.size()) + " off their chance");
+        for (auto const& deviation : deviations)
+            lines->push_back(deviation.second);
+
+        sWorld.GetMessager().AddMessage([accountId, lines, maxChatLines](World* world)
+        {
+            WorldSession* session = accountId ? world->FindSession(accountId) : nullptr;
+            for (uint32 i = 0; i < lines->size(); ++i)
+            {
+                if (session && i <= maxChatLines)
+                    ChatHandler(session).SendSysMessage(i < maxChatLines ? (*lines)[i].c_str() : "... see the server log for the full list");
+                sLog.outString("%s", (*lines)[i].c_str());
+            }
+        });
+    });
+}
+
 bool LootMgr::ExistsRefLootTemplate(uint32 refLootId) const
 {
     return LootTemplates_Reference.HaveLootFor(refLootId);
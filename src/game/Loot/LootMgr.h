@@ -24,6 +24,9 @@
 #include "Globals/SharedDefines.h"
 
 #include <vector>
+#include <atomic>
+#include <functional>
+#include <thread>
 #include "Entities/Bag.h"
 
 #define LOOT_ROLL_TIMEOUT  (1*MINUTE*IN_MILLISECONDS)
@@ -147,6 +150,32 @@ struct LootStats
     {
         return &groupStatsMap[lootId];
     }
+
+    // adds the counts of a simulation run on another thread
+    void Merge(LootStats const& other)
+    {
+        for (auto const& lootStats : other.groupStatsMap)
+            for (auto const& group : lootStats.second.groups)
+                for (auto const& item : group.second)
+                    groupStatsMap[lootStats.first].groups[group.first][item.first] += item.second;
+    }
+};
+
+// drop chance in percent per (group, item or reference) of one template, same keys as LootStats::GroupStats
+typedef std::map<std::pair<uint32, LootStats::GroupStats::ItemIndex>, float> LootChanceMap;
+
+// result of a drop simulation, each simulation thread fills its own and they are merged at the end
+struct LootSimulation
+{
+    LootStats stats;
+    std::unordered_map<uint32, uint32> itemCounts;          // item id and how often it dropped
+
+    void Merge(LootSimulation const& other)
+    {
+        stats.Merge(other.stats);
+        for (auto const& item : other.itemCounts)
+            itemCounts[item.first] += item.second;
+    }
 };
 
 struct LootStatsData
@@ -248,6 +277,7 @@ struct LootItem
 
     // Basic checks for player/item compatibility - if false no chance to see the item in the loot
     bool AllowedForPlayer(Player const* player, WorldObject const* lootTarget, Player const* masterLooter) const;
+    bool AllowedForAnyPlayer() const;
     LootSlotType GetSlotTypeForSharedLoot(Player const* player, Loot const* loot) const;
     bool IsAllowed(Player const* player, Loot const* loot) const;
 };
@@ -274,10 +304,19 @@ class LootTemplate
 
                 void Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const;
                 bool CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevRefs);
+                void Compile();                                     // Builds the alias table (at loading stage)
+                void GetIndependentChances(uint32 groupId, LootChanceMap& chances) const;
 
             private:
+                struct AliasSlot
+                {
+                    float probability;                              // chance to keep the rolled slot
+                    uint32 alias;                                   // slot taken otherwise
+                };
+
                 LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
                 LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+                std::vector<AliasSlot> ExplicitAliasTable;          // One slot per explicit entry plus a last one for no drop, empty if the entries must be rolled in order
 
                 // Rolls an item from the group, returns nullptr if all miss their chances
                 LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const;
@@ -300,6 +339,9 @@ class LootTemplate
         // Checks integrity of the template
         void Verify(LootStore const& lootstore, uint32 id) const;
         bool CheckLootRefs(LootIdSet* ref_set, LootIdSet& prevRefs);
+        void Compile();
+        // Chances of the entries whose drop rate does not depend on other entries, for drop rate audits
+        void GetIndependentChances(LootChanceMap& chances) const;
     private:
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimized) processing, grouped entries go there
@@ -325,6 +367,7 @@ class LootStore
         bool HaveQuestLootForPlayer(uint32 loot_id, Player* player) const;
 
         LootTemplate const* GetLootFor(uint32 loot_id) const;
+        LootTemplateMap const& GetLootTemplates() const { return m_LootTemplates; }
 
         char const* GetName() const { return m_name; }
         char const* GetEntryName() const { return m_entryName; }
@@ -378,7 +421,7 @@ class Loot
         void SetGoldAmount(uint32 _gold);
         void SendGold(Player* player);
         bool IsItemAlreadyIn(uint32 itemId) const;
-        void PrintLootList(ChatHandler& chat, WorldSession* session) const;
+        void PrintLootList(ChatHandler& chat, WorldSession* session);
         bool HasLoot() const;
         uint32 GetGoldAmount() const { return m_gold; }
         LootType GetLootType() const { return m_lootType; }
@@ -397,7 +440,7 @@ class Loot
     private:
         Loot(): m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(),
             m_clientLootType(), m_lootMethod(), m_threshold(), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false)
+            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_pendingLootStore(nullptr), m_pendingLootId(0)
         {}
         void Clear();
         bool IsLootedFor(Player const* player) const;
@@ -413,6 +456,8 @@ class Loot
         void SetGroupLootRight(Player* player);
         void GenerateMoneyLoot(uint32 minAmount, uint32 maxAmount);
         bool FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, bool personal, bool noEmptyError = false);
+        void FillDeferredLoot();
+        void SetItemRights(GuidSet const& owners, bool deferred);
         void ForceLootAnimationClientUpdate() const;
         void SetPlayerIsLooting(Player* player);
         void SetPlayerIsNotLooting(Player* player);
@@ -445,6 +490,10 @@ class Loot
         GuidSet          m_playersLooting;                // player who opened loot windows
         GuidSet          m_playersOpened;                 // players that have released the corpse
         TimePoint        m_createTime;                    // create time (used to refill loot if need)
+        LootStore const* m_pendingLootStore;              // corpse items not rolled yet, rolled on first access (see FillDeferredLoot)
+        uint32           m_pendingLootId;
+        ObjectGuid       m_pendingLootOwnerGuid;
+        GuidSet          m_pendingOwnerSet;               // owners at death, they get the rights when the items are rolled
 };
 
 extern LootStore LootTemplates_Creature;
@@ -486,10 +535,28 @@ inline void LoadLootTables(LootIdSet& ids_set)
 class LootMgr
 {
     public:
+        LootMgr() : m_dropStatsRunning(false), m_dropStatsCancel(false), m_dropStatsDone(0), m_dropStatsTotal(0) {}
+        ~LootMgr() { StopDropStats(); }
+
         void PlayerVote(Player* player, ObjectGuid const& lootTargetGuid, uint32 itemSlot, RollVote vote);
         Loot* GetLoot(Player* player, ObjectGuid const& targetGuid = ObjectGuid()) const;
-        void CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore, bool full) const;
         bool ExistsRefLootTemplate(uint32 refLootId) const;
+
+        // Drop simulations run in the background, progress and results are sent to the requester from the world thread
+        void CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore, bool full);
+        void AuditDropStats(ChatHandler& chat, std::string lootStore, uint32 amountOfCheck, float tolerance);
+        void StopDropStats();                               // cancels a running simulation and waits for it, must be done before loot tables change
+
+    private:
+        bool StartDropStats(ChatHandler& chat, uint64 total, std::function<void()>&& job);
+        void RunDropStatsWorkers(uint32 accountId, std::function<void(uint32)> const& work);
+        void SimulateDrops(LootTemplate const& lootTable, uint32 lootId, bool rate, uint32 amount, LootSimulation& result);
+
+        std::thread m_dropStatsThread;
+        std::atomic<bool> m_dropStatsRunning;
+        std::atomic<bool> m_dropStatsCancel;
+        std::atomic<uint64> m_dropStatsDone;                // simulated drops, for progress
+        uint64 m_dropStatsTotal;
 };
 
 #define sLootMgr MaNGOS::Singleton<LootMgr>::Instance()
@@ -31,6 +31,7 @@
 #include "World/World.h"
 #include "Globals/ObjectMgr.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Entities/Player.h"
 #include "Entities/UpdateMask.h"
 #include "Entities/Unit.h"
@@ -285,6 +286,9 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
         return;
     }
 
+    if (!pReceiver)
+        sCharacterPrefetch.Invalidate(receiver.GetPlayerGuid());
+
     bool has_items = !m_items.empty();
 
     // generate mail template items for online player, for offline player items will generated at open
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LINE_OF_SIGHT_CACHE_H
+#define LINE_OF_SIGHT_CACHE_H
+
+#include "Platform/Define.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+
+// Short lived cache of line of sight results of one map
+// Positions are quantized, so objects standing still (or nearly so) reuse results within one map update
+// Segment tests are symmetric, so A->B and B->A share an entry
+// Not synchronized - only the thread updating the map uses it, checks from any other thread bypass it
+class LineOfSightCache
+{
+    public:
+        // called at the start of every map update, map may be updated by another worker each tick
+        void SetOwnerThread(std::thread::id id) { m_ownerThread = id; }
+
+        bool Find(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model, bool& result)
+        {
+            if (!IsOwnerThread())
+                return false;
+
+            auto itr = m_results.find(MakeKey(x1, y1, z1, x2, y2, z2, ignoreM2Model));
+            if (itr == m_results.end())
+                return false;
+
+            result = itr->second;
+            return true;
+        }
+
+        void Insert(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model, bool result)
+        {
+            if (!IsOwnerThread())
+                return;
+
+            if (m_results.size() >= MAX_ENTRIES)
+                m_results.clear();
+
+            m_results[MakeKey(x1, y1, z1, x2, y2, z2, ignoreM2Model)] = result;
+        }
+
+        void Clear() { m_results.clear(); }
+
+    private:
+        static constexpr float QUANTIZE_SCALE = 4.0f;      // 0.25 yard buckets
+        static constexpr size_t MAX_ENTRIES = 8192;
+
+        struct Key
+        {
+            int32 coords[6];
+            bool ignoreM2Model;
+
+            bool operator==(Key const& other) const
+            {
+                for (uint32 i = 0; i < 6; ++i)
+                    if (coords[i] != other.coords[i])
+                        return false;
+                return ignoreM2Model == other.ignoreM2Model;
+            }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(Key const& key) const
+            {
+                uint64 hash = key.ignoreM2Model ? 1 : 0;
+                for (int32 coord : key.coords)
+                    hash = (hash ^ uint32(coord)) * 0x100000001B3ULL;
+                return std::size_t(hash ^ (hash >> 32));
+            }
+        };
+
+        bool IsOwnerThread() const { return m_ownerThread.load() == std::this_thread::get_id(); }
+
+        static int32 Quantize(float value) { return int32(std::floor(value * QUANTIZE_SCALE)); }
+
+        static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model)
+        {
+            int32 a[3] = { Quantize(x1), Quantize(y1), Quantize(z1) };
+            int32 b[3] = { Quantize(x2), Quantize(y2), Quantize(z2) };
+            bool swap = a[0] != b[0] ? a[0] > b[0] : (a[1] != b[1] ? a[1] > b[1] : a[2] > b[2]);
+
+            Key key;
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                key.coords[i] = swap ? b[i] : a[i];
+                key.coords[i + 3] = swap ? a[i] : b[i];
+            }
+            key.ignoreM2Model = ignoreM2Model;
+            return key;
+        }
+
+        std::unordered_map<Key, bool, KeyHash> m_results;
+        std::atomic<std::thread::id> m_ownerThread;
+};
+
+#endif
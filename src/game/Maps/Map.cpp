@@ -36,6 +36,7 @@
 #include "Server/DBCEnums.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include <G3D/Vector3.h>
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
@@ -46,6 +47,7 @@
 #endif
 
 #include <time.h>
+#include <unordered_set>
 
 #ifdef ENABLE_PLAYERBOTS
 #include "playerbot/playerbot.h"
@@ -56,7 +58,10 @@ Map::~Map()
     UnloadAll(true);
 
     if (m_persistentState)
+    {
+        m_persistentState->SaveRespawnTimes();
         m_persistentState->SetUsedByMapState(nullptr);         // field pointer can be deleted after this
+    }
 
     delete i_data;
     i_data = nullptr;
@@ -155,13 +160,13 @@ void Map::LoadMapAndVMap(int gx, int gy)
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
     : i_mapEntry(sMapStore.LookupEntry(id)),
-      i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
+      i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), m_respawnSaveTimer(0),
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
-      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      m_pendingPathRequests(0), i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_spawnManager(*this),
 #ifdef ENABLE_PLAYERBOTS
-      m_activeZonesTimer(0), hasRealPlayers(false),
+      hasRealPlayers(false),
 #endif
       m_variableManager(this)
 {
@@ -695,7 +700,13 @@ void Map::Update(const uint32& t_diff)
 
     uint64 count = 0;
 
+    m_updateLod.Reset(WorldTimer::getMSTime());
+    if (m_updateLod.IsEnabled())
+        BuildUpdateLodAnchors();
+
     m_dyn_tree.update(t_diff);
+    m_losCache.SetOwnerThread(std::this_thread::get_id());
+    m_losCache.Clear();
 
     GetMessager().Execute(this);
     m_spawnManager.Update();
@@ -745,138 +756,34 @@ void Map::Update(const uint32& t_diff)
     }
 
 #ifdef ENABLE_PLAYERBOTS
-    // Calculate the active zones every 10 seconds (An active zone is a zone where one or more real players are)
-    constexpr uint32 maxActiveZonesTimer = 10000U;
-    if (m_activeZonesTimer < maxActiveZonesTimer)
-    {
-        m_activeZonesTimer += t_diff;
-    }
-    else
-    {
-        m_activeZonesTimer = 0U;
-        m_activeZones.clear();
-
-        // Recalculate active zones
-        if (IsContinent() && HasRealPlayers())
-        {
-            for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
-            {
-                Player* plr = m_mapRefIter->getSource();
-                if (plr && plr->IsInWorld())
-                {
-                    // Only consider real players
-                    if (plr->GetPlayerbotAI() && !plr->GetPlayerbotAI()->IsRealPlayer())
-                        continue;
-
-                    // Ignore afk players
-                    if (plr->isAFK())
-                        continue;
-
-                    // Ignore gm players
-                    if (!plr->isGMVisible())
-                        continue;
-
-                    // Register an active zone when a real player is on the zone
-                    if (find(m_activeZones.begin(), m_activeZones.end(), plr->GetZoneId()) == m_activeZones.end())
-                    {
-                        m_activeZones.push_back(plr->GetZoneId());
-                    }
-                }
-            }
-        }
-    }
-
     // Reset the has real players flag and check for it again
-    const bool hadRealPlayers = hasRealPlayers;
     hasRealPlayers = false;
-
-    uint32 activePlayers = 0;
-    uint32 avgDiff = sWorld.GetAverageDiff();
-
-    // Calculate the chance that the bots in this map should update based on server load and real players online
-    // (default is a 10% on a avg diff of 100)
-    float botUpdateChance = avgDiff * 0.1f;
-    if (!hadRealPlayers)
-    {
-        // If no real players are on the map then lower the chances of updating by 300%
-        botUpdateChance *= 3.0f;
-    }
-
-    bool shouldUpdateBots = urand(0, (uint32)(botUpdateChance * 100)) < 100;
 #endif
 
-    /// update players at tick
+    /// update players at tick, bots far from real players less often (see GetUpdateTier)
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* plr = m_mapRefIter->getSource();
         if (plr && plr->IsInWorld())
         {
 #ifdef ENABLE_PLAYERBOTS
-            // Determine if the individual bot should update
-            bool shouldUpdateBot = shouldUpdateBots;
-
-            // Real players should update always (it will update alt bots)
             if (!plr->GetPlayerbotAI() || plr->GetPlayerbotAI()->IsRealPlayer())
-            {
-                shouldUpdateBot = true;
                 hasRealPlayers = true;
-            }
-            else
-            {
-                // If there are real players in the map, check if the bot is on a zone with players
-                if (hadRealPlayers)
-                {
-                    // Check if the bot is in an active zone (or instance)
-                    shouldUpdateBot = IsContinent() ? HasActiveZone(plr->GetZoneId()) : true;
-                }
-
-                // Check for edge case reasons to force update the bot
-                if (!shouldUpdateBot)
-                {
-                    // Force bots to be active if:
-                    // - The bot is playing with a real player
-                    // - The bot is in a battleground
-                    // - The bot is in combat
-                    if ((plr->GetPlayerbotAI() && plr->GetPlayerbotAI()->HasRealPlayerMaster()) ||
-                        plr->InBattleGroundQueue() || plr->InBattleGround() ||
-                        plr->IsInCombat())
-                    {
-                        shouldUpdateBot = true;
-                    }
-                }
-            }
-
-            // Save the active characters for later logs
-            if (shouldUpdateBot)
-            {
-                activePlayers++;
-            }
 #endif
 
-            plr->Update(t_diff);
+            MapUpdateTier tier = GetUpdateTier(plr);
+            uint32 diff;
+            if (!m_updateLod.ShouldUpdate(*plr, tier, t_diff, diff))
+                continue;
+
+            plr->Update(diff);
 
 #ifdef ENABLE_PLAYERBOTS
-            if (sPlayerbotAIConfig.disableBotOptimizations)
-            {
-                plr->UpdateAI(t_diff, false);
-            }
-            else
-            {
-                plr->UpdateAI(t_diff, !shouldUpdateBot);
-            }
+            plr->UpdateAI(diff, tier != MAP_UPDATE_TIER_FULL);
 #endif
         }
     }
 
-#ifdef ENABLE_PLAYERBOTS
-    // Log the active zones and characters
-    if (IsContinent() && HasRealPlayers() && HasActiveZones() && m_activeZonesTimer == 0U)
-    {
-        sLog.outBasic("Map %u: Active Zones - %u", GetId(), m_activeZones.size());
-        sLog.outBasic("Map %u: Active Zone Players - %u of %u", GetId(), activePlayers, m_mapRefManager.getSize());
-    }
-#endif
-
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* player = m_mapRefIter->getSource();
@@ -912,19 +819,6 @@ void Map::Update(const uint32& t_diff)
             VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
     }
 
-#ifdef ENABLE_PLAYERBOTS
-    // Calculate the chance that the objects (non players) should update based on server load and real players online
-    // (default is a 10% on a avg diff of 100)
-    float objectUpdateChance = avgDiff * 0.1f;
-    if (!HasRealPlayers())
-    {
-        // If no real players are on the map then lower the chances of updating by 300%
-        objectUpdateChance *= 3.0f;
-    }
-
-    const bool shouldUpdateObjects = urand(0, (uint32)(objectUpdateChance * 100)) < 100;
-#endif
-
     // non-player active objects
     if (!m_activeNonPlayers.empty())
     {
@@ -940,18 +834,6 @@ void Map::Update(const uint32& t_diff)
             if (!obj->IsInWorld() || !obj->IsPositionValid())
                 continue;
 
-#ifdef ENABLE_PLAYERBOTS
-            // Skip objects on locations away from real players if world is laggy
-            if (!sPlayerbotAIConfig.disableBotOptimizations && IsContinent() && avgDiff > 100)
-            {
-                const bool isInActiveZone = IsContinent() ? HasActiveZone(obj->GetZoneId()) : HasRealPlayers();
-                if (!isInActiveZone && !shouldUpdateObjects)
-                {
-                    continue;
-                }
-            }
-#endif
-
             objToUpdate.insert(obj);
 
             // lets update mobs/objects in ALL visible cells around player!
@@ -978,10 +860,14 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
-    // update all objects
+    // update all objects, those far from real players less often
     for (auto wObj : objToUpdate)
     {
-        wObj->Update(t_diff);
+        uint32 diff;
+        if (!m_updateLod.ShouldUpdate(*wObj, GetUpdateTier(wObj), t_diff, diff))
+            continue;
+
+        wObj->Update(diff);
         ++count;
     }
 
@@ -989,6 +875,9 @@ void Map::Update(const uint32& t_diff)
     meas.add_field("count", std::to_string(static_cast<int32>(count)));
 #endif
 
+    // relocation AI notifies fired by the updates above
+    ProcessAINotifies();
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -1014,6 +903,64 @@ void Map::Update(const uint32& t_diff)
         i_data->Update(t_diff);
 
     m_weatherSystem->UpdateWeathers(t_diff);
+
+    // respawn times are journaled and written in batches
+    m_respawnSaveTimer += t_diff;
+    if (m_respawnSaveTimer >= sWorld.getConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_INTERVAL))
+    {
+        m_respawnSaveTimer = 0;
+        m_persistentState->SaveRespawnTimes();
+    }
+}
+
+bool Map::IsUpdateLodAnchor(Player* player)
+{
+#ifdef ENABLE_PLAYERBOTS
+    return player->isRealPlayer();
+#elif defined(BUILD_DEPRECATED_PLAYERBOT)
+    return !player->GetPlayerbotAI();
+#else
+    return true;
+#endif
+}
+
+void Map::BuildUpdateLodAnchors()
+{
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->getSource();
+        if (!player || !player->IsInWorld() || !IsUpdateLodAnchor(player))
+            continue;
+
+        m_updateLod.AddAnchor(player->GetPositionX(), player->GetPositionY());
+        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+            m_updateLod.AddAnchor(viewPoint->GetPositionX(), viewPoint->GetPositionY());
+    }
+}
+
+MapUpdateTier Map::GetUpdateTier(WorldObject* obj) const
+{
+    if (!m_updateLod.IsEnabled())
+        return MAP_UPDATE_TIER_FULL;
+
+    // combat timers (swings, casts, threat) must not be batched
+    if (obj->IsUnit() && static_cast<Unit const*>(obj)->IsInCombat())
+        return MAP_UPDATE_TIER_FULL;
+
+    if (obj->IsPlayer())
+    {
+        Player* player = static_cast<Player*>(obj);
+        if (IsUpdateLodAnchor(player) || player->InBattleGround() || player->InBattleGroundQueue())
+            return MAP_UPDATE_TIER_FULL;
+
+#ifdef ENABLE_PLAYERBOTS
+        // playing with a real player
+        if (sPlayerbotAIConfig.disableBotOptimizations || (player->GetPlayerbotAI() && player->GetPlayerbotAI()->HasRealPlayerMaster()))
+            return MAP_UPDATE_TIER_FULL;
+#endif
+    }
+
+    return m_updateLod.GetTier(obj->GetPositionX(), obj->GetPositionY());
 }
 
 void Map::Remove(Player* player, bool remove)
@@ -2388,6 +2335,135 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
     return nullptr;
 }
 
+void Map::QueueAINotify(Unit* unit)
+{
+    m_aiNotifyQueue.push_back(unit->GetObjectGuid());
+}
+
+// Evaluates the relocation AI notifies queued during this tick. The relocated units are sorted by cell, the cells in range
+// of the units sharing a cell are visited once for all of them, and a pair of units is notified once even if both moved.
+void Map::ProcessAINotifies()
+{
+    if (m_aiNotifyQueue.empty())
+        return;
+
+    struct RelocatedUnit
+    {
+        Unit* unit;
+        uint32 cellId;
+        CellArea area;
+    };
+
+    std::vector<RelocatedUnit> relocated;
+    relocated.reserve(m_aiNotifyQueue.size());
+
+    float const aggroRate = sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+    for (ObjectGuid const& guid : m_aiNotifyQueue)
+    {
+        Unit* unit = GetUnit(guid);
+        if (!unit || !unit->IsInWorld())
+            continue;
+
+        // since visitor was called we override can aggro with true if creature is alive
+        if (unit->GetTypeId() == TYPEID_UNIT)
+            static_cast<Creature*>(unit)->SetCanAggro(unit->IsAlive());
+
+        if (!unit->IsAlive() || (unit->GetTypeId() == TYPEID_PLAYER && unit->IsTaxiFlying()))
+            continue;
+
+        CellPair cell = MaNGOS::ComputeCellPair(unit->GetPositionX(), unit->GetPositionY());
+        if (cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+            continue;
+
+        float radius = std::max(unit->GetDetectionRange(), uint32(MAX_CREATURE_ATTACK_RADIUS)) * aggroRate;
+        radius = std::min(radius + unit->GetObjectBoundingRadius(), MAX_VISIBILITY_DISTANCE);
+
+        relocated.push_back({ unit, cell.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + cell.x_coord,
+                              Cell::CalculateCellArea(unit->GetPositionX(), unit->GetPositionY(), radius) });
+    }
+    m_aiNotifyQueue.clear();
+
+    std::sort(relocated.begin(), relocated.end(), [](RelocatedUnit const& left, RelocatedUnit const& right)
+    {
+        if (left.cellId != right.cellId)
+            return left.cellId < right.cellId;
+        return left.unit->GetObjectGuid() < right.unit->GetObjectGuid();
+    });
+    relocated.erase(std::unique(relocated.begin(), relocated.end(), [](RelocatedUnit const& left, RelocatedUnit const& right)
+    {
+        return left.unit == right.unit;
+    }), relocated.end());
+
+    std::unordered_map<Unit*, uint32> relocatedIndex;
+    for (uint32 i = 0; i < relocated.size(); ++i)
+        relocatedIndex.emplace(relocated[i].unit, i);
+
+    std::vector<std::pair<Unit*, CellPair>> neighbours;
+    MaNGOS::AINotifyUnitCollector collector(neighbours);
+    TypeContainerVisitor<MaNGOS::AINotifyUnitCollector, GridTypeMapContainer> gridVisitor(collector);
+    TypeContainerVisitor<MaNGOS::AINotifyUnitCollector, WorldTypeMapContainer> worldVisitor(collector);
+
+    std::unordered_set<uint64> notifiedPairs;
+    std::vector<std::pair<Unit*, Unit*>> pairs;
+
+    for (uint32 first = 0; first < relocated.size();)
+    {
+        // units standing in the same cell share one visit of the union of their ranges
+        CellArea area = relocated[first].area;
+        uint32 last = first + 1;
+        for (; last < relocated.size() && relocated[last].cellId == relocated[first].cellId; ++last)
+        {
+            CellArea const& range = relocated[last].area;
+            area.low_bound.x_coord = std::min(area.low_bound.x_coord, range.low_bound.x_coord);
+            area.low_bound.y_coord = std::min(area.low_bound.y_coord, range.low_bound.y_coord);
+            area.high_bound.x_coord = std::max(area.high_bound.x_coord, range.high_bound.x_coord);
+            area.high_bound.y_coord = std::max(area.high_bound.y_coord, range.high_bound.y_coord);
+        }
+
+        neighbours.clear();
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                Cell cell(CellPair(x, y));
+                cell.SetNoCreate();
+                Visit(cell, gridVisitor);
+                Visit(cell, worldVisitor);
+            }
+        }
+
+        for (uint32 i = first; i < last; ++i)
+        {
+            RelocatedUnit const& moved = relocated[i];
+            for (auto const& neighbour : neighbours)
+            {
+                Unit* other = neighbour.first;
+                CellPair const& cell = neighbour.second;
+                if (other == moved.unit ||
+                    cell.x_coord < moved.area.low_bound.x_coord || cell.x_coord > moved.area.high_bound.x_coord ||
+                    cell.y_coord < moved.area.low_bound.y_coord || cell.y_coord > moved.area.high_bound.y_coord)
+                    continue;
+
+                // when both units moved the pair is notified by whichever of them finds the other first
+                auto itr = relocatedIndex.find(other);
+                if (itr != relocatedIndex.end())
+                {
+                    uint64 key = (uint64(std::min(i, itr->second)) << 32) | std::max(i, itr->second);
+                    if (!notifiedPairs.insert(key).second)
+                        continue;
+                }
+
+                pairs.emplace_back(moved.unit, other);
+            }
+        }
+
+        first = last;
+    }
+
+    for (auto const& pair : pairs)
+        UnitRelocationAINotifyWorker(pair.first, pair.second);
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
@@ -2653,8 +2729,63 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, bool ignoreM2Model) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model);
+    bool useCache = IsLineOfSightCacheEnabled();
+    bool result;
+    if (useCache && m_losCache.Find(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model, result))
+        return result;
+
+    result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
+             && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model);
+
+    if (useCache)
+        m_losCache.Insert(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model, result);
+
+    return result;
+}
+
+/**
+ * Batched line of sight check, used for area target selection
+ * Cached pairs are answered directly, the rest share one static tree lookup and source conversion
+ */
+void Map::IsInLineOfSight(float srcX, float srcY, float srcZ, Position const* dests, bool* results, uint32 count, bool ignoreM2Model) const
+{
+    bool useCache = IsLineOfSightCacheEnabled();
+
+    std::vector<G3D::Vector3> points;
+    std::vector<uint32> indexes;
+    points.reserve(count);
+    indexes.reserve(count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (useCache && m_losCache.Find(srcX, srcY, srcZ, dests[i].x, dests[i].y, dests[i].z, ignoreM2Model, results[i]))
+            continue;
+
+        points.emplace_back(dests[i].x, dests[i].y, dests[i].z);
+        indexes.push_back(i);
+    }
+
+    if (points.empty())
+        return;
+
+    std::unique_ptr<bool[]> pending(new bool[points.size()]);
+    std::fill_n(pending.get(), points.size(), true);
+
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, points.data(), pending.get(), points.size(), ignoreM2Model);
+    m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, points.data(), pending.get(), points.size(), ignoreM2Model);
+
+    for (uint32 i = 0; i < points.size(); ++i)
+    {
+        uint32 index = indexes[i];
+        results[index] = pending[i];
+        if (useCache)
+            m_losCache.Insert(srcX, srcY, srcZ, dests[index].x, dests[index].y, dests[index].z, ignoreM2Model, pending[i]);
+    }
+}
+
+bool Map::IsLineOfSightCacheEnabled() const
+{
+    return sWorld.getConfig(CONFIG_BOOL_VMAP_LOS_CACHE);
 }
 
 /**
@@ -2753,11 +2884,13 @@ float Map::GetHeight(float x, float y, float z, bool swim) const
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
+    m_losCache.Clear();
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.remove(mdl);
+    m_losCache.Clear();
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
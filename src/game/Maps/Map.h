@@ -38,6 +38,8 @@
 #include "Globals/GraveyardManager.h"
 #include "Maps/SpawnManager.h"
 #include "Maps/MapDataContainer.h"
+#include "Maps/LineOfSightCache.h"
+#include "Maps/MapUpdateLod.h"
 #include "Util/UniqueTrackablePtr.h"
 #include "World/WorldStateVariableManager.h"
 
@@ -312,6 +314,10 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(float x, float y, float z, bool swim = false) const;
         bool GetHeightInRange(float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) const;
+        // one source against count destinations, results[i] receives line of sight to dests[i]
+        void IsInLineOfSight(float srcX, float srcY, float srcZ, Position const* dests, bool* results, uint32 count, bool ignoreM2Model) const;
+        bool IsLineOfSightCacheEnabled() const;
+        void InvalidateLineOfSightCache() const { m_losCache.Clear(); }
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -357,6 +363,14 @@ class Map : public GridRefManager<NGridType>
 
         Messager<Map>& GetMessager() { return m_messager; }
 
+        // path requests running on pathfinder threads reference the map until their result is posted to the messager
+        void AddPendingPathRequest() { ++m_pendingPathRequests; }
+        void RemovePendingPathRequest() { --m_pendingPathRequests; }
+        bool HasPendingPathRequests() const { return m_pendingPathRequests != 0; }
+
+        // relocation AI notifies are gathered over the tick and evaluated pairwise in ProcessAINotifies
+        void QueueAINotify(Unit* unit);
+
         typedef std::set<Transport*> TransportSet;
         GenericTransport* GetTransport(ObjectGuid guid);
         TransportSet const& GetTransports() { return m_transports; }
@@ -380,10 +394,11 @@ class Map : public GridRefManager<NGridType>
         // debug
         std::set<ObjectGuid> m_objRemoveList; // this will eventually eat up too much memory - only used for debugging VisibleNotifier::Notify() customlog leak
 
+        MapUpdateLod const& GetUpdateLod() const { return m_updateLod; }
+        MapUpdateTier GetUpdateTier(WorldObject* obj) const;
+
 #ifdef ENABLE_PLAYERBOTS
         bool HasRealPlayers() { return hasRealPlayers; }
-        bool HasActiveZones() { return !m_activeZones.empty(); }
-        bool HasActiveZone(uint32 zoneId) { return find(m_activeZones.begin(), m_activeZones.end(), zoneId) != m_activeZones.end(); }
 #endif
 
     private:
@@ -422,12 +437,16 @@ class Map : public GridRefManager<NGridType>
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
 
+        void ProcessAINotifies();
+        GuidVector m_aiNotifyQueue;
+
     protected:
         MapEntry const* i_mapEntry;
         uint32 i_id;
         uint32 i_InstanceId;
         MaNGOS::unique_weak_ptr<Map> m_weakRef;
         uint32 m_unloadTimer;
+        uint32 m_respawnSaveTimer;
         float m_VisibleDistance;
         MapPersistentState* m_persistentState;
 
@@ -446,6 +465,7 @@ class Map : public GridRefManager<NGridType>
         WorldObjectSet::iterator m_onEventNotifiedIter;
 
         Messager<Map> m_messager;
+        std::atomic<uint32> m_pendingPathRequests;
 
         GraveyardManager m_graveyardManager;
     private:
@@ -488,6 +508,9 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        // line of sight results of current update, other threads bypass it
+        mutable LineOfSightCache m_losCache;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
@@ -500,6 +523,11 @@ class Map : public GridRefManager<NGridType>
         // spawning
         SpawnManager m_spawnManager;
 
+        // distance based update rate of objects, anchors are rebuilt every update
+        MapUpdateLod m_updateLod;
+        static bool IsUpdateLodAnchor(Player* player);
+        void BuildUpdateLodAnchors();
+
         struct StringIdMapStorage
         {
             std::vector<WorldObject*> worldObjects;
@@ -515,8 +543,6 @@ class Map : public GridRefManager<NGridType>
         WorldStateVariableManager m_variableManager;
 
 #ifdef ENABLE_PLAYERBOTS
-        std::vector<uint32> m_activeZones;
-        uint32 m_activeZonesTimer;
         bool hasRealPlayers;
 #endif
 };
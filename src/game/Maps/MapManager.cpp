@@ -29,6 +29,7 @@
 #include "Maps/MapWorkers.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include <future>
+#include <thread>
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
@@ -56,6 +57,10 @@ void MapManager::Initialize()
     int num_threads(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS));
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    uint32 pathThreads = sWorld.getConfig(CONFIG_UINT32_NUM_PATHFINDER_THREADS);
+    if (pathThreads > 0)
+        m_pathUpdater.activate(pathThreads);
 }
 
 void MapManager::InitStateMachine()
@@ -176,18 +181,23 @@ Map* MapManager::FindMap(uint32 mapid, uint32 instanceId) const
 
 void MapManager::DeleteInstance(uint32 mapid, uint32 instanceId)
 {
-    Guard _guard(*this);
-
-    MapMapType::iterator iter = i_maps.find(MapID(mapid, instanceId));
-    if (iter != i_maps.end())
+    MapMapType::node_type node;
     {
-        if (iter->second->Instanceable())
-        {
-            auto node = i_maps.extract(iter);
+        Guard _guard(*this);
 
-            node.mapped()->UnloadAll(true);
-        }
+        MapMapType::iterator iter = i_maps.find(MapID(mapid, instanceId));
+        if (iter == i_maps.end() || !iter->second->Instanceable())
+            return;
+
+        // no longer reachable through the manager, no new path requests can be made for it
+        node = i_maps.extract(iter);
     }
+
+    // pending path requests of this map still reference it - they are short, waited for without blocking other maps
+    while (node.mapped()->HasPendingPathRequests())
+        std::this_thread::yield();
+
+    node.mapped()->UnloadAll(true);
 }
 
 void MapManager::Update(uint32 diff)
@@ -211,8 +221,8 @@ void MapManager::Update(uint32 diff)
     MapMapType::iterator iter = i_maps.begin();
     while (iter != i_maps.end())
     {
-        // check if map can be unloaded
-        if (iter->second->CanUnload((uint32)i_timer.GetCurrent()))
+        // check if map can be unloaded, maps with path requests in flight are retried next tick
+        if (!iter->second->HasPendingPathRequests() && iter->second->CanUnload((uint32)i_timer.GetCurrent()))
         {
             auto node = i_maps.extract(iter++);
 
@@ -248,8 +258,17 @@ bool MapManager::IsValidMAP(uint32 mapid)
     // TODO: add check for battleground template
 }
 
+void MapManager::SchedulePathRequest(Map& map, std::shared_ptr<PathFinder> path, std::shared_ptr<AsyncPathRequest> const& request)
+{
+    map.AddPendingPathRequest();
+    m_pathUpdater.schedule_update(new PathFinderWorker(map, std::move(path), request, m_pathUpdater));
+}
+
 void MapManager::UnloadAll()
 {
+    if (m_pathUpdater.activated())
+        m_pathUpdater.join();
+
     for (auto& i_map : i_maps)
         i_map.second->UnloadAll(true);
 
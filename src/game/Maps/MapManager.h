@@ -31,6 +31,8 @@
 class Transport;
 class BattleGround;
 struct TransportTemplate;
+class PathFinder;
+struct AsyncPathRequest;
 
 struct MapID
 {
@@ -94,6 +96,10 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         void UnloadAll();
 
+        // navmesh search of prepared path is done on pathfinder threads, result is delivered through map messager
+        bool IsAsyncPathfindingEnabled() { return m_pathUpdater.activated(); }
+        void SchedulePathRequest(Map& map, std::shared_ptr<PathFinder> path, std::shared_ptr<AsyncPathRequest> const& request);
+
         static bool ExistMapAndVMap(uint32 mapid, float x, float y);
         static bool IsValidMAP(uint32 mapid);
 
@@ -189,6 +195,7 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         std::atomic<uint32> i_MaxInstanceId;
         MapUpdater m_updater;
+        MapUpdater m_pathUpdater;
 };
 
 template<typename Do>
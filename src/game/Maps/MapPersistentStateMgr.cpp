@@ -23,6 +23,7 @@
 #include "Log/Log.h"
 #include "Grids/CellImpl.h"
 #include "Maps/Map.h"
+#include "Entities/CharacterPrefetch.h"
 #include "Maps/MapManager.h"
 #include "Util/Timer.h"
 #include "Grids/GridNotifiersImpl.h"
@@ -72,52 +73,132 @@ bool MapPersistentState::UnloadIfEmpty()
 
 void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 {
+    JournalRespawnTime(TYPEID_UNIT, loguid, t);             // before set, state can be unloaded at erase
     SetCreatureRespawnTime(loguid, t);
+}
 
+void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+{
+    JournalRespawnTime(TYPEID_GAMEOBJECT, loguid, t);       // before set, state can be unloaded at erase
+    SetGORespawnTime(loguid, t);
+}
+
+void MapPersistentState::JournalRespawnTime(uint32 typeId, uint32 loguid, time_t t)
+{
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
     if (GetMapEntry()->IsBattleGround())
         return;
 
-    CharacterDatabase.BeginTransaction();
+    // repeated kills/uses of the same guid between saves collapse into one row
+    RespawnTimes& pending = typeId == TYPEID_UNIT ? m_pendingCreatureRespawnTimes : m_pendingGORespawnTimes;
+    pending[loguid] = t;
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+    if (!sWorld.getConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_INTERVAL))
+        SaveRespawnTimes();
+}
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM creature_respawn WHERE guid = ? AND instance = ?");
-    stmt.PExecute(loguid, m_instanceid);
+// rows per multi-row statement, the remainder of a save is written with the single row statements
+static uint32 const RESPAWN_SAVE_BATCH_SIZE = 64;
 
-    if (t > sWorld.GetGameTime())
+struct RespawnSaveStatements
+{
+    explicit RespawnSaveStatements(char const* table)
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO creature_respawn VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
+        delOneSql = std::string("DELETE FROM ") + table + " WHERE instance = ? AND guid = ?";
+        insOneSql = std::string("INSERT INTO ") + table + " VALUES ( ?, ?, ? )";
+
+        delBatchSql = std::string("DELETE FROM ") + table + " WHERE instance = ? AND guid IN (?";
+        insBatchSql = insOneSql;
+        for (uint32 i = 1; i < RESPAWN_SAVE_BATCH_SIZE; ++i)
+        {
+            delBatchSql += ", ?";
+            insBatchSql += ", ( ?, ?, ? )";
+        }
+        delBatchSql += ")";
     }
 
-    CharacterDatabase.CommitTransaction();
-}
+    std::string delOneSql;
+    std::string insOneSql;
+    std::string delBatchSql;
+    std::string insBatchSql;
+    SqlStatementID delOne;
+    SqlStatementID insOne;
+    SqlStatementID delBatch;
+    SqlStatementID insBatch;
+};
 
-void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+static void SaveRespawnTimesToTable(RespawnSaveStatements& statements, uint32 instanceId, std::unordered_map<uint32, time_t> const& pending)
 {
-    SetGORespawnTime(loguid, t);
-
-    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGround())
-        return;
-
-    CharacterDatabase.BeginTransaction();
+    time_t const now = sWorld.GetGameTime();
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+    std::vector<uint32> guids;
+    std::vector<std::pair<uint32, uint64>> rows;            // guid, respawn time
+    guids.reserve(pending.size());
+    rows.reserve(pending.size());
+    for (auto const& itr : pending)
+    {
+        guids.push_back(itr.first);
+        if (itr.second > now)
+            rows.emplace_back(itr.first, uint64(itr.second));
+    }
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM gameobject_respawn WHERE guid = ? AND instance = ?");
-    stmt.PExecute(loguid, m_instanceid);
+    size_t index = 0;
+    if (guids.size() >= RESPAWN_SAVE_BATCH_SIZE)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(statements.delBatch, statements.delBatchSql.c_str());
+        for (; index + RESPAWN_SAVE_BATCH_SIZE <= guids.size(); index += RESPAWN_SAVE_BATCH_SIZE)
+        {
+            stmt.addUInt32(instanceId);
+            for (uint32 i = 0; i < RESPAWN_SAVE_BATCH_SIZE; ++i)
+                stmt.addUInt32(guids[index + i]);
+            stmt.Execute();
+        }
+    }
+    if (index < guids.size())
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(statements.delOne, statements.delOneSql.c_str());
+        for (; index < guids.size(); ++index)
+            stmt.PExecute(instanceId, guids[index]);
+    }
 
-    if (t > sWorld.GetGameTime())
+    index = 0;
+    if (rows.size() >= RESPAWN_SAVE_BATCH_SIZE)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(statements.insBatch, statements.insBatchSql.c_str());
+        for (; index + RESPAWN_SAVE_BATCH_SIZE <= rows.size(); index += RESPAWN_SAVE_BATCH_SIZE)
+        {
+            for (uint32 i = 0; i < RESPAWN_SAVE_BATCH_SIZE; ++i)
+            {
+                stmt.addUInt32(rows[index + i].first);
+                stmt.addUInt64(rows[index + i].second);
+                stmt.addUInt32(instanceId);
+            }
+            stmt.Execute();
+        }
+    }
+    if (index < rows.size())
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO gameobject_respawn VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
+        SqlStatement stmt = CharacterDatabase.CreateStatement(statements.insOne, statements.insOneSql.c_str());
+        for (; index < rows.size(); ++index)
+            stmt.PExecute(rows[index].first, rows[index].second, instanceId);
     }
+}
 
+void MapPersistentState::SaveRespawnTimes()
+{
+    if (m_pendingCreatureRespawnTimes.empty() && m_pendingGORespawnTimes.empty())
+        return;
+
+    static RespawnSaveStatements creatureStatements("creature_respawn");
+    static RespawnSaveStatements goStatements("gameobject_respawn");
+
+    CharacterDatabase.BeginTransaction();
+    SaveRespawnTimesToTable(creatureStatements, m_instanceid, m_pendingCreatureRespawnTimes);
+    SaveRespawnTimesToTable(goStatements, m_instanceid, m_pendingGORespawnTimes);
     CharacterDatabase.CommitTransaction();
+
+    m_pendingCreatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();
 }
 
 time_t MapPersistentState::GetObjectRespawnTime(uint32 typeId, uint32 loguid) const
@@ -159,6 +240,8 @@ void MapPersistentState::ClearRespawnTimes()
 {
     m_goRespawnTimes.clear();
     m_creatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();                        // callers delete the db rows themselves
+    m_pendingCreatureRespawnTimes.clear();
 
     UnloadIfEmpty();
 }
@@ -702,6 +785,9 @@ void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
         CharacterDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", instanceid);
         CharacterDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", instanceid);
         CharacterDatabase.CommitTransaction();
+
+        // preloaded characters may hold binds to it
+        sCharacterPrefetch.InvalidateAll();
     }
 }
 
@@ -720,6 +806,7 @@ void MapPersistentStateManager::RemovePersistentState(uint32 mapId, uint32 insta
                 if (time_t resettime = ((DungeonPersistentState*)itr->second)->GetResetTimeForDB())
                     CharacterDatabase.PExecute("UPDATE instance SET resettime = '" UI64FMTD "' WHERE id = '%u'", (uint64)resettime, instanceId);
 
+            itr->second->SaveRespawnTimes();
             _ResetSave(m_instanceSaveByInstanceId, itr);
         }
     }
@@ -727,10 +814,21 @@ void MapPersistentStateManager::RemovePersistentState(uint32 mapId, uint32 insta
     {
         PersistentStateMap::iterator itr = m_instanceSaveByMapId.find(mapId);
         if (itr != m_instanceSaveByMapId.end())
+        {
+            itr->second->SaveRespawnTimes();
             _ResetSave(m_instanceSaveByMapId, itr);
+        }
     }
 }
 
+void MapPersistentStateManager::SaveAllRespawnTimes()
+{
+    for (auto& itr : m_instanceSaveByInstanceId)
+        itr.second->SaveRespawnTimes();
+    for (auto& itr : m_instanceSaveByMapId)
+        itr.second->SaveRespawnTimes();
+}
+
 void MapPersistentStateManager::_DelHelper(DatabaseType& db, const char* fields, const char* table, const char* queryTail, ...) const
 {
     Tokens fieldTokens = StrSplit(fields, ", ");
@@ -941,6 +1039,7 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, bool warn, uint32
         CharacterDatabase.PExecute("DELETE FROM group_instance USING group_instance LEFT JOIN instance ON group_instance.instance = id WHERE map = '%u'", mapid);
         CharacterDatabase.PExecute("DELETE FROM instance WHERE map = '%u'", mapid);
         CharacterDatabase.CommitTransaction();
+        sCharacterPrefetch.InvalidateAll();
 
         // calculate the next reset time
         time_t next_reset = DungeonResetScheduler::CalculateNextResetTime(temp, now + timeLeft);
@@ -95,6 +95,7 @@ class MapPersistentState
         void SaveGORespawnTime(uint32 loguid, time_t t);
         time_t GetObjectRespawnTime(uint32 typeId, uint32 loguid) const;
         void SaveObjectRespawnTime(uint32 typeId, uint32 loguid, time_t t);
+        void SaveRespawnTimes();                            // write journaled respawn times to db in one transaction
 
         // pool system
         void InitPools();
@@ -121,6 +122,7 @@ class MapPersistentState
     private:
         void SetCreatureRespawnTime(uint32 loguid, time_t t);
         void SetGORespawnTime(uint32 loguid, time_t t);
+        void JournalRespawnTime(uint32 typeId, uint32 loguid, time_t t);
 
     private:
         typedef std::unordered_map<uint32, time_t> RespawnTimes;
@@ -132,6 +134,8 @@ class MapPersistentState
         // persistent data
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
+        RespawnTimes m_pendingCreatureRespawnTimes;         // not yet saved to db, latest time per guid, 0 deletes
+        RespawnTimes m_pendingGORespawnTimes;               // not yet saved to db, latest time per guid, 0 deletes
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
 
         SpawnedPoolData m_spawnedPoolData;                  // Pools spawns state for map copy
@@ -349,6 +353,8 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
 
         void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups);
 
+        void SaveAllRespawnTimes();
+
         void Update() { m_Scheduler.Update(); }
     private:
         typedef std::unordered_map < uint32 /*InstanceId or MapId*/, MapPersistentState* > PersistentStateMap;
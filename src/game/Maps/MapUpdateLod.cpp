@@ -0,0 +1,118 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapUpdateLod.h"
+#include "Entities/Object.h"
+#include "World/World.h"
+#include "Util/Timer.h"
+
+#include <cmath>
+
+MapUpdateLod::MapUpdateLod() : m_enabled(false), m_fullRange(0.f), m_coarseRange(1.f), m_budget(0), m_tickStartMS(0)
+{
+    for (uint32 i = 0; i < MAX_MAP_UPDATE_TIER; ++i)
+    {
+        m_intervals[i] = 0;
+        m_updated[i] = 0;
+        m_deferred[i] = 0;
+    }
+}
+
+void MapUpdateLod::Reset(uint32 tickStartMS)
+{
+    m_enabled = sWorld.getConfig(CONFIG_BOOL_MAP_UPDATE_LOD);
+    m_fullRange = sWorld.getConfig(CONFIG_FLOAT_MAP_UPDATE_LOD_FULL_RANGE);
+    m_coarseRange = std::max(m_fullRange, sWorld.getConfig(CONFIG_FLOAT_MAP_UPDATE_LOD_COARSE_RANGE));
+    m_intervals[MAP_UPDATE_TIER_FULL] = 0;
+    m_intervals[MAP_UPDATE_TIER_COARSE] = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_LOD_COARSE_INTERVAL);
+    m_intervals[MAP_UPDATE_TIER_FAR] = std::max(m_intervals[MAP_UPDATE_TIER_COARSE], sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_LOD_FAR_INTERVAL));
+    m_budget = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_LOD_BUDGET);
+    m_tickStartMS = tickStartMS;
+
+    m_anchors.clear();
+    for (uint32 i = 0; i < MAX_MAP_UPDATE_TIER; ++i)
+    {
+        m_updated[i] = 0;
+        m_deferred[i] = 0;
+    }
+}
+
+void MapUpdateLod::AddAnchor(float x, float y)
+{
+    int32 bucketX = int32(std::floor(x / m_coarseRange));
+    int32 bucketY = int32(std::floor(y / m_coarseRange));
+    m_anchors[GetBucketKey(bucketX, bucketY)].emplace_back(x, y);
+}
+
+MapUpdateTier MapUpdateLod::GetTier(float x, float y) const
+{
+    if (!m_enabled)
+        return MAP_UPDATE_TIER_FULL;
+
+    int32 bucketX = int32(std::floor(x / m_coarseRange));
+    int32 bucketY = int32(std::floor(y / m_coarseRange));
+
+    float minDistSq = m_coarseRange * m_coarseRange;
+    bool inCoarseRange = false;
+    for (int32 i = bucketX - 1; i <= bucketX + 1; ++i)
+    {
+        for (int32 j = bucketY - 1; j <= bucketY + 1; ++j)
+        {
+            AnchorBuckets::const_iterator itr = m_anchors.find(GetBucketKey(i, j));
+            if (itr == m_anchors.end())
+                continue;
+
+            for (AnchorPosition const& anchor : itr->second)
+            {
+                float dx = anchor.first - x;
+                float dy = anchor.second - y;
+                float distSq = dx * dx + dy * dy;
+                if (distSq <= minDistSq)
+                {
+                    minDistSq = distSq;
+                    inCoarseRange = true;
+                }
+            }
+        }
+    }
+
+    if (!inCoarseRange)
+        return MAP_UPDATE_TIER_FAR;
+
+    return minDistSq <= m_fullRange * m_fullRange ? MAP_UPDATE_TIER_FULL : MAP_UPDATE_TIER_COARSE;
+}
+
+bool MapUpdateLod::ShouldUpdate(WorldObject& obj, MapUpdateTier tier, uint32 t_diff, uint32& diff)
+{
+    diff = obj.GetDeferredUpdateDiff() + t_diff;
+    if (tier != MAP_UPDATE_TIER_FULL && (diff < m_intervals[tier] || IsOverBudget()))
+    {
+        obj.SetDeferredUpdateDiff(diff);
+        ++m_deferred[tier];
+        return false;
+    }
+
+    obj.SetDeferredUpdateDiff(0);
+    ++m_updated[tier];
+    return true;
+}
+
+bool MapUpdateLod::IsOverBudget() const
+{
+    return m_budget && WorldTimer::getMSTimeDiff(m_tickStartMS, WorldTimer::getMSTime()) >= m_budget;
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAP_UPDATE_LOD_H
+#define MANGOS_MAP_UPDATE_LOD_H
+
+#include "Common.h"
+
+#include <unordered_map>
+#include <vector>
+
+class WorldObject;
+
+enum MapUpdateTier
+{
+    MAP_UPDATE_TIER_FULL    = 0,                            // every map tick
+    MAP_UPDATE_TIER_COARSE  = 1,                            // every MapUpdate.LOD.CoarseInterval, with the skipped time
+    MAP_UPDATE_TIER_FAR     = 2,                            // every MapUpdate.LOD.FarInterval, with the skipped time
+    MAX_MAP_UPDATE_TIER
+};
+
+// Level of detail of map object updates, by distance to the nearest anchor (real player or its far sight target)
+// Objects in a coarse tier accumulate the skipped time and get it in one Update() call when due,
+// timers, regeneration and movement splines are diff based so they catch up on that call
+class MapUpdateLod
+{
+    public:
+        MapUpdateLod();
+
+        // called at the start of each map update, before AddAnchor
+        void Reset(uint32 tickStartMS);
+        void AddAnchor(float x, float y);
+
+        bool IsEnabled() const { return m_enabled; }
+        MapUpdateTier GetTier(float x, float y) const;
+
+        // Adds t_diff to the time not yet given to the object, returns true with the whole time in diff if it must be updated now
+        // Deferred tiers are not updated once the map tick took longer than the budget, full tier always is
+        bool ShouldUpdate(WorldObject& obj, MapUpdateTier tier, uint32 t_diff, uint32& diff);
+
+        uint32 GetUpdatedCount(MapUpdateTier tier) const { return m_updated[tier]; }
+        uint32 GetDeferredCount(MapUpdateTier tier) const { return m_deferred[tier]; }
+
+    private:
+        typedef std::pair<float, float> AnchorPosition;
+        typedef std::unordered_map<uint64, std::vector<AnchorPosition>> AnchorBuckets;
+
+        uint64 GetBucketKey(int32 x, int32 y) const { return (uint64(uint32(x)) << 32) | uint32(y); }
+        bool IsOverBudget() const;
+
+        bool m_enabled;
+        float m_fullRange;
+        float m_coarseRange;                                // also bucket size, so only neighbour buckets need a check
+        uint32 m_intervals[MAX_MAP_UPDATE_TIER];
+        uint32 m_budget;
+        uint32 m_tickStartMS;
+
+        AnchorBuckets m_anchors;
+
+        uint32 m_updated[MAX_MAP_UPDATE_TIER];
+        uint32 m_deferred[MAX_MAP_UPDATE_TIER];
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "MapUpdater.h"
 #include "MotionGenerators/MovementGenerator.h"
+#include "MotionGenerators/PathFinder.h"
 #include "Entities/Object.h"
 #include "Platform/Define.h"
 
@@ -108,4 +109,33 @@ class ObjectUpdateWorker : public Worker
         uint32 m_diff;
 };
 
+class PathFinderWorker : public Worker
+{
+    public:
+        PathFinderWorker(Map& map, std::shared_ptr<PathFinder> path, std::weak_ptr<AsyncPathRequest> request, MapUpdater& updater) :
+            Worker(updater), m_map(map), m_path(std::move(path)), m_request(std::move(request))
+        {}
+
+        void execute() override
+        {
+            m_path->CalculateAsync();
+
+            // hand result back to the map thread - requester may be gone by then
+            m_map.GetMessager().AddMessage([path = m_path, request = m_request](Map* /*map*/)
+            {
+                if (std::shared_ptr<AsyncPathRequest> pending = request.lock())
+                    pending->result = path;
+            });
+            // map may be unloaded from here on
+            m_map.RemovePendingPathRequest();
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        Map& m_map;
+        std::shared_ptr<PathFinder> m_path;
+        std::weak_ptr<AsyncPathRequest> m_request;
+};
+
 #endif //_MAP_WORKERS_H_INCLUDED
@@ -74,6 +74,7 @@ void SpawnGroup::AddObject(uint32 dbGuid, uint32 entry)
 void SpawnGroup::RemoveObject(WorldObject* wo)
 {
     m_objects.erase(wo->GetDbGuid());
+    MarkForSpawnCheck();
 
     if (!m_map.IsDungeon() && m_objects.empty())
     {
@@ -110,6 +111,17 @@ uint32 SpawnGroup::GetGuidEntry(uint32 dbGuid) const
 
 void SpawnGroup::Update()
 {
+    // worldstate conditions can change at any time, those groups are evaluated every update
+    if (!m_entry.WorldStateCondition && !m_entry.WorldStateExpression)
+    {
+        TimePoint now = m_map.GetCurrentClockTime();
+        if (m_nextSpawnCheck > now)
+            return;
+
+        // periodic recheck covers respawn times changed behind the group's back
+        m_nextSpawnCheck = now + std::chrono::seconds(10);
+    }
+
     Spawn(false);
 }
 
@@ -160,7 +172,10 @@ void SpawnGroup::Spawn(bool force)
         return;
 
     if (m_cooldown > m_map.GetCurrentClockTime())
+    {
+        m_nextSpawnCheck = std::min(m_nextSpawnCheck, m_cooldown);
         return;
+    }
 
     // duplicated code for optimization - way fewer cond fails
     if ((m_entry.Flags & SPAWN_GROUP_DESPAWN_ON_COND_FAIL) != 0) // must be before count check
@@ -281,10 +296,12 @@ void SpawnGroup::Spawn(bool force)
     time_t now = time(nullptr);
     for (auto itr = eligibleGuids.begin(); itr != eligibleGuids.end();)
     {
-        if (m_map.GetPersistentState()->GetObjectRespawnTime(GetObjectTypeId(), (*itr)->DbGuid) > now)
+        time_t respawnTime = m_map.GetPersistentState()->GetObjectRespawnTime(GetObjectTypeId(), (*itr)->DbGuid);
+        if (respawnTime > now)
         {
             if (!force)
             {
+                m_nextSpawnCheck = std::min(m_nextSpawnCheck, TimePoint(std::chrono::seconds(respawnTime)));
                 if (m_entry.MaxCount == 1) // rare mob case - prevent respawn until all are off CD
                     return;
                 itr = eligibleGuids.erase(itr);
@@ -459,6 +476,8 @@ void SpawnGroup::RespawnIfInVicinity(Position pos, float range)
 
     for (auto& dbGuid : m_entry.DbGuids)
         m_map.GetPersistentState()->SaveObjectRespawnTime(GetObjectTypeId(), dbGuid.DbGuid, now);
+
+    MarkForSpawnCheck();
 }
 
 bool SpawnGroup::IsRespawnOverriden() const
@@ -50,7 +50,8 @@ class SpawnGroup
         virtual void Despawn(uint32 timeMSToDespawn = 0, uint32 forcedDespawnTime = 0) = 0;
         std::string to_string() const;
         uint32 GetObjectTypeId() const { return m_objectTypeId; }
-        void SetEnabled(bool enabled) { m_enabled = enabled; }
+        void SetEnabled(bool enabled) { m_enabled = enabled; MarkForSpawnCheck(); }
+        void MarkForSpawnCheck() { m_nextSpawnCheck = TimePoint(); } // re-evaluate spawning on next update
         SpawnGroupEntry const& GetGroupEntry() const { return m_entry; }
         uint32 GetGroupId() const { return m_entry.Id; }
 
@@ -73,6 +74,7 @@ class SpawnGroup
         uint32 m_objectTypeId;
         bool m_enabled;
         TimePoint m_cooldown; // used for full wipe scenario only - data is still saved per spawn to db
+        TimePoint m_nextSpawnCheck; // earliest time Spawn can change anything, lowered by deaths and respawn timers
 };
 
 class CreatureGroup : public SpawnGroup
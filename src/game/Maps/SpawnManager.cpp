@@ -107,13 +107,37 @@ void SpawnManager::Initialize()
     }
 }
 
+void SpawnManager::AddSpawn(SpawnInfo const& spawnInfo)
+{
+    uint64 key = MakeKey(spawnInfo.GetDbGuid(), spawnInfo.GetHighGuid());
+    m_spawns.erase(key);
+    m_spawns.emplace(key, spawnInfo);
+    m_respawnQueue.push({ spawnInfo.GetRespawnTime(), key });
+}
+
+SpawnInfo* SpawnManager::FindUnusedSpawn(uint32 dbguid, HighGuid high)
+{
+    auto itr = m_spawns.find(MakeKey(dbguid, high));
+    if (itr == m_spawns.end() || itr->second.IsUsed())
+        return nullptr;
+    return &itr->second;
+}
+
+// spawn groups sleep until a member is removed or a timer expires, respawn requests change timers
+void SpawnManager::WakeSpawnGroup(uint32 dbguid, HighGuid high)
+{
+    if (SpawnGroupEntry* entry = m_map.GetMapDataContainer().GetSpawnGroupByGuid(dbguid, high == HIGHGUID_UNIT ? TYPEID_UNIT : TYPEID_GAMEOBJECT))
+        if (SpawnGroup* group = GetSpawnGroup(entry->Id))
+            group->MarkForSpawnCheck();
+}
+
 void SpawnManager::AddCreature(uint32 dbguid)
 {
     time_t respawnTime = m_map.GetPersistentState()->GetCreatureRespawnTime(dbguid);
     if (m_updated)
         m_deferredSpawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT);
     else
-        m_spawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT);
+        AddSpawn(SpawnInfo(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT));
 }
 
 void SpawnManager::AddGameObject(uint32 dbguid)
@@ -122,89 +146,60 @@ void SpawnManager::AddGameObject(uint32 dbguid)
     if (m_updated)
         m_deferredSpawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT);
     else
-        m_spawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT);
+        AddSpawn(SpawnInfo(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT));
 }
 
 void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
-    {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
-    }
-    if (!found)
-    {
-        m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
+    m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
+    WakeSpawnGroup(dbguid, HIGHGUID_UNIT);
+
+    SpawnInfo* spawnInfo = FindUnusedSpawn(dbguid, HIGHGUID_UNIT);
+    if (!spawnInfo)
         AddCreature(dbguid);
+    else if (respawnDelay > 0)
+    {
+        spawnInfo->SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
+        m_respawnQueue.push({ spawnInfo->GetRespawnTime(), MakeKey(dbguid, HIGHGUID_UNIT) });
     }
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+    else if (spawnInfo->ConstructForMap(m_map))
+        RemoveSpawn(dbguid, HIGHGUID_UNIT);
 }
 
 void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
-    {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
-    }
-    if (!found)
-    {
-        m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
+    m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
+    WakeSpawnGroup(dbguid, HIGHGUID_GAMEOBJECT);
+
+    SpawnInfo* spawnInfo = FindUnusedSpawn(dbguid, HIGHGUID_GAMEOBJECT);
+    if (!spawnInfo)
         AddGameObject(dbguid);
+    else if (respawnDelay > 0)
+    {
+        spawnInfo->SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
+        m_respawnQueue.push({ spawnInfo->GetRespawnTime(), MakeKey(dbguid, HIGHGUID_GAMEOBJECT) });
     }
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+    else if (spawnInfo->ConstructForMap(m_map))
+        RemoveSpawn(dbguid, HIGHGUID_GAMEOBJECT);
 }
 
 void SpawnManager::RemoveSpawns(std::vector<uint32> const& creatureDbGuids, std::vector<uint32> const& goDbGuids)
 {
-    for (auto& spawnInfo : m_spawns)
-    {
-        switch (spawnInfo.GetHighGuid())
-        {
-            case HIGHGUID_GAMEOBJECT:
-                if (std::find(goDbGuids.begin(), goDbGuids.end(), spawnInfo.GetDbGuid()) != goDbGuids.end())
-                    spawnInfo.SetUsed(); // will be erased on next manager update
-                break;
-            case HIGHGUID_UNIT:
-                if (std::find(creatureDbGuids.begin(), creatureDbGuids.end(), spawnInfo.GetDbGuid()) != creatureDbGuids.end())
-                    spawnInfo.SetUsed(); // will be erased on next manager update
-                break;
-            default: break;
-        }
-    }
+    for (uint32 dbguid : goDbGuids)
+        RemoveSpawn(dbguid, HIGHGUID_GAMEOBJECT);
+
+    for (uint32 dbguid : creatureDbGuids)
+        RemoveSpawn(dbguid, HIGHGUID_UNIT);
 }
 
 void SpawnManager::RemoveSpawn(uint32 dbguid, HighGuid high)
 {
-    for (auto& spawnInfo : m_spawns)
+    uint64 key = MakeKey(dbguid, high);
+    auto itr = m_spawns.find(key);
+    if (itr != m_spawns.end())
     {
-        if (spawnInfo.GetHighGuid() == high && spawnInfo.GetDbGuid() == dbguid)
-        {
-            spawnInfo.SetUsed(); // will be erased on next manager update
-            break;
-        }
+        itr->second.SetUsed(); // will be erased on next manager update
+        m_respawnQueue.push({ TimePoint(), key });
     }
 }
 
@@ -241,9 +236,11 @@ bool SpawnManager::IsEventGuid(uint32 dbguid, HighGuid high) const
 
 void SpawnManager::RespawnAll()
 {
+    // spawning may add spawns, keep them out of the map while iterating it
+    m_updated = true;
     for (auto itr = m_spawns.begin(); itr != m_spawns.end(); )
     {
-        auto& spawnInfo = *itr;
+        auto& spawnInfo = itr->second;
         if (spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
             m_map.GetPersistentState()->SaveGORespawnTime(spawnInfo.GetDbGuid(), 0);
         if (spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
@@ -253,27 +250,43 @@ void SpawnManager::RespawnAll()
         else
             ++itr;
     }
+    m_updated = false;
+
+    for (auto& group : m_spawnGroups)
+        group.second->MarkForSpawnCheck();
 }
 
 void SpawnManager::Update()
 {
     m_updated = true;
-    if (!m_deferredSpawns.empty()) // cannot insert during update
-    {
-        m_spawns.reserve(m_spawns.size() + m_deferredSpawns.size());
-        std::move(std::begin(m_deferredSpawns), std::end(m_deferredSpawns), std::back_inserter(m_spawns));
-        m_deferredSpawns.clear();
-    }
+    for (SpawnInfo const& spawnInfo : m_deferredSpawns) // cannot insert during update
+        AddSpawn(spawnInfo);
+    m_deferredSpawns.clear();
+
+    // only spawns whose respawn time has come are visited, stale events of rescheduled or removed spawns are dropped
     auto now = m_map.GetCurrentClockTime();
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    std::vector<RespawnEvent> blocked;
+    while (!m_respawnQueue.empty() && m_respawnQueue.top().respawnTime <= now)
     {
-        auto& spawnInfo = *itr;
-        if (spawnInfo.IsUsed() ||
-            (spawnInfo.GetRespawnTime() <= now && spawnInfo.ConstructForMap(m_map)))
-            itr = m_spawns.erase(itr);
+        RespawnEvent event = m_respawnQueue.top();
+        m_respawnQueue.pop();
+
+        auto itr = m_spawns.find(event.key);
+        if (itr == m_spawns.end())
+            continue;
+
+        SpawnInfo& spawnInfo = itr->second;
+        if (spawnInfo.IsUsed())
+            m_spawns.erase(itr);
+        else if (spawnInfo.GetRespawnTime() != event.respawnTime)
+            continue;
+        else if (spawnInfo.ConstructForMap(m_map))
+            m_spawns.erase(itr);
         else
-            ++itr;
+            blocked.push_back(event); // linking can hold back a spawn, retried every update as before
     }
+    for (RespawnEvent const& event : blocked)
+        m_respawnQueue.push(event);
     m_updated = false;
 
     // spawn groups are safe from this
@@ -283,9 +296,15 @@ void SpawnManager::Update()
 
 std::string SpawnManager::GetRespawnList()
 {
-    std::string output = "";
+    std::vector<SpawnInfo const*> spawns;
     for (auto& data : m_spawns)
+        spawns.push_back(&data.second);
+    std::sort(spawns.begin(), spawns.end(), [](SpawnInfo const* lhs, SpawnInfo const* rhs) { return *lhs < *rhs; });
+
+    std::string output = "";
+    for (SpawnInfo const* spawn : spawns)
     {
+        SpawnInfo const& data = *spawn;
         output += "DBGuid: " + std::to_string(data.GetDbGuid()) + "HighGuid: " + (data.GetHighGuid() == HIGHGUID_UNIT ? "Creature" : "GameObject") + "Respawn Time ";
         auto diff = (data.GetRespawnTime() - m_map.GetCurrentClockTime()).count();
         if (auto hours = diff / (HOUR * IN_MILLISECONDS))
@@ -23,7 +23,9 @@
 #include "Entities/ObjectGuid.h"
 #include "Maps/SpawnGroup.h"
 
+#include <queue>
 #include <string>
+#include <unordered_map>
 
 class Map;
 
@@ -79,10 +81,26 @@ class SpawnManager
 
         void RespawnSpawnGroupsInVicinity(Position pos, float range);
     private:
+        // respawn time of a spawn, newer entries of the same spawn make older ones stale
+        struct RespawnEvent
+        {
+            TimePoint respawnTime;
+            uint64 key;
+
+            bool operator>(RespawnEvent const& other) const { return respawnTime > other.respawnTime; }
+        };
+
+        static uint64 MakeKey(uint32 dbguid, HighGuid high) { return (uint64(high) << 32) | dbguid; }
+
+        void AddSpawn(SpawnInfo const& spawnInfo);
+        SpawnInfo* FindUnusedSpawn(uint32 dbguid, HighGuid high);
+        void WakeSpawnGroup(uint32 dbguid, HighGuid high);
+
         Map& m_map;
 
         std::vector<SpawnInfo> m_deferredSpawns;
-        std::vector<SpawnInfo> m_spawns; // must only be erased from in Update
+        std::unordered_map<uint64, SpawnInfo> m_spawns; // must only be erased from in Update
+        std::priority_queue<RespawnEvent, std::vector<RespawnEvent>, std::greater<RespawnEvent>> m_respawnQueue; // soonest first
         std::map<uint32, SpawnGroup*> m_spawnGroups;
         bool m_updated;
 
@@ -139,7 +139,8 @@ namespace MMAP
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        loadedMMaps.emplace(mapId, std::make_unique<MMapData>(mesh));
+        std::unique_lock<std::shared_mutex> lock(m_navMeshLock);
+        loadedMMaps.emplace(mapId, std::make_unique<MMapData>(mesh, m_pathCacheSize, ++m_mmapDataGeneration));
         return true;
     }
 
@@ -264,6 +265,7 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
+        std::unique_lock<std::shared_mutex> lock(m_navMeshLock);
         dtStatus dtResult = mmapData->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
         if (dtStatusFailed(dtResult))
         {
@@ -273,6 +275,7 @@ namespace MMAP
         }
 
         mmapData->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        mmapData->pathCache.Clear();
         ++loadedTiles;
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
         return true;
@@ -403,6 +406,7 @@ namespace MMAP
         dtTileRef tileRef = mmapData->mmapLoadedTiles[packedGridPos];
 
         // unload, and mark as non loaded
+        std::unique_lock<std::shared_mutex> lock(m_navMeshLock);
         dtStatus dtResult = mmapData->navMesh->removeTile(tileRef, nullptr, nullptr);
         if (dtStatusFailed(dtResult))
         {
@@ -415,6 +419,7 @@ namespace MMAP
         else
         {
             mmapData->mmapLoadedTiles.erase(packedGridPos);
+            mmapData->pathCache.Clear();
             --loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -433,6 +438,7 @@ namespace MMAP
         }
 
         // unload all tiles from given map
+        std::unique_lock<std::shared_mutex> lock(m_navMeshLock);
         const auto& mmapData = loadedMMaps[mapId];
         for (MMapTileSet::iterator i = mmapData->mmapLoadedTiles.begin(); i != mmapData->mmapLoadedTiles.end(); ++i)
         {
@@ -540,4 +546,66 @@ namespace MMAP
 
         return mmapGOData->navMeshGOQueries[threadId];
     }
+
+    PathCache* MMapManager::GetPathCache(uint32 mapId)
+    {
+        auto itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end() || !itr->second->pathCache.IsEnabled())
+            return nullptr;
+
+        return &itr->second->pathCache;
+    }
+
+    void MMapManager::InvalidatePathCache(uint32 mapId)
+    {
+        if (PathCache* cache = GetPathCache(mapId))
+            cache->Clear();
+    }
+
+    dtNavMeshQuery const* MMapManager::GetThreadNavMeshQuery(uint32 mapId)
+    {
+        auto itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        const auto& mmapData = itr->second;
+
+        // queries already created by this thread, map data is only freed under exclusive m_navMeshLock and the
+        // generation check catches a reload of it
+        struct ThreadQuery
+        {
+            uint32 generation;
+            dtNavMeshQuery const* query;
+        };
+        thread_local std::unordered_map<uint32, ThreadQuery> threadQueries;
+
+        auto cachedItr = threadQueries.find(mapId);
+        if (cachedItr != threadQueries.end() && cachedItr->second.generation == mmapData->generation)
+            return cachedItr->second.query;
+
+        auto threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> guard(m_threadQueriesMutex);
+        auto queryItr = mmapData->navMeshThreadQueries.find(threadId);
+        if (queryItr != mmapData->navMeshThreadQueries.end())
+        {
+            threadQueries[mapId] = { mmapData->generation, queryItr->second };
+            return queryItr->second;
+        }
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(query);
+        if (dtStatusFailed(query->init(mmapData->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog.outError("MMAP:GetThreadNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+            return nullptr;
+        }
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetThreadNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+        mmapData->navMeshThreadQueries.emplace(threadId, query);
+        threadQueries[mapId] = { mmapData->generation, query };
+        return query;
+    }
 }
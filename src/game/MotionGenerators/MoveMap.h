@@ -20,12 +20,14 @@
 #define _MOVE_MAP_H
 
 #include "Common.h"
+#include "MotionGenerators/PathCache.h"
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
 
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 class Unit;
 
@@ -50,12 +52,15 @@ namespace MMAP
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh), fullLoaded(false) {}
+        MMapData(dtNavMesh* mesh, uint32 pathCacheSize, uint32 generation) : navMesh(mesh), pathCache(pathCacheSize), fullLoaded(false), generation(generation) {}
         ~MMapData()
         {
             for (auto& navMeshQuerie : navMeshQueries)
                 dtFreeNavMeshQuery(navMeshQuerie.second);
 
+            for (auto& navMeshQuerie : navMeshThreadQueries)
+                dtFreeNavMeshQuery(navMeshQuerie.second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
@@ -64,9 +69,12 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        NavMeshGOQuerySet navMeshThreadQueries; // pathfinder thread id to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        PathCache pathCache;                // poly corridors, cleared on every navmesh change
 
         bool fullLoaded;
+        uint32 generation;                  // unique per load, tells pathfinder threads their cached query is stale
     };
 
     struct MMapGOData
@@ -93,7 +101,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), m_enabled(true) {}
+            MMapManager() : loadedTiles(0), m_mmapDataGeneration(0), m_enabled(true), m_pathCacheSize(0) {}
             ~MMapManager();
 
             void loadAllMapTiles(std::string const& basePath, uint32 mapId);
@@ -110,6 +118,8 @@ namespace MMAP
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
+            // query owned by the calling thread - caller must hold GetNavMeshLock() shared
+            dtNavMeshQuery const* GetThreadNavMeshQuery(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
             dtNavMesh const* GetGONavMesh(uint32 displayId);
 
@@ -118,6 +128,14 @@ namespace MMAP
 
             void SetEnabled(bool state) { m_enabled = state; }
             bool IsEnabled() const { return m_enabled; }
+
+            // size of path cache of maps loaded afterwards, 0 disables it
+            void SetPathCacheSize(uint32 size) { m_pathCacheSize = size; }
+            PathCache* GetPathCache(uint32 mapId);
+            void InvalidatePathCache(uint32 mapId);
+
+            // held exclusive while tiles are added/removed, shared by async path requests
+            std::shared_mutex& GetNavMeshLock() { return m_navMeshLock; }
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
@@ -128,7 +146,12 @@ namespace MMAP
             std::unordered_map<uint32, std::unique_ptr<MMapGOData>> m_loadedModels;
             std::mutex m_modelsMutex;
 
+            std::shared_mutex m_navMeshLock;
+            std::mutex m_threadQueriesMutex;    // only taken when a pathfinder thread creates a query
+            uint32 m_mmapDataGeneration;        // guarded by m_navMeshLock
+
             bool m_enabled;
+            uint32 m_pathCacheSize;
     };
 
     // static class
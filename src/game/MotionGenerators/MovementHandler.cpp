@@ -31,6 +31,8 @@
 #include "Globals/ObjectMgr.h"
 #include "World/World.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Grids/GridNotifiers.h"
+#include "Grids/CellImpl.h"
 
 void WorldSession::HandleMoveWorldportAckOpcode(WorldPacket& /*recv_data*/)
 {
@@ -386,7 +388,14 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recv_data)
     WorldPacket data(opcode, recv_data.size());
     data << mover->GetPackGUID();             // write guid
     movementInfo.Write(data);                               // write data
-    mover->SendMessageToSetExcept(data, _player);
+
+    if (sWorld.getConfig(CONFIG_BOOL_MOVEMENT_RELAY_SHAPING) && mover->IsInWorld())
+    {
+        MaNGOS::MovementMessageDeliverer notifier(*mover, data, _player);
+        Cell::VisitWorldObjects(mover, notifier, mover->GetMap()->GetVisibilityDistance());
+    }
+    else
+        mover->SendMessageToSetExcept(data, _player);
 }
 
 void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathCache.h"
+
+#include <cstring>
+
+namespace MMAP
+{
+    uint32 PathCache::GetAreaCostHash(dtQueryFilter const& filter)
+    {
+        // FNV-1a over the cost bits, default filter always yields the same value
+        uint32 hash = 2166136261u;
+        for (int area = 0; area < DT_MAX_AREAS; ++area)
+        {
+            float cost = filter.getAreaCost(area);
+            uint32 bits;
+            memcpy(&bits, &cost, sizeof(bits));
+            hash = (hash ^ bits) * 16777619u;
+        }
+        return hash;
+    }
+
+    PathCache::Key PathCache::MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 maxPolys)
+    {
+        Key key = { startPoly, endPoly, uint32(filter.getIncludeFlags()) << 16 | filter.getExcludeFlags(), GetAreaCostHash(filter), maxPolys };
+        return key;
+    }
+
+    bool PathCache::Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 maxPolys, dtPolyRef* path, uint32& pathLength)
+    {
+        Key key = MakeKey(startPoly, endPoly, filter, maxPolys);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto itr = m_index.find(key);
+        if (itr == m_index.end())
+        {
+            ++m_misses;
+            return false;
+        }
+
+        ++m_hits;
+
+        // move to front of lru list
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+
+        std::vector<dtPolyRef> const& polys = itr->second->second;
+        std::copy(polys.begin(), polys.end(), path);
+        pathLength = uint32(polys.size());
+        return true;
+    }
+
+    void PathCache::Insert(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 maxPolys, dtPolyRef const* path, uint32 pathLength)
+    {
+        if (!m_capacity || !pathLength)
+            return;
+
+        Key key = MakeKey(startPoly, endPoly, filter, maxPolys);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto itr = m_index.find(key);
+        if (itr != m_index.end())
+        {
+            // another thread was faster
+            m_entries.splice(m_entries.begin(), m_entries, itr->second);
+            return;
+        }
+
+        if (m_entries.size() >= m_capacity)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(key, std::vector<dtPolyRef>(path, path + pathLength));
+        m_index.emplace(key, m_entries.begin());
+    }
+
+    void PathCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_index.clear();
+        m_entries.clear();
+    }
+
+    void PathCache::GetStats(uint64& hits, uint64& misses, uint32& size)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        hits = m_hits;
+        misses = m_misses;
+        size = uint32(m_entries.size());
+    }
+}
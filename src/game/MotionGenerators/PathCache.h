@@ -0,0 +1,93 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Common.h"
+#include <Detour/Include/DetourNavMesh.h>
+#include <Detour/Include/DetourNavMeshQuery.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MMAP
+{
+    // LRU cache of poly corridors found by dtNavMeshQuery::findPath
+    // one per navmesh, shared by all instances and pathfinder threads - must be cleared whenever navmesh changes
+    class PathCache
+    {
+        public:
+            explicit PathCache(uint32 capacity) : m_capacity(capacity), m_hits(0), m_misses(0) {}
+
+            bool IsEnabled() const { return m_capacity > 0; }
+
+            // hash of the filter area costs, corridors found with different costs must not be shared
+            static uint32 GetAreaCostHash(dtQueryFilter const& filter);
+
+            // copies cached corridor into path, which must hold at least maxPolys refs
+            bool Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 maxPolys, dtPolyRef* path, uint32& pathLength);
+            void Insert(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 maxPolys, dtPolyRef const* path, uint32 pathLength);
+            void Clear();
+
+            void GetStats(uint64& hits, uint64& misses, uint32& size);
+
+        private:
+            struct Key
+            {
+                dtPolyRef startPoly;
+                dtPolyRef endPoly;
+                uint32 flags;       // include flags << 16 | exclude flags
+                uint32 areaCosts;   // GetAreaCostHash of the filter
+                uint32 maxPolys;
+
+                bool operator==(Key const& other) const
+                {
+                    return startPoly == other.startPoly && endPoly == other.endPoly && flags == other.flags && areaCosts == other.areaCosts && maxPolys == other.maxPolys;
+                }
+            };
+
+            struct KeyHash
+            {
+                std::size_t operator()(Key const& key) const
+                {
+                    std::size_t hash = std::hash<dtPolyRef>()(key.startPoly);
+                    hash ^= std::hash<dtPolyRef>()(key.endPoly) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                    hash ^= std::hash<uint64>()(uint64(key.flags) << 32 | key.maxPolys) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                    hash ^= std::hash<uint32>()(key.areaCosts) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                    return hash;
+                }
+            };
+
+            static Key MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, uint32 maxPolys);
+
+            typedef std::list<std::pair<Key, std::vector<dtPolyRef>>> EntryList;
+
+            uint32 m_capacity;
+            EntryList m_entries;                    // most recently used first
+            std::unordered_map<Key, EntryList::iterator, KeyHash> m_index;
+            std::mutex m_mutex;
+
+            uint64 m_hits;
+            uint64 m_misses;
+    };
+}
+
+#endif
@@ -36,8 +36,9 @@ PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
     m_type(PATHFIND_BLANK), m_useStraightPath(false), m_forceDestination(false), m_straightLine(false),
     m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
     m_cachedPoints(m_pointPathLimit * VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_polyLength(0),
-    m_smoothPathPolyRefs(m_pointPathLimit), m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr),
-    m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization)
+    m_smoothPathPolyRefs(m_pointPathLimit), m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_pathCache(nullptr),
+    m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization),
+    m_async(false), m_asyncRandomPoint(false), m_asyncSwimmer(false), m_asyncIsDungeon(false), m_asyncCollisionWidth(0.0f), m_asyncOwnerLowGuid(0)
 #ifdef ENABLE_PLAYERBOTS
     , m_defaultInstanceId(m_sourceUnit->GetInstanceId())
 #endif
@@ -57,7 +58,8 @@ PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
 PathFinder::PathFinder() :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_straightLine(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
-    m_sourceUnit(nullptr), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_cachedPoints(m_pointPathLimit* VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(0), m_defaultInstanceId(0)
+    m_sourceUnit(nullptr), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_pathCache(nullptr), m_cachedPoints(m_pointPathLimit* VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(0), m_defaultInstanceId(0),
+    m_async(false), m_asyncRandomPoint(false), m_asyncSwimmer(false), m_asyncIsDungeon(false), m_asyncCollisionWidth(0.0f), m_asyncOwnerLowGuid(0)
 {
 
 }
@@ -65,7 +67,8 @@ PathFinder::PathFinder() :
 PathFinder::PathFinder(uint32 mapId, uint32 instanceId) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_straightLine(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
-    m_sourceUnit(nullptr), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_cachedPoints(m_pointPathLimit* VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(mapId), m_defaultInstanceId(instanceId)
+    m_sourceUnit(nullptr), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_pathCache(nullptr), m_cachedPoints(m_pointPathLimit* VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_smoothPathPolyRefs(m_pointPathLimit), m_defaultMapId(mapId), m_defaultInstanceId(instanceId),
+    m_async(false), m_asyncRandomPoint(false), m_asyncSwimmer(false), m_asyncIsDungeon(false), m_asyncCollisionWidth(0.0f), m_asyncOwnerLowGuid(0)
 {
     MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
     m_defaultNavMeshQuery = mmap->GetNavMeshQuery(mapId, instanceId);
@@ -75,7 +78,9 @@ PathFinder::PathFinder(uint32 mapId, uint32 instanceId) :
 
 PathFinder::~PathFinder()
 {
-    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+    // async copies may outlive their owner
+    if (!m_async)
+        DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
 }
 
 void PathFinder::SetCurrentNavMesh()
@@ -84,13 +89,20 @@ void PathFinder::SetCurrentNavMesh()
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         if (GenericTransport* transport = m_sourceUnit->GetTransport())
+        {
             m_navMeshQuery = mmap->GetModelNavMeshQuery(transport->GetDisplayId());
+            m_pathCache = nullptr;
+        }
         else
         {
             if (m_defaultMapId != m_sourceUnit->GetMapId())
+            {
+                m_defaultMapId = m_sourceUnit->GetMapId();
                 m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+            }
 
             m_navMeshQuery = m_defaultNavMeshQuery;
+            m_pathCache = mmap->GetPathCache(m_defaultMapId);
         }
 
         if (m_navMeshQuery)
@@ -102,6 +114,7 @@ void PathFinder::SetCurrentNavMesh()
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         m_navMeshQuery = m_defaultNavMeshQuery;
+        m_pathCache = mmap->GetPathCache(m_defaultMapId);
 
         if (m_navMeshQuery)
             m_navMesh = m_navMeshQuery->getAttachedNavMesh();
@@ -179,6 +192,114 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
     return true;
 }
 
+bool PathFinder::PrepareAsync(float destX, float destY, float destZ, bool forceDest/* = false*/)
+{
+    if (!m_sourceUnit || m_sourceUnit->GetTransport())
+        return false;
+
+    Vector3 start;
+    m_sourceUnit->GetPosition(start.x, start.y, start.z);
+    Vector3 dest(destX, destY, destZ);
+
+    if (!MaNGOS::IsValidMapCoord(dest.x, dest.y, dest.z) || !MaNGOS::IsValidMapCoord(start.x, start.y, start.z))
+        return false;
+
+    setStartPosition(start);
+    setEndPosition(dest);
+
+    m_forceDestination = forceDest;
+    m_straightLine = false;
+    m_asyncRandomPoint = false;
+
+    SetCurrentNavMesh();
+
+    if (!m_navMesh || !m_navMeshQuery || m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING) ||
+        !HaveTile(start) || !HaveTile(dest))
+        return false;
+
+    updateFilter();
+
+    CopyOwnerForAsync();
+    return true;
+}
+
+bool PathFinder::PrepareAsyncRandomPoint(Vector3 const& startPoint, float maxRange)
+{
+    if (!m_sourceUnit || m_sourceUnit->GetTransport())
+        return false;
+
+    if (!PrepareRandomPoint(startPoint, maxRange))
+        return false;
+
+    m_asyncRandomPoint = true;
+    CopyOwnerForAsync();
+    return true;
+}
+
+void PathFinder::CopyOwnerForAsync()
+{
+    // everything the pathfinder thread needs from the owner - it may be moved or freed while the request runs
+    m_asyncSwimmer = m_sourceUnit->IsInWater() && m_sourceUnit->CanSwim();
+    m_asyncCollisionWidth = m_sourceUnit->GetCollisionWidth();
+    m_asyncIsDungeon = m_sourceUnit->GetMap()->IsDungeon();
+    m_asyncOwnerLowGuid = m_sourceUnit->GetGUIDLow();
+    m_async = true;
+}
+
+void PathFinder::CalculateAsync()
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    std::shared_lock<std::shared_mutex> lock(mmap->GetNavMeshLock());
+
+    // the map thread query can not be shared - use one owned by this thread
+    m_navMeshQuery = mmap->GetThreadNavMeshQuery(m_defaultMapId);
+    if (!m_navMeshQuery)
+    {
+        m_type = PATHFIND_BLANK;
+        return;
+    }
+
+    m_navMesh = m_navMeshQuery->getAttachedNavMesh();
+    m_pathCache = mmap->GetPathCache(m_defaultMapId);
+
+    if (m_asyncRandomPoint)
+    {
+        // navmesh queries do not work in water - los check has to be done on map thread
+        if (!BuildRandomPointPath() && m_asyncSwimmer)
+            m_type = PATHFIND_BLANK;
+    }
+    else
+        BuildPolyPath(getStartPosition(), getEndPosition());
+}
+
+bool PathFinder::FinishAsync(PathFinder const& result)
+{
+    if (result.m_type == PATHFIND_BLANK)
+        return false;
+
+    // owner kept moving while the path was searched - a start further than a path step away is stale
+    if (m_sourceUnit)
+    {
+        Vector3 currPos;
+        m_sourceUnit->GetPosition(currPos.x, currPos.y, currPos.z);
+        if ((currPos - result.m_startPosition).squaredLength() > SMOOTH_PATH_STEP_SIZE * SMOOTH_PATH_STEP_SIZE)
+            return false;
+    }
+
+    m_pathPoints = result.m_pathPoints;
+    m_type = result.m_type;
+    m_pathPolyRefs = result.m_pathPolyRefs;
+    m_polyLength = result.m_polyLength;
+    m_pointPathLimit = result.m_pointPathLimit;
+    m_startPosition = result.m_startPosition;
+    m_endPosition = result.m_endPosition;
+    m_actualEndPosition = result.m_actualEndPosition;
+
+    // owner dependant part of the calculation
+    NormalizePath();
+    return true;
+}
+
 #ifdef ENABLE_PLAYERBOTS
 void PathFinder::setArea(uint32 mapId, float x, float y, float z, uint32 area, float range)
 {
@@ -234,6 +355,9 @@ void PathFinder::setArea(uint32 mapId, float x, float y, float z, uint32 area, f
         if (curArea != 8 && curArea < area)
             dtStatus status = navMesh->setPolyArea(m_polys[i], area);
     }
+
+    // area costs changed - cached corridors may no longer be the cheapest
+    mmap->InvalidatePathCache(mapId);
 }
 
 uint32 PathFinder::getArea(uint32 mapId, float x, float y, float z)
@@ -392,9 +516,9 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
     // *** getting start/end poly logic ***
 #ifndef ENABLE_PLAYERBOTS
-    if (m_sourceUnit->GetMap()->IsDungeon())
+    if (m_async ? m_asyncIsDungeon : m_sourceUnit->GetMap()->IsDungeon())
 #else
-    if ((m_sourceUnit && m_sourceUnit->GetMap()->IsDungeon()) || (sMapStore.LookupEntry(m_defaultMapId) && sMapStore.LookupEntry(m_defaultMapId)->IsDungeon()))
+    if ((m_async ? m_asyncIsDungeon : (m_sourceUnit && m_sourceUnit->GetMap()->IsDungeon())) || (sMapStore.LookupEntry(m_defaultMapId) && sMapStore.LookupEntry(m_defaultMapId)->IsDungeon()))
 #endif
     {
         float distance = sqrt((endPos.x - startPos.x) * (endPos.x - startPos.x) + (endPos.y - startPos.y) * (endPos.y - startPos.y) + (endPos.z - startPos.z) * (endPos.z - startPos.z));
@@ -422,6 +546,14 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
     if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF)
     {
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)\n");
+
+        // swim/fly shortcuts depend on owner and terrain state
+        if (m_async)
+        {
+            m_type = PATHFIND_BLANK;
+            return;
+        }
+
         BuildShortcut();
 
 #ifdef ENABLE_PLAYERBOTS
@@ -454,6 +586,12 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
     {
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: farFromPoly distToStartPoly=%.3f distToEndPoly=%.3f\n", distToStartPoly, distToEndPoly);
 
+        if (m_async)
+        {
+            m_type = PATHFIND_BLANK;
+            return;
+        }
+
         bool buildShotrcut = false;
 #ifdef ENABLE_PLAYERBOTS
         if (m_sourceUnit)
@@ -539,7 +677,7 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
                     sLog.outError("Invalid poly ref in BuildPolyPath. polyLength: %u, pathStartIndex: %u,"
                         " startPos: %s, endPos: %s, mapId: %u",
                         m_polyLength, pathStartIndex, startPos.toString().c_str(), endPos.toString().c_str(),
-                        m_sourceUnit->GetMapId());
+                        m_async ? m_defaultMapId : m_sourceUnit->GetMapId());
                 break;
             }
 
@@ -675,19 +813,29 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         if (!m_straightLine)
         {
-            dtResult = m_navMeshQuery->findPath(
-                    startPoly,          // start polygon
-                    endPoly,            // end polygon
-                    startPoint,         // start position
-                    endPoint,           // end position
-                    &m_filter,          // polygon search filter
-                    m_pathPolyRefs.data(), // [out] path
-                    (int*)&m_polyLength,
 #ifdef ENABLE_PLAYERBOTS
-                    m_pointPathLimit / 2);
+            uint32 maxPolys = m_pointPathLimit / 2;
 #else
-                    m_pointPathLimit);  // max number of polygons in output path
+            uint32 maxPolys = m_pointPathLimit;  // max number of polygons in output path
 #endif
+            // same corridor was already searched for with the same filter - skip A*
+            if (m_pathCache && m_pathCache->Find(startPoly, endPoly, m_filter, maxPolys, m_pathPolyRefs.data(), m_polyLength))
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = m_navMeshQuery->findPath(
+                        startPoly,          // start polygon
+                        endPoly,            // end polygon
+                        startPoint,         // start position
+                        endPoint,           // end position
+                        &m_filter,          // polygon search filter
+                        m_pathPolyRefs.data(), // [out] path
+                        (int*)&m_polyLength,
+                        maxPolys);
+
+                if (m_pathCache && dtStatusSucceed(dtResult))
+                    m_pathCache->Insert(startPoly, endPoly, m_filter, maxPolys, m_pathPolyRefs.data(), m_polyLength);
+            }
         }
         else
         {
@@ -720,7 +868,7 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
                 if (m_sourceUnit)
                 {
 #endif
-                    hit = hit - m_sourceUnit->GetCollisionWidth();
+                    hit = hit - (m_async ? m_asyncCollisionWidth : m_sourceUnit->GetCollisionWidth());
                     if (hit < 0.1f)
                     {
                         m_type = PATHFIND_NOPATH;
@@ -766,10 +914,10 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 #ifdef ENABLE_PLAYERBOTS
             if (m_sourceUnit)
 #endif
-                sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+                sLog.outError("%u's Path Build failed: 0 length path", m_async ? m_asyncOwnerLowGuid : m_sourceUnit->GetGUIDLow());
 
 #ifdef ENABLE_PLAYERBOTS
-            if (m_sourceUnit && m_sourceUnit->IsPlayer() && IsPointHigherThan(getActualEndPosition(), getStartPosition()))
+            if (!m_async && m_sourceUnit && m_sourceUnit->IsPlayer() && IsPointHigherThan(getActualEndPosition(), getStartPosition()))
             {
                 sLog.outDebug("%s (%u) Path Shortcut skipped: endPoint is higher", m_sourceUnit->GetName(), m_sourceUnit->GetGUIDLow());
                 return;
@@ -987,7 +1135,8 @@ void PathFinder::BuildPointPath(const float* startPoint, const float* endPoint)
 
 void PathFinder::NormalizePath()
 {
-    if (!sWorld.getConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z) || m_ignoreNormalization || !m_sourceUnit)
+    // async paths are normalized in FinishAsync
+    if (!sWorld.getConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z) || m_ignoreNormalization || !m_sourceUnit || m_async)
         return;
 
     GenericTransport* transport = m_sourceUnit->GetTransport();
@@ -1349,6 +1498,22 @@ dtStatus PathFinder::findSmoothPath(const float* startPos, const float* endPos,
 }
 
 void PathFinder::ComputePathToRandomPoint(Vector3 const& startPoint, float maxRange)
+{
+    if (!PrepareRandomPoint(startPoint, maxRange))
+        return;
+
+    bool fail = !BuildRandomPointPath();
+
+    // navmesh queries do not work in water - need to supplement with los check and just build a shortcut
+    Vector3 currPos = getStartPosition();
+    Vector3 endPoint = getEndPosition();
+    if (fail && m_sourceUnit->IsInWater() && m_sourceUnit->CanSwim() && m_sourceUnit->GetMap()->IsInLineOfSight(currPos.x, currPos.y, currPos.z + m_sourceUnit->GetCollisionHeight(), endPoint.x, endPoint.y, endPoint.z + m_sourceUnit->GetCollisionHeight(), false))
+    {
+        BuildShortcut();
+    }
+}
+
+bool PathFinder::PrepareRandomPoint(Vector3 const& startPoint, float maxRange)
 {
     clear();
     m_type = PathType(PATHFIND_NOPATH);
@@ -1366,21 +1531,16 @@ void PathFinder::ComputePathToRandomPoint(Vector3 const& startPoint, float maxRa
     float angle = rand_norm_f() * 2 * M_PI_F;
     float range = rand_norm_f() * maxRange;
 
-    float randomPoint[3];
-    randomPoint[2] = startPoint.x + range * cos(angle);
-    randomPoint[0] = startPoint.y + range * sin(angle);
-    randomPoint[1] = startPoint.z;
-
     Vector3 currPos;
     m_sourceUnit->GetPosition(currPos.x, currPos.y, currPos.z, m_sourceUnit->GetTransport());
-    Vector3 endPoint(randomPoint[2], randomPoint[0], randomPoint[1]);
+    Vector3 endPoint(startPoint.x + range * cos(angle), startPoint.y + range * sin(angle), startPoint.z);
 
     // fast check to see if point is far enough
     if ((currPos - endPoint).squaredMagnitude() < 0.01f)
     {
         m_type = PathType(PATHFIND_NOPATH);
         //sLog.outDebug("PathFinder::GetPathToRandomPoint> too small distance from point start(%s) to end(%s) for %s", currPos.toString().c_str(), endPoint.toString().c_str(), m_sourceUnit->GetGuidStr().c_str());
-        return;
+        return false;
     }
 
     setStartPosition(currPos);
@@ -1394,33 +1554,35 @@ void PathFinder::ComputePathToRandomPoint(Vector3 const& startPoint, float maxRa
         BuildShortcut();
         m_type = PathType(PATHFIND_NORMAL | PATHFIND_SHORTCUT);
         //sLog.outString("PathFinder::GetPathToRandomPoint> Shortcut for %s\n", m_sourceUnit->GetGuidStr().c_str());
-        return;
+        return false;
     }
 
+    return true;
+}
+
+bool PathFinder::BuildRandomPointPath()
+{
+    Vector3 currPos = getStartPosition();
+    Vector3 endPoint = getEndPosition();
+    float randomPoint[3] = { endPoint.y, endPoint.z, endPoint.x };
+
     float distanceToPoly;
     dtPolyRef centerPoly = getPolyByLocation(randomPoint, &distanceToPoly);
-    bool fail = true;
-    if (centerPoly != INVALID_POLYREF)
-    {
-        // first we have to fix z value before hit test, z is in index 1 of randomPoint
-        dtStatus dtResult = m_navMeshQuery->getPolyHeight(centerPoly, randomPoint, &randomPoint[1]);
-        endPoint.z = randomPoint[1];
-        setEndPosition(endPoint);
+    if (centerPoly == INVALID_POLYREF)
+        return false;
 
-        if (dtResult == DT_SUCCESS)
-        {
-            // generate path
-            BuildPolyPath(currPos, endPoint);
-            fail = false;
-            //sLog.outDebug("PathFinder::GetPathToRandomPoint> path type %d size %d poly-size %d\n", m_type, m_pathPoints.size(), m_polyLength);
-        }
-    }
+    // first we have to fix z value before hit test, z is in index 1 of randomPoint
+    dtStatus dtResult = m_navMeshQuery->getPolyHeight(centerPoly, randomPoint, &randomPoint[1]);
+    endPoint.z = randomPoint[1];
+    setEndPosition(endPoint);
 
-    // navmesh queries do not work in water - need to supplement with los check and just build a shortcut
-    if (fail && m_sourceUnit->IsInWater() && m_sourceUnit->CanSwim() && m_sourceUnit->GetMap()->IsInLineOfSight(currPos.x, currPos.y, currPos.z + m_sourceUnit->GetCollisionHeight(), endPoint.x, endPoint.y, endPoint.z + m_sourceUnit->GetCollisionHeight(), false))
-    {
-        BuildShortcut();
-    }
+    if (dtResult != DT_SUCCESS)
+        return false;
+
+    // generate path
+    BuildPolyPath(currPos, endPoint);
+    //sLog.outDebug("PathFinder::GetPathToRandomPoint> path type %d size %d poly-size %d\n", m_type, m_pathPoints.size(), m_polyLength);
+    return true;
 }
 
 bool PathFinder::inRangeYZX(const float* v1, const float* v2, float r, float h) const
@@ -26,11 +26,18 @@
 
 #include "Movement/MoveSplineInitArgs.h"
 
+#include <memory>
+
 using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
 
+namespace MMAP
+{
+    class PathCache;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -83,6 +90,17 @@ class PathFinder
         // compute a straight path to some random point in max range
         void ComputePathToRandomPoint(Vector3 const& startPoint, float maxRange);
 
+        // asynchronous calculation - see MapManager::SchedulePathRequest
+        // Prepare* run on the map thread on a copy of the finder and return false when the path was already resolved
+        // or can only be computed synchronously (transports, straight line, no mmaps)
+        bool PrepareAsync(float destX, float destY, float destZ, bool forceDest = false);
+        bool PrepareAsyncRandomPoint(Vector3 const& startPoint, float maxRange);
+        // runs on a pathfinder thread, only touches the navmesh through a thread owned query
+        void CalculateAsync();
+        // back on the map thread - takes over the result, false if it has to be recalculated synchronously
+        // (nothing found off the map thread or the owner moved too far from the start it was searched from)
+        bool FinishAsync(PathFinder const& result);
+
         // option setters - use optional
         void setUseStrightPath(bool useStraightPath) { m_useStraightPath = useStraightPath; };
         void setPathLengthLimit(float distance) { m_pointPathLimit = std::min<uint32>(uint32(distance / SMOOTH_PATH_STEP_SIZE * 1.25f), MAX_POINT_PATH_LENGTH); };
@@ -126,6 +144,7 @@ class PathFinder
         const Unit* const       m_sourceUnit;       // the unit that is moving
         const dtNavMesh*        m_navMesh;          // the nav mesh
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        MMAP::PathCache*        m_pathCache;        // poly corridors of current nav mesh, nullptr when disabled
 
         const dtNavMeshQuery*   m_defaultNavMeshQuery;     // the nav mesh query used to find the path
         uint32                  m_defaultMapId;
@@ -135,6 +154,13 @@ class PathFinder
 
         bool                    m_ignoreNormalization;
 
+        bool                    m_async;            // calculated off the map thread, owner must not be accessed
+        bool                    m_asyncRandomPoint; // async request is a ComputePathToRandomPoint one
+        bool                    m_asyncSwimmer;     // owner was swimming when the random point was requested
+        bool                    m_asyncIsDungeon;   // owner state copied in CopyOwnerForAsync, used instead of m_sourceUnit
+        float                   m_asyncCollisionWidth;
+        uint32                  m_asyncOwnerLowGuid;
+
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
         void setStartPosition(const Vector3& point) { m_startPosition = point; }
@@ -160,6 +186,9 @@ class PathFinder
         void BuildPolyPath(const Vector3& startPos, const Vector3& endPos);
         void BuildPointPath(const float* startPoint, const float* endPoint);
         void BuildShortcut();
+        bool PrepareRandomPoint(Vector3 const& startPoint, float maxRange);
+        bool BuildRandomPointPath();
+        void CopyOwnerForAsync();
 #ifdef ENABLE_PLAYERBOTS
         bool IsPointHigherThan(const Vector3& posOne, const Vector3& posTwo);
 #endif
@@ -179,4 +208,13 @@ class PathFinder
                                 float* smoothPath, int* smoothPathSize, uint32 maxSmoothPathSize);
 };
 
+// Path being calculated on the pathfinder threads
+// held by the requesting movement generator, result is filled in on the map thread through Map::GetMessager()
+struct AsyncPathRequest
+{
+    std::shared_ptr<PathFinder> result;
+
+    bool IsReady() const { return result != nullptr; }
+};
+
 #endif
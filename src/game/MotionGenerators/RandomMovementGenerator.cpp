@@ -21,12 +21,15 @@
 #include "Movement/MoveSplineInit.h"
 #include "Movement/MoveSpline.h"
 #include "MotionGenerators/RandomMovementGenerator.h"
+#include "MotionGenerators/PathFinder.h"
+#include "Maps/MapManager.h"
 
 void AbstractRandomMovementGenerator::Initialize(Unit& owner)
 {
     owner.addUnitState(i_stateActive);
 
     m_pathFinder = std::make_unique<PathFinder>(&owner);
+    m_asyncPath.reset();
 
     // Client-controlled unit should have control removed
     if (const Player* controllingClientPlayer = owner.GetClientControlling())
@@ -69,6 +72,7 @@ void AbstractRandomMovementGenerator::Finalize(Unit& owner)
 void AbstractRandomMovementGenerator::Interrupt(Unit& owner)
 {
     owner.InterruptMoving();
+    m_asyncPath.reset();
 
     owner.clearUnitState(i_stateMotion);
 }
@@ -89,6 +93,7 @@ bool AbstractRandomMovementGenerator::Update(Unit& owner, const uint32& diff)
     {
         i_nextMoveTimer.Update(diff);
         owner.clearUnitState(i_stateMotion);
+        m_asyncPath.reset();
         return true;
     }
 
@@ -98,6 +103,10 @@ bool AbstractRandomMovementGenerator::Update(Unit& owner, const uint32& diff)
 
         if (i_nextMoveTimer.Passed())
         {
+            // stay in place until path arrives from pathfinder threads
+            if (m_asyncPath ? !m_asyncPath->IsReady() : RequestAsyncPath(owner))
+                return true;
+
             if (_setLocation(owner))
             {
                 if (i_nextMoveCount > 1)
@@ -124,7 +133,16 @@ int32 AbstractRandomMovementGenerator::_setLocation(Unit& owner)
     if (i_pathLength != 0.0f)
         m_pathFinder->setPathLengthLimit(i_pathLength);
 
-    m_pathFinder->ComputePathToRandomPoint(Vector3(x, y, z), i_radius);
+    if (m_asyncPath)
+    {
+        std::shared_ptr<PathFinder> result = std::move(m_asyncPath->result);
+        m_asyncPath.reset();
+
+        if (!m_pathFinder->FinishAsync(*result))
+            m_pathFinder->ComputePathToRandomPoint(Vector3(x, y, z), i_radius);
+    }
+    else
+        m_pathFinder->ComputePathToRandomPoint(Vector3(x, y, z), i_radius);
 
     if ((m_pathFinder->getPathType() & PATHFIND_NOPATH) != 0)
         return 0;
@@ -144,6 +162,23 @@ int32 AbstractRandomMovementGenerator::_setLocation(Unit& owner)
     return duration;
 }
 
+bool AbstractRandomMovementGenerator::RequestAsyncPath(Unit& owner)
+{
+    if (!CanCalculatePathAsync() || !sMapMgr.IsAsyncPathfindingEnabled())
+        return false;
+
+    if (i_pathLength != 0.0f)
+        m_pathFinder->setPathLengthLimit(i_pathLength);
+
+    auto path = std::make_shared<PathFinder>(*m_pathFinder);
+    if (!path->PrepareAsyncRandomPoint(Vector3(i_x, i_y, i_z), i_radius))
+        return false;
+
+    m_asyncPath = std::make_shared<AsyncPathRequest>();
+    sMapMgr.SchedulePathRequest(*owner.GetMap(), std::move(path), m_asyncPath);
+    return true;
+}
+
 ConfusedMovementGenerator::ConfusedMovementGenerator(float x, float y, float z) :
     AbstractRandomMovementGenerator(UNIT_STAT_CONFUSED, UNIT_STAT_CONFUSED_MOVE, 500, 1500)
 {
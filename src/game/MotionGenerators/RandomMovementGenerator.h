@@ -23,6 +23,7 @@
 #include "Entities/ObjectGuid.h"
 
 class PathFinder;
+struct AsyncPathRequest;
 
 class AbstractRandomMovementGenerator : public MovementGenerator
 {
@@ -43,6 +44,9 @@ class AbstractRandomMovementGenerator : public MovementGenerator
 
     protected:
         virtual int32 _setLocation(Unit& owner);
+        // random point path may be computed on pathfinder threads
+        virtual bool CanCalculatePathAsync() const { return false; }
+        bool RequestAsyncPath(Unit& owner);
 
         float i_x, i_y, i_z;
         float i_radius;
@@ -51,6 +55,7 @@ class AbstractRandomMovementGenerator : public MovementGenerator
         bool i_walk;
 
         std::unique_ptr<PathFinder> m_pathFinder;
+        std::shared_ptr<AsyncPathRequest> m_asyncPath;
         ShortTimeTracker i_nextMoveTimer;
         uint32 i_nextMoveCount, i_nextMoveCountMax;
         uint32 i_nextMoveDelayMin, i_nextMoveDelayMax;
@@ -78,6 +83,9 @@ class WanderMovementGenerator : public AbstractRandomMovementGenerator
         void AddToRandomPauseTime(int32 waitTimeDiff, bool force);
 
         MovementGeneratorType GetMovementGeneratorType() const override { return RANDOM_MOTION_TYPE; }
+
+    protected:
+        bool CanCalculatePathAsync() const override { return true; }
 };
 
 class TimedWanderMovementGenerator : public WanderMovementGenerator
@@ -138,6 +138,7 @@ void ChaseMovementGenerator::Initialize(Unit& owner)
         return;
     }
     owner.addUnitState(UNIT_STAT_CHASE);                    // _MOVE set in _SetTargetLocation after required checks
+    m_asyncPath.reset();
     _setLocation(owner);
     i_target->GetPosition(i_lastTargetPos.x, i_lastTargetPos.y, i_lastTargetPos.z);
     m_fanningEnabled = !(owner.GetTypeId() == TYPEID_UNIT && static_cast<Creature&>(owner).IsWorldBoss());
@@ -147,6 +148,7 @@ void ChaseMovementGenerator::Initialize(Unit& owner)
 void ChaseMovementGenerator::Finalize(Unit& owner)
 {
     owner.clearUnitState(UNIT_STAT_CHASE | UNIT_STAT_CHASE_MOVE);
+    m_asyncPath.reset();
     if (m_currentMode == CHASE_MODE_DISTANCING) // cleanup in case fanning was removed
         owner.AI()->DistancingEnded();
 }
@@ -154,6 +156,7 @@ void ChaseMovementGenerator::Finalize(Unit& owner)
 void ChaseMovementGenerator::Interrupt(Unit& owner)
 {
     owner.InterruptMoving();
+    m_asyncPath.reset();
     owner.clearUnitState(UNIT_STAT_CHASE_MOVE);
     if (m_currentMode == CHASE_MODE_DISTANCING)
         owner.AI()->UnitAI::DistancingEnded(); // just remove combat script status
@@ -268,7 +271,10 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
 
             if (owner.GetDistance(x, y, z, DIST_CALC_NONE) > 0.3f)
             {
-                if (DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true, true, true))
+                // while owner still follows its last path the new one can be calculated on pathfinder threads
+                bool pending = false;
+                if (DispatchAsyncPath(owner, x, y, z, targetMoved, pending) ||
+                    (!pending && DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true, true, true)))
                 {
                     this->i_targetReached = false;
                     this->i_speedChanged = false;
@@ -279,7 +285,7 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
                     m_closenessAndFanningTimer = 0;
                     return;
                 }
-                if (m_reachable == false)
+                if (pending || m_reachable == false)
                     return;
             }
             if (!IsReachablePositionToTarget(owner, owner.GetPositionX(), owner.GetPositionY(), owner.GetPositionZ(), *this->i_target.getTarget()))
@@ -541,6 +547,45 @@ bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, floa
             return false;
     }
 
+    return LaunchPath(owner, walk, cutPath, target, checkReachable);
+}
+
+bool ChaseMovementGenerator::DispatchAsyncPath(Unit& owner, float x, float y, float z, bool requestNew, bool& pending)
+{
+    if (m_asyncPath)
+    {
+        if (!m_asyncPath->IsReady())
+        {
+            pending = true;
+            return false;
+        }
+
+        std::shared_ptr<PathFinder> result = std::move(m_asyncPath->result);
+        m_asyncPath.reset();
+
+        // could not be resolved off the map thread - caller recalculates in place
+        if (!this->i_path->FinishAsync(*result) || (this->i_path->getPathType() & PATHFIND_NOPATH))
+            return false;
+
+        return LaunchPath(owner, EnableWalking(), true, true, true);
+    }
+
+    // only worth it while there is a spline to follow in the meantime
+    if (!requestNew || !this->i_path || owner.movespline->Finalized() || !sMapMgr.IsAsyncPathfindingEnabled())
+        return false;
+
+    auto path = std::make_shared<PathFinder>(*this->i_path);
+    if (!path->PrepareAsync(x, y, z))
+        return false;
+
+    m_asyncPath = std::make_shared<AsyncPathRequest>();
+    sMapMgr.SchedulePathRequest(*owner.GetMap(), std::move(path), m_asyncPath);
+    pending = true;
+    return false;
+}
+
+bool ChaseMovementGenerator::LaunchPath(Unit& owner, bool walk, bool cutPath, bool target, bool checkReachable)
+{
     auto& path = this->i_path->getPath();
 
     if (cutPath)
@@ -27,6 +27,7 @@
 #include "Entities/Object.h"
 
 class PathFinder;
+struct AsyncPathRequest;
 
 class TargetedMovementGeneratorBase
 {
@@ -160,6 +161,8 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
         bool IsReachablePositionToTarget(Unit& owner, float x, float y, float z, Unit& target);
 
         bool DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath, bool target = false, bool checkReachable = false);
+        bool DispatchAsyncPath(Unit& owner, float x, float y, float z, bool requestNew, bool& pending);
+        bool LaunchPath(Unit& owner, bool walk, bool cutPath, bool target, bool checkReachable);
         void CutPath(Unit& owner, PointsArray& path);
         void Backpedal(Unit& owner);
 
@@ -176,6 +179,8 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
         ChaseMovementMode m_currentMode;
 
         GuidVector m_spawns;
+
+        std::shared_ptr<AsyncPathRequest> m_asyncPath;
 };
 
 class FollowMovementGenerator : public TargetedMovementGeneratorMedium<Unit, FollowMovementGenerator>
@@ -82,6 +82,19 @@ PlayerbotAI::PlayerbotAI(PlayerbotMgr &mgr, Player* const bot, bool debugWhisper
     m_ignoreNeutralizeEffect(false),
     m_debugWhisper(debugWhisper)
 {
+    // bot session has no client, only packets handled in HandleBotOutgoingPacket are built for it
+    // keep in sync with the cases there
+    static std::vector<uint16> const interestingOpcodes =
+    {
+        SMSG_DUEL_WINNER, SMSG_DUEL_COMPLETE, SMSG_DUEL_OUTOFBOUNDS, SMSG_DUEL_REQUESTED,
+        SMSG_AUCTION_COMMAND_RESULT, SMSG_INVENTORY_CHANGE_FAILURE, SMSG_MESSAGECHAT,
+        SMSG_GROUP_SET_LEADER, SMSG_PARTY_COMMAND_RESULT, SMSG_GROUP_INVITE, SMSG_TRADE_STATUS,
+        SMSG_SPELL_START, SMSG_SPELL_GO, SMSG_RESURRECT_REQUEST,
+        SMSG_LOOT_RESPONSE, SMSG_LOOT_RELEASE_RESPONSE, SMSG_LOOT_ROLL_WON, SMSG_PARTYKILLLOG, SMSG_ITEM_PUSH_RESULT,
+        MSG_MOVE_TELEPORT_ACK, SMSG_TRANSFER_PENDING, SMSG_NEW_WORLD
+    };
+    m_bot->GetSession()->SetPacketInterest(interestingOpcodes);
+
     // set bot state and needed item list
     m_botState = BOTSTATE_LOADING;
     SetQuestNeedItems();
@@ -0,0 +1,273 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/MovementRelay.h"
+#include "Server/Opcodes.h"
+#include "Server/WorldPacket.h"
+#include "Util/Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+// a far mover not heard of for this many intervals is forgotten
+#define MOVEMENT_RELAY_FORGET_INTERVALS 10
+
+bool MovementRelayShaper::IsMergeable(uint16 opcode)
+{
+    switch (opcode)
+    {
+        case MSG_MOVE_HEARTBEAT:
+        case MSG_MOVE_SET_FACING:
+        case MSG_MOVE_SET_PITCH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MovementRelayShaper::Relay(ObjectGuid const& mover, SharedWorldPacket const& packet, bool fullRate, uint32 now, uint32 interval, uint32 budget)
+{
+    if (fullRate)
+    {
+        // a held refresh is older than this packet
+        m_movers.erase(mover);
+        return true;
+    }
+
+    MoverState& state = m_movers[mover];
+    uint32 const size = uint32(packet.GetPacket().size());
+
+    if (!IsMergeable(packet.GetPacket().GetOpcode()))
+    {
+        state.held.reset();
+        state.lastSent = now;
+        m_budgetUsed += size;
+        return true;
+    }
+
+    if (!state.held && WorldTimer::getMSTimeDiff(state.lastSent, now) >= interval && HasBudget(budget))
+    {
+        state.lastSent = now;
+        m_budgetUsed += size;
+        return true;
+    }
+
+    state.held = packet.GetBody();
+    return false;
+}
+
+void MovementRelayShaper::Flush(uint32 now, uint32 interval, uint32 budget, HeldPackets& packets)
+{
+    m_budgetUsed = 0;
+
+    std::vector<std::pair<uint32, ObjectGuid>> due;         // time since last send, mover
+    for (auto itr = m_movers.begin(); itr != m_movers.end();)
+    {
+        MoverState const& state = itr->second;
+        uint32 const waited = WorldTimer::getMSTimeDiff(state.lastSent, now);
+        if (!state.held)
+        {
+            if (waited >= MOVEMENT_RELAY_FORGET_INTERVALS * interval)
+                itr = m_movers.erase(itr);
+            else
+                ++itr;
+            continue;
+        }
+
+        if (waited >= interval)
+            due.emplace_back(waited, itr->first);
+        ++itr;
+    }
+
+    // longest waiting movers first, so a small budget still refreshes all of them in turn
+    std::sort(due.begin(), due.end(), [](std::pair<uint32, ObjectGuid> const& left, std::pair<uint32, ObjectGuid> const& right)
+    {
+        return left.first > right.first;
+    });
+
+    for (auto const& entry : due)
+    {
+        if (!HasBudget(budget))
+            break;
+
+        MoverState& state = m_movers[entry.second];
+        m_budgetUsed += uint32(state.held->size());
+        state.lastSent = now;
+        packets.emplace_back(entry.second, std::move(state.held));
+    }
+}
+
+void MovementRelayShaper::Clear()
+{
+    m_movers.clear();
+    m_budgetUsed = 0;
+}
+
+std::string MovementRelayShaper::Benchmark(uint32 players, uint32 seconds, float fullRange, uint32 interval, uint32 budget)
+{
+    float const areaSize = 300.0f;                          // a crowded battleground fight or city
+    float const sightRange = 100.0f;
+    float const runSpeed = 7.0f;
+    uint32 const tickTime = 50;
+    uint32 const heartbeatInterval = 500;                   // client heartbeat while moving
+    uint32 const packetSize = 4 + 40;                       // server header and a typical movement packet
+
+    struct SimPlayer
+    {
+        ObjectGuid guid;
+        float x, y, orientation;
+        bool moving;
+        bool mouseTurner;
+        uint32 nextHeartbeat;
+        uint32 selection;
+        MovementRelayShaper shaper;
+    };
+
+    struct PassResult
+    {
+        uint64 packets = 0;
+        uint64 bytes = 0;
+        uint64 peakTickBytes = 0;
+        uint64 micros = 0;
+    };
+
+    auto simulate = [&](bool shaped)
+    {
+        PassResult result;
+        std::mt19937 random(players);                       // same crowd for both passes
+        std::uniform_real_distribution<float> position(0.0f, areaSize);
+        std::uniform_real_distribution<float> turn(-0.3f, 0.3f);
+        std::uniform_int_distribution<uint32> roll(0, 29);
+
+        std::vector<SimPlayer> crowd(players);
+        for (uint32 i = 0; i < players; ++i)
+        {
+            SimPlayer& player = crowd[i];
+            player.guid = ObjectGuid(HIGHGUID_PLAYER, i + 1);
+            player.x = position(random);
+            player.y = position(random);
+            player.orientation = position(random);
+            player.moving = roll(random) < 20;
+            player.mouseTurner = i % 3 == 0;
+            player.nextHeartbeat = roll(random) * 20;
+            player.selection = (i + 1 + roll(random)) % players;
+        }
+
+        std::vector<uint64> tickBytes(players);
+        std::vector<Opcodes> opcodes;
+        HeldPackets held;
+        uint32 now = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 tick = 0; tick < seconds * IN_MILLISECONDS / tickTime; ++tick, now += tickTime)
+        {
+            std::fill(tickBytes.begin(), tickBytes.end(), 0);
+
+            for (uint32 i = 0; i < players; ++i)
+            {
+                SimPlayer& mover = crowd[i];
+                opcodes.clear();
+
+                if (!roll(random))
+                {
+                    mover.moving = !mover.moving;
+                    opcodes.push_back(mover.moving ? MSG_MOVE_START_FORWARD : MSG_MOVE_STOP);
+                }
+                else if (mover.moving && !roll(random))
+                    opcodes.push_back(MSG_MOVE_JUMP);
+
+                if (mover.moving)
+                {
+                    mover.orientation += turn(random);
+                    mover.x = std::min(std::max(mover.x + std::cos(mover.orientation) * runSpeed * tickTime / IN_MILLISECONDS, 0.0f), areaSize);
+                    mover.y = std::min(std::max(mover.y + std::sin(mover.orientation) * runSpeed * tickTime / IN_MILLISECONDS, 0.0f), areaSize);
+                    if (now >= mover.nextHeartbeat)
+                    {
+                        opcodes.push_back(MSG_MOVE_HEARTBEAT);
+                        mover.nextHeartbeat = now + heartbeatInterval;
+                    }
+                }
+
+                if (mover.mouseTurner && (tick + i) % 4 == 0)
+                    opcodes.push_back(MSG_MOVE_SET_FACING);
+
+                for (Opcodes opcode : opcodes)
+                {
+                    WorldPacket data(opcode, packetSize - 4);
+                    data.resize(packetSize - 4);
+                    SharedWorldPacket sharedData(data);
+
+                    for (uint32 j = 0; j < players; ++j)
+                    {
+                        SimPlayer& observer = crowd[j];
+                        float dx = observer.x - mover.x;
+                        float dy = observer.y - mover.y;
+                        float distSq = dx * dx + dy * dy;
+                        if (j == i || distSq > sightRange * sightRange)
+                            continue;
+
+                        bool fullRate = observer.selection == i || distSq <= fullRange * fullRange;
+                        if (!shaped || observer.shaper.Relay(mover.guid, sharedData, fullRate, now, interval, budget))
+                        {
+                            ++result.packets;
+                            tickBytes[j] += packetSize;
+                        }
+                    }
+                }
+            }
+
+            if (shaped)
+            {
+                for (uint32 j = 0; j < players; ++j)
+                {
+                    held.clear();
+                    crowd[j].shaper.Flush(now, interval, budget, held);
+                    result.packets += held.size();
+                    tickBytes[j] += held.size() * packetSize;
+                }
+            }
+
+            for (uint64 bytes : tickBytes)
+            {
+                result.bytes += bytes;
+                result.peakTickBytes = std::max(result.peakTickBytes, bytes);
+            }
+        }
+        result.micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    };
+
+    PassResult full = simulate(false);
+    PassResult shaped = simulate(true);
+
+    double const playerSeconds = double(players) * seconds;
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Movement relay benchmark: " << players << " players in " << uint32(areaSize) << "x" << uint32(areaSize) << " yards, "
+           << seconds << " s in " << tickTime << " ms updates, " << uint32(sightRange) << " yards sight range\n";
+    report << "Full rate: " << full.packets / playerSeconds << " packets/s and " << full.bytes / playerSeconds / 1024 << " KB/s per player, peak "
+           << full.peakTickBytes << " bytes in one update, " << full.micros / 1000 << " ms\n";
+    report << "Shaped (full range " << fullRange << " yards, interval " << interval << " ms, budget " << budget << " bytes): "
+           << shaped.packets / playerSeconds << " packets/s and " << shaped.bytes / playerSeconds / 1024 << " KB/s per player, peak "
+           << shaped.peakTickBytes << " bytes in one update, " << shaped.micros / 1000 << " ms\n";
+    report << "Shaping sends " << (full.packets ? 100.0 * shaped.packets / full.packets : 100.0) << "% of the packets";
+    return report.str();
+}
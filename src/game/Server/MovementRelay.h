@@ -0,0 +1,73 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MOVEMENT_RELAY_H
+#define MANGOS_MOVEMENT_RELAY_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class WorldPacket;
+class SharedWorldPacket;
+
+// Shaping of the movement packets other players relay to one observer (WorldSession::HandleMovementOpcodes)
+// Movers within MovementRelay.FullRange of the observer, or selected by it, are relayed at full rate.
+// For farther movers position refreshes (heartbeat, facing, pitch) are merged: only the latest one is kept and it
+// is sent once per MovementRelay.Interval while the observer has byte budget left in its update.
+// Movement state changes (start, stop, jump, ...) are always sent at once and replace a held refresh of the mover.
+class MovementRelayShaper
+{
+    public:
+        typedef std::vector<std::pair<ObjectGuid, std::shared_ptr<WorldPacket const>>> HeldPackets;
+
+        MovementRelayShaper() : m_budgetUsed(0) {}
+
+        static bool IsMergeable(uint16 opcode);
+
+        // returns true if the packet has to be sent to the observer now, otherwise it is held for a later Flush
+        bool Relay(ObjectGuid const& mover, SharedWorldPacket const& packet, bool fullRate, uint32 now, uint32 interval, uint32 budget);
+
+        // called once per observer update, starts a new budget and collects the held packets that are due within it
+        void Flush(uint32 now, uint32 interval, uint32 budget, HeldPackets& packets);
+
+        void Clear();
+
+        // relays the movement of a simulated crowd without and with shaping, for .debug movementbench
+        static std::string Benchmark(uint32 players, uint32 seconds, float fullRange, uint32 interval, uint32 budget);
+
+    private:
+        struct MoverState
+        {
+            MoverState() : lastSent(0) {}
+
+            uint32 lastSent;
+            std::shared_ptr<WorldPacket const> held;
+        };
+
+        bool HasBudget(uint32 budget) const { return !budget || m_budgetUsed < budget; }
+
+        std::unordered_map<ObjectGuid, MoverState> m_movers;
+        uint32 m_budgetUsed;                                // bytes sent to the observer for far movers since last Flush
+};
+
+#endif
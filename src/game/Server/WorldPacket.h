@@ -23,6 +23,7 @@
 #include "Util/ByteBuffer.h"
 #include "Server/Opcodes.h"
 #include <chrono>
+#include <memory>
 
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
@@ -53,4 +54,27 @@ class WorldPacket : public ByteBuffer
         Opcodes m_opcode;
         std::chrono::steady_clock::time_point m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
+
+// Packet sent unchanged to many sessions (group, channel and visibility broadcasts)
+// Body is copied once, on first socket send, into an immutable buffer shared by all sockets, only the encrypted header is per socket
+// Lives for the duration of one broadcast and is not thread safe
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const& packet) : m_packet(packet) {}
+        // wraps a body that is shared already, e.g. one held back for a later send
+        explicit SharedWorldPacket(std::shared_ptr<WorldPacket const> body) : m_packet(*body), m_body(std::move(body)) {}
+
+        WorldPacket const& GetPacket() const { return m_packet; }
+        std::shared_ptr<WorldPacket const> const& GetBody() const
+        {
+            if (!m_body)
+                m_body = std::make_shared<WorldPacket const>(m_packet);
+            return m_body;
+        }
+
+    private:
+        WorldPacket const& m_packet;
+        mutable std::shared_ptr<WorldPacket const> m_body;
+};
 #endif
@@ -196,6 +196,26 @@ void WorldSession::SetPlayer(Player* plr, uint32 playerGuid)
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= false*/) const
 {
+    if (!CanSendPacket(packet, forcedSend))
+        return;
+
+    m_socket->SendPacket(packet);
+}
+
+/// Send a broadcast packet to the client, sharing its body with the other receivers
+void WorldSession::SendPacket(SharedWorldPacket const& packet, bool forcedSend /*= false*/) const
+{
+    if (!CanSendPacket(packet.GetPacket(), forcedSend))
+        return;
+
+    m_socket->SendPacket(packet.GetBody());
+}
+
+bool WorldSession::CanSendPacket(WorldPacket const& packet, bool forcedSend) const
+{
+    if (!HasPacketInterest(packet.GetOpcode()))
+        return false;
+
 #if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
     // Send packet to bot AI
     if (GetPlayer())
@@ -210,7 +230,7 @@ void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= fal
     if (!m_socket || (m_sessionState != WORLD_SESSION_STATE_READY && !forcedSend))
     {
         //sLog.outDebug("Refused to send %s to %s", packet.GetOpcodeName(), _player ? _player->GetName() : "UKNOWN");
-        return;
+        return false;
     }
 
 #ifdef MANGOS_DEBUG
@@ -249,7 +269,14 @@ void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= fal
 
 #endif                                                  // !MANGOS_DEBUG
 
-    m_socket->SendPacket(packet);
+    return true;
+}
+
+void WorldSession::SetPacketInterest(std::vector<uint16> const& opcodes)
+{
+    m_packetInterest.assign(NUM_MSG_TYPES, false);
+    for (uint16 opcode : opcodes)
+        m_packetInterest[opcode] = true;
 }
 
 /// Add an incoming packet to the queue
@@ -38,6 +38,7 @@
 #include <deque>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 struct ItemPrototype;
 struct AuctionEntry;
@@ -51,6 +52,7 @@ class Object;
 class Player;
 class Unit;
 class WorldPacket;
+class SharedWorldPacket;
 class QueryResult;
 class LoginQueryHolder;
 class CharacterHandler;
@@ -223,6 +225,7 @@ class WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const& packet, bool forcedSend = false) const;
+        void SendPacket(SharedWorldPacket const& packet, bool forcedSend = false) const;
         void SendExpectedSpamRecords();
         void SendMotd(Player* currChar);
         void SendOfflineNameQueryResponses();
@@ -806,6 +809,11 @@ class WorldSession
 
         void SetPacketLogging(bool state);
 
+        // Socketless sessions (bots) with an interest mask only get packets with these opcodes,
+        // callers skip building (update data, compression) packets nobody would read
+        void SetPacketInterest(std::vector<uint16> const& opcodes);
+        bool HasPacketInterest(uint16 opcode) const { return m_socket || m_packetInterest.empty() || m_packetInterest[opcode]; }
+
     private:
         // private trade methods
         void moveItems(Item* myItems[], Item* hisItems[]);
@@ -820,6 +828,9 @@ class WorldSession
 
         void ProcessByteBufferException(WorldPacket const& packet);
 
+        // bot hooks, session state check and send statistics common to both SendPacket
+        bool CanSendPacket(WorldPacket const& packet, bool forcedSend) const;
+
         uint32 m_GUIDLow;                                   // set logged or recently logout player (while m_playerRecentlyLogout set)
         Player* _player;
         std::shared_ptr<WorldSocket> m_socket;              // socket pointer is owned by the network thread which created it
@@ -874,6 +885,8 @@ class WorldSession
         Messager<WorldSession> m_messager;
 
         std::atomic<uint32> m_currentPlayerLevel;
+
+        std::vector<bool> m_packetInterest;                 // empty - no mask, every packet is built
 };
 #endif
 /// @}
@@ -93,7 +93,8 @@ std::deque<uint32> WorldSocket::GetIncOpcodeHistory()
 }
 
 WorldSocket::WorldSocket(boost::asio::io_context& context) : AsyncSocket(context), m_lastPingTime(std::chrono::system_clock::time_point::min()), m_overSpeedPings(0),
-    m_session(nullptr), m_seed(urand()), m_loggingPackets(false)
+    m_session(nullptr), m_seed(urand()), m_readBuffer(READ_BUFFER_SIZE), m_readStart(0), m_readEnd(0), m_hasPendingHeader(false),
+    m_loggingPackets(false)
 {
 }
 
@@ -112,20 +113,7 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
     std::lock_guard<std::mutex> guard(m_worldSocketMutex);
 
     ServerPktHeader header;
-
-    header.cmd = pct.GetOpcode();
-    EndianConvert(header.cmd);
-
-    header.size = static_cast<uint16>(pct.size() + 2);
-    EndianConvertReverse(header.size);
-
-    m_crypt.EncryptSend(reinterpret_cast<uint8*>(&header), sizeof(header));
-
-    uint32 opcode = pct.GetOpcode();
-
-    m_opcodeHistoryOut.push_front(uint32(opcode));
-    if (m_opcodeHistoryOut.size() > 50)
-        m_opcodeHistoryOut.resize(30);
+    BuildServerPktHeader(pct, header);
 
     if (pct.size() > 0)
     {
@@ -144,6 +132,49 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
     }
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& pct)
+{
+    if (IsClosed())
+        return;
+
+    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+        sPacketLog->LogPacket(*pct, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    // Dump outgoing packet.
+    sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, false);
+
+    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+
+    // only the header is allocated per socket, body is kept alive by the write handler
+    std::shared_ptr<ServerPktHeader> sharedHeader = std::make_shared<ServerPktHeader>();
+    BuildServerPktHeader(*pct, *sharedHeader);
+
+    auto self(shared_from_this());
+    if (pct->size() > 0)
+        Write(sharedHeader->data(), sharedHeader->headerSize(), reinterpret_cast<const char*>(pct->contents()), pct->size(),
+              [self, sharedHeader, pct](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+    else
+        Write(sharedHeader->data(), sharedHeader->headerSize(), [self, sharedHeader](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+}
+
+// m_worldSocketMutex must be held, header encryption is order dependent
+void WorldSocket::BuildServerPktHeader(WorldPacket const& pct, ServerPktHeader& header)
+{
+    header.cmd = pct.GetOpcode();
+    EndianConvert(header.cmd);
+
+    header.size = static_cast<uint16>(pct.size() + 2);
+    EndianConvertReverse(header.size);
+
+    m_crypt.EncryptSend(reinterpret_cast<uint8*>(&header), sizeof(header));
+
+    uint32 opcode = pct.GetOpcode();
+
+    m_opcodeHistoryOut.push_front(uint32(opcode));
+    if (m_opcodeHistoryOut.size() > 50)
+        m_opcodeHistoryOut.resize(30);
+}
+
 bool WorldSocket::OnOpen()
 {
     // Send startup packet.
@@ -157,10 +188,8 @@ bool WorldSocket::OnOpen()
 
 bool WorldSocket::ProcessIncomingData()
 {
-    std::shared_ptr<ClientPktHeader> header = std::make_shared<ClientPktHeader>();
-
     auto self(shared_from_this());
-    Read((char*)header.get(), sizeof(ClientPktHeader), [self, header](const boost::system::error_code& error, std::size_t /*read*/) -> void
+    ReadSome(reinterpret_cast<char*>(m_readBuffer.data() + m_readEnd), m_readBuffer.size() - m_readEnd, [self](const boost::system::error_code& error, std::size_t read) -> void
     {
         if (error)
         {
@@ -169,122 +198,149 @@ bool WorldSocket::ProcessIncomingData()
         }
 
         // thread safe due to always being called from service context
-        self->m_crypt.DecryptRecv((uint8*)header.get(), sizeof(ClientPktHeader));
+        self->m_readEnd += read;
+        if (!self->ProcessReadBuffer())
+            return;
+
+        // keep the partial packet, if any, at the front to make room for the rest of it
+        size_t pending = self->m_readEnd - self->m_readStart;
+        if (pending && self->m_readStart)
+            std::memmove(self->m_readBuffer.data(), self->m_readBuffer.data() + self->m_readStart, pending);
+        self->m_readStart = 0;
+        self->m_readEnd = pending;
 
-        EndianConvertReverse(header->size);
-        EndianConvert(header->cmd);
+        self->ProcessIncomingData();
+    });
+
+    return true;
+}
 
-        if ((header->size < 4) || (header->size > 0x2800) || (header->cmd >= NUM_MSG_TYPES))
+bool WorldSocket::ProcessReadBuffer()
+{
+    while (true)
+    {
+        if (!m_hasPendingHeader)
         {
-            sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", header->size, header->cmd);
-            return;
-        }
+            if (m_readEnd - m_readStart < sizeof(ClientPktHeader))
+                return true;
 
-        const Opcodes opcode = static_cast<Opcodes>(header->cmd);
+            uint8* headerData = m_readBuffer.data() + m_readStart;
+            m_crypt.DecryptRecv(headerData, sizeof(ClientPktHeader));
+            std::memcpy(&m_pendingHeader, headerData, sizeof(ClientPktHeader));
+            m_readStart += sizeof(ClientPktHeader);
+            m_hasPendingHeader = true;
 
-        size_t packetSize = header->size - 4;
-        std::shared_ptr<std::vector<uint8>> packetBuffer = std::make_shared<std::vector<uint8>>(packetSize);
+            EndianConvertReverse(m_pendingHeader.size);
+            EndianConvert(m_pendingHeader.cmd);
 
-        self->Read(reinterpret_cast<char*>(packetBuffer->data()), packetBuffer->size(), [self, packetBuffer, opcode = opcode](const boost::system::error_code& error, std::size_t /*read*/) -> void
-        {
-            if (error)
+            if ((m_pendingHeader.size < 4) || (m_pendingHeader.size > 0x2800) || (m_pendingHeader.cmd >= NUM_MSG_TYPES))
             {
-                self->Close();
-                return;
+                sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", m_pendingHeader.size, m_pendingHeader.cmd);
+                return false;
             }
+        }
 
-            std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(opcode, packetBuffer->size());
-            pct->append(*packetBuffer.get());
-            if (sPacketLog->CanLogPacket() && self->IsLoggingPackets())
-                sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, self->GetRemoteIpAddress(), self->GetRemotePort());
+        size_t packetSize = m_pendingHeader.size - 4;
+        if (m_readEnd - m_readStart < packetSize)
+            return true;
 
-            sLog.outWorldPacketDump(self->GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
+        std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(static_cast<Opcodes>(m_pendingHeader.cmd), packetSize);
+        pct->append(m_readBuffer.data() + m_readStart, packetSize);
+        m_readStart += packetSize;
+        m_hasPendingHeader = false;
 
-            if (WorldSocket::m_packetCooldowns.size() <= size_t(opcode))
-            {
-                sLog.outError("WorldSocket::ProcessIncomingData: Received opcode beyond range of opcodes: %u", opcode);
-                self->Close();
-                return;
-            }
+        if (!ProcessPacket(std::move(pct)))
+            return false;
+    }
+}
 
-            if (WorldSocket::m_packetCooldowns[opcode])
-            {
-                auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
-                if (now < self->m_lastPacket[opcode]) // packet on cooldown
+bool WorldSocket::ProcessPacket(std::unique_ptr<WorldPacket> pct)
+{
+    const Opcodes opcode = pct->GetOpcode();
+
+    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+        sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
+
+    sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
+
+    if (WorldSocket::m_packetCooldowns.size() <= size_t(opcode))
+    {
+        sLog.outError("WorldSocket::ProcessIncomingData: Received opcode beyond range of opcodes: %u", opcode);
+        Close();
+        return false;
+    }
+
+    if (WorldSocket::m_packetCooldowns[opcode])
+    {
+        auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+        if (now < m_lastPacket[opcode]) // packet on cooldown
+            return true;
+        else // start cooldown and allow execution
+            m_lastPacket[opcode] = now + std::chrono::milliseconds(WorldSocket::m_packetCooldowns[opcode]);
+    }
+
+    try
+    {
+        switch (opcode)
+        {
+            case CMSG_AUTH_SESSION:
+                if (m_session)
                 {
-                    self->ProcessIncomingData();
-                    return;
+                    sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
+                    Close();
+                    return false;
                 }
-                else // start cooldown and allow execution
-                    self->m_lastPacket[opcode] = now + std::chrono::milliseconds(WorldSocket::m_packetCooldowns[opcode]);
-            }
 
-            try
-            {
-                switch (opcode)
+                if (!HandleAuthSession(*pct))
                 {
-                    case CMSG_AUTH_SESSION:
-                        if (self->m_session)
-                        {
-                            sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
-                            self->Close();
-                            return;
-                        }
-
-                        if (!self->HandleAuthSession(*pct))
-                        {
-                            self->Close();
-                            return;
-                        }
-                        break;
-                    case CMSG_PING:
-                        if (!self->HandlePing(*pct))
-                        {
-                            self->Close();
-                            return;
-                        }
-                        break;
-                    default:
-                    {
-                        self->m_opcodeHistoryInc.push_front(uint32(pct->GetOpcode()));
-                        if (self->m_opcodeHistoryInc.size() > 50)
-                            self->m_opcodeHistoryInc.resize(30);
-
-                        if (!self->m_session)
-                        {
-                            sLog.outError("WorldSocket::ProcessIncomingData: Client not authed opcode = %u", uint32(opcode));
-                            self->Close();
-                            return;
-                        }
-
-                        self->m_session->QueuePacket(std::move(pct));
-                        break;
-                    }
+                    Close();
+                    return false;
                 }
-            }
-            catch (ByteBufferException&)
-            {
-                sLog.outError("WorldSocket::ProcessIncomingData ByteBufferException occured while parsing an instant handled packet (opcode: %u) from client %s, accountid=%i.",
-                    opcode, self->GetRemoteAddress().c_str(), self->m_session ? self->m_session->GetAccountId() : -1);
-
-                if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+                break;
+            case CMSG_PING:
+                if (!HandlePing(*pct))
                 {
-                    DEBUG_LOG("Dumping error-causing packet:");
-                    pct->hexlike();
+                    Close();
+                    return false;
                 }
+                break;
+            default:
+            {
+                m_opcodeHistoryInc.push_front(uint32(pct->GetOpcode()));
+                if (m_opcodeHistoryInc.size() > 50)
+                    m_opcodeHistoryInc.resize(30);
 
-                if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+                if (!m_session)
                 {
-                    DETAIL_LOG("Disconnecting session [account id %i / address %s] for badly formatted packet.",
-                        self->m_session ? self->m_session->GetAccountId() : -1, self->GetRemoteAddress().c_str());
-                    self->Close();
-                    return;
+                    sLog.outError("WorldSocket::ProcessIncomingData: Client not authed opcode = %u", uint32(opcode));
+                    Close();
+                    return false;
                 }
+
+                m_session->QueuePacket(std::move(pct));
+                break;
             }
-            self->ProcessIncomingData();
-        });
-    });
+        }
+    }
+    catch (ByteBufferException&)
+    {
+        sLog.outError("WorldSocket::ProcessIncomingData ByteBufferException occured while parsing an instant handled packet (opcode: %u) from client %s, accountid=%i.",
+            opcode, GetRemoteAddress().c_str(), m_session ? m_session->GetAccountId() : -1);
 
+        if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+        {
+            DEBUG_LOG("Dumping error-causing packet:");
+            pct->hexlike();
+        }
+
+        if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+        {
+            DETAIL_LOG("Disconnecting session [account id %i / address %s] for badly formatted packet.",
+                m_session ? m_session->GetAccountId() : -1, GetRemoteAddress().c_str());
+            Close();
+            return false;
+        }
+    }
     return true;
 }
 
@@ -33,9 +33,12 @@
 #include <chrono>
 #include <functional>
 #include <deque>
+#include <memory>
+#include <vector>
 
 class WorldPacket;
 class WorldSession;
+struct ServerPktHeader;
 
 /**
  * WorldSocket.
@@ -61,10 +64,11 @@ class WorldSession;
  * The calls to Update () method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
- * For input ,the class uses one 1024 bytes buffer on stack
- * to which it does recv() calls. And then received data is
- * distributed where its needed. 1024 matches pretty well the
- * traffic generated by client for now.
+ * For input, the class uses one 16K buffer per socket which
+ * is filled by reads of whatever the kernel has available.
+ * Every completion parses all whole packets in the buffer,
+ * a partial packet is moved to the front and completed by
+ * the next read.
  *
  * The input/output do speculative reads/writes (AKA it tries
  * to read all data available in the kernel buffer or tries to
@@ -109,15 +113,34 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         BigNumber m_s;
 
-        /// process one incoming packet.
+        /// Read buffer, holds m_readEnd - m_readStart received but not yet parsed bytes
+        static constexpr size_t READ_BUFFER_SIZE = 0x4000;
+        std::vector<uint8> m_readBuffer;
+        size_t m_readStart;
+        size_t m_readEnd;
+
+        /// Header of the packet whose body is still being received, headers are decrypted only once
+        ClientPktHeader m_pendingHeader;
+        bool m_hasPendingHeader;
+
+        /// reads more data and processes all packets received.
         virtual bool ProcessIncomingData() override;
 
+        /// parses the whole packets in the read buffer, false when the socket must stop reading
+        bool ProcessReadBuffer();
+
+        /// process one incoming packet, false when the socket must stop reading
+        bool ProcessPacket(std::unique_ptr<WorldPacket> pct);
+
         /// Called by ProcessIncoming() on CMSG_AUTH_SESSION.
         bool HandleAuthSession(WorldPacket& recvPacket);
 
         /// Called by ProcessIncoming() on CMSG_PING.
         bool HandlePing(WorldPacket& recvPacket);
 
+        /// Fills and encrypts the header of an outgoing packet
+        void BuildServerPktHeader(WorldPacket const& pct, ServerPktHeader& header);
+
         std::mutex m_worldSocketMutex;
 
         std::deque<uint32> m_opcodeHistoryOut;
@@ -130,6 +153,8 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         // send a packet \o/
         void SendPacket(const WorldPacket& pct, bool immediate = false);
+        // send a packet whose body is shared with other sockets, body is not copied
+        void SendPacket(std::shared_ptr<WorldPacket const> const& pct);
 
         void FinalizeSession() { m_session = nullptr; }
 
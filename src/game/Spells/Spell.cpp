@@ -734,6 +734,8 @@ bool Spell::FillUnitTargets(TempTargetingData& targetingData, SpellTargetingData
         SpellTargetImplicitType type = SpellTargetInfoTable[target].type;
         if (!unitTargetList.empty()) // Unit case
         {
+            PrefetchTargetLineOfSight(unitTargetList, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet));
+
             for (auto itr = unitTargetList.begin(); itr != unitTargetList.end();)
             {
                 if (!CheckTarget(*itr, SpellEffectIndex(i), bool(rightTarget), CheckException(targetingData.magnet)))
@@ -6931,6 +6933,40 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
     return (CURRENT_GENERIC_SPELL);
 }
 
+/**
+ * Batches the caster line of sight checks CheckTarget would do for an area target list one by one
+ * Results land in the map line of sight cache, so this is a no-op when the cache is disabled
+ */
+void Spell::PrefetchTargetLineOfSight(UnitList const& targets, SpellEffectIndex eff, bool targetB, CheckException exception) const
+{
+    if (targets.size() < 2 || exception == EXCEPTION_MAGNET || IsIgnoreLosSpellEffect(m_spellInfo, eff, targetB))
+        return;
+
+    if (m_spellInfo->Effect[eff] == SPELL_EFFECT_SUMMON_PLAYER || m_spellInfo->Effect[eff] == SPELL_EFFECT_RESURRECT_NEW)
+        return;
+
+    SpellTargetInfo const& info = SpellTargetInfoTable[targetB ? m_spellInfo->EffectImplicitTargetB[eff] : m_spellInfo->EffectImplicitTargetA[eff]];
+    if (info.los != TARGET_LOS_CASTER || info.enumerator == TARGET_ENUMERATOR_CHAIN || (info.type == TARGET_TYPE_UNIT && info.filter == TARGET_SCRIPT))
+        return;
+
+    WorldObject* caster = GetCastingObject();
+    if (!caster || !caster->GetMap()->IsLineOfSightCacheEnabled())
+        return;
+
+    std::vector<Position> dests;
+    dests.reserve(targets.size());
+    for (Unit* target : targets)
+        if (target != m_trueCaster && target->IsInMap(caster))
+            dests.emplace_back(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ() + target->GetCollisionHeight());
+
+    if (dests.size() < 2)
+        return;
+
+    std::unique_ptr<bool[]> results(new bool[dests.size()]);
+    caster->GetMap()->IsInLineOfSight(caster->GetPositionX(), caster->GetPositionY(), caster->GetPositionZ() + caster->GetCollisionHeight(),
+                                      dests.data(), results.get(), dests.size(), true);
+}
+
 bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception) const
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
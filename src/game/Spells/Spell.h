@@ -514,6 +514,7 @@ class Spell
         template<typename T> WorldObject* FindCorpseUsing();
 
         bool CheckTarget(Unit* target, SpellEffectIndex eff, bool targetB, CheckException exception = EXCEPTION_NONE) const;
+        void PrefetchTargetLineOfSight(UnitList const& targets, SpellEffectIndex eff, bool targetB, CheckException exception) const;
         bool CanAutoCast(Unit* target);
 
         static void SendCastResult(Player const* caster, SpellEntry const* spellInfo, SpellCastResult result, bool isPetCastResult = false, uint32 param1 = 0, uint32 param2 = 0);
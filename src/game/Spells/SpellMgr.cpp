@@ -27,6 +27,10 @@
 #include "Entities/Unit.h"
 #include "World/World.h"
 
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
 bool IsPrimaryProfessionSkill(uint32 skill)
 {
     SkillLineEntry const* pSkill = sSkillLineStore.LookupEntry(skill);
@@ -1708,6 +1712,7 @@ void SpellMgr::LoadSpellChains()
         if (node.req)
             mSpellChainsNext.insert(SpellChainMapNext::value_type(node.req, spell_id));
     }
+    mSpellChainsNext.Finalize();
 
     // check single rank redundant cases (single rank talents not added by default so this can be only custom cases)
     for (SpellChainMap::const_iterator i = mSpellChains.begin(); i != mSpellChains.end(); ++i)
@@ -2184,6 +2189,7 @@ void SpellMgr::LoadSpellAreas()
 {
     mSpellAreaMap.clear();                                  // need for reload case
     mSpellAreaForAuraMap.clear();
+    mSpellAreaForAreaMap.clear();
 
     uint32 count = 0;
 
@@ -2201,6 +2207,11 @@ void SpellMgr::LoadSpellAreas()
 
     BarGoLink bar(queryResult->GetRowCount());
 
+    // rows are checked against the rows loaded before them, the flat lookup tables are built once all are loaded
+    std::multimap<uint32, SpellArea> spellAreas;
+    std::multimap<uint32, SpellArea const*> spellAreasForAura;
+    std::vector<SpellArea const*> loadOrder;
+
     do
     {
         Field* fields = queryResult->Fetch();
@@ -2228,8 +2239,8 @@ void SpellMgr::LoadSpellAreas()
 
         {
             bool ok = true;
-            SpellAreaMapBounds sa_bounds = GetSpellAreaMapBounds(spellArea.spellId);
-            for (SpellAreaMap::const_iterator itr = sa_bounds.first; itr != sa_bounds.second; ++itr)
+            auto sa_bounds = spellAreas.equal_range(spellArea.spellId);
+            for (auto itr = sa_bounds.first; itr != sa_bounds.second; ++itr)
             {
                 if (spellArea.spellId != itr->second.spellId)
                     continue;
@@ -2340,8 +2351,8 @@ void SpellMgr::LoadSpellAreas()
             if (spellArea.autocast && spellArea.auraSpell > 0)
             {
                 bool chain = false;
-                SpellAreaForAuraMapBounds saBound = GetSpellAreaForAuraMapBounds(spellArea.spellId);
-                for (SpellAreaForAuraMap::const_iterator itr = saBound.first; itr != saBound.second; ++itr)
+                auto saBound = spellAreasForAura.equal_range(spellArea.spellId);
+                for (auto itr = saBound.first; itr != saBound.second; ++itr)
                 {
                     if (itr->second->autocast && itr->second->auraSpell > 0)
                     {
@@ -2356,8 +2367,8 @@ void SpellMgr::LoadSpellAreas()
                     continue;
                 }
 
-                SpellAreaMapBounds saBound2 = GetSpellAreaMapBounds(spellArea.auraSpell);
-                for (SpellAreaMap::const_iterator itr2 = saBound2.first; itr2 != saBound2.second; ++itr2)
+                auto saBound2 = spellAreas.equal_range(spellArea.auraSpell);
+                for (auto itr2 = saBound2.first; itr2 != saBound2.second; ++itr2)
                 {
                     if (itr2->second.autocast && itr2->second.auraSpell > 0)
                     {
@@ -2374,20 +2385,41 @@ void SpellMgr::LoadSpellAreas()
             }
         }
 
-        SpellArea const* sa = &mSpellAreaMap.insert(SpellAreaMap::value_type(spell, spellArea))->second;
-
-        // for search by current zone/subzone at zone/subzone change
-        if (spellArea.areaId)
-            mSpellAreaForAreaMap.insert(SpellAreaForAreaMap::value_type(spellArea.areaId, sa));
+        SpellArea const* sa = &spellAreas.insert(std::make_pair(spell, spellArea))->second;
 
-        // for search at aura apply
         if (spellArea.auraSpell)
-            mSpellAreaForAuraMap.insert(SpellAreaForAuraMap::value_type(abs(spellArea.auraSpell), sa));
+            spellAreasForAura.insert(std::make_pair(uint32(abs(spellArea.auraSpell)), sa));
 
+        loadOrder.push_back(sa);
         ++count;
     }
     while (queryResult->NextRow());
 
+    // same order as the loading multimap: by spell, rows of a spell in load order
+    for (auto const& itr : spellAreas)
+        mSpellAreaMap.insert(SpellAreaMap::value_type(itr.first, itr.second));
+    mSpellAreaMap.Finalize();
+
+    std::unordered_map<SpellArea const*, SpellArea const*> flatEntries;
+    SpellAreaMap::const_iterator flatItr = mSpellAreaMap.begin();
+    for (auto const& itr : spellAreas)
+        flatEntries[&itr.second] = &(flatItr++)->second;
+
+    for (SpellArea const* loaded : loadOrder)
+    {
+        SpellArea const* sa = flatEntries[loaded];
+
+        // for search by current zone/subzone at zone/subzone change
+        if (sa->areaId)
+            mSpellAreaForAreaMap.insert(SpellAreaForAreaMap::value_type(sa->areaId, sa));
+
+        // for search at aura apply
+        if (sa->auraSpell)
+            mSpellAreaForAuraMap.insert(SpellAreaForAuraMap::value_type(abs(sa->auraSpell), sa));
+    }
+    mSpellAreaForAreaMap.Finalize();
+    mSpellAreaForAuraMap.Finalize();
+
     sLog.outString(">> Loaded %u spell area requirements", count);
     sLog.outString();
 }
@@ -2442,6 +2474,75 @@ SpellCastResult SpellMgr::GetSpellAllowedInLocationError(SpellEntry const* spell
     return SPELL_CAST_OK;
 }
 
+template<class Key, class Value>
+static void BenchmarkLookupTable(std::ostringstream& report, char const* name, FlatMultiMap<Key, Value> const& flat, uint32 lookups)
+{
+    typedef std::multimap<Key, Value> TreeMap;
+    TreeMap const tree(flat.begin(), flat.end());
+
+    // lookups cycle through a fixed sample of keys, half of them stored keys, the other half random keys in the used range
+    uint32 const sampleSize = 4096;
+    std::vector<Key> keys;
+    keys.reserve(sampleSize);
+    Key const maxKey = flat.empty() ? Key(0) : (flat.end() - 1)->first;
+    for (uint32 i = 0; i < sampleSize; ++i)
+    {
+        if (i % 2 && !flat.empty())
+            keys.push_back((flat.begin() + urand(0, uint32(flat.size() - 1)))->first);
+        else
+            keys.push_back(Key(urand(0, uint32(maxKey) + 1)));
+    }
+
+    uint64 treeFound = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < lookups; ++i)
+    {
+        Key const key = keys[i % sampleSize];
+        std::pair<typename TreeMap::const_iterator, typename TreeMap::const_iterator> bounds = tree.equal_range(key);
+        for (typename TreeMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+            ++treeFound;
+    }
+    double const treeTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    uint64 flatFound = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < lookups; ++i)
+    {
+        Key const key = keys[i % sampleSize];
+        std::pair<typename FlatMultiMap<Key, Value>::const_iterator, typename FlatMultiMap<Key, Value>::const_iterator> bounds = flat.equal_range(key);
+        for (typename FlatMultiMap<Key, Value>::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+            ++flatFound;
+    }
+    double const flatTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // tree node: entry, parent/left/right pointers and color, allocator overhead not counted
+    size_t const treeBytes = tree.size() * (sizeof(typename TreeMap::value_type) + 3 * sizeof(void*) + sizeof(int));
+
+    report << name << ": " << flat.size() << " entries, multimap ~" << treeBytes / 1024.0 << " KB, flat " << flat.GetMemoryUsage() / 1024.0 << " KB, "
+           << "lookup multimap " << treeTime / lookups << " ns, flat " << flatTime / lookups << " ns";
+    if (treeFound != flatFound)
+        report << " (RESULTS DIFFER: " << treeFound << " / " << flatFound << ")";
+    report << "\n";
+}
+
+std::string SpellMgr::BenchmarkLookupTables(uint32 lookups) const
+{
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Spell lookup tables, " << lookups << " lookups each:\n";
+    BenchmarkLookupTable(report, "SkillLineAbility by spell", mSkillLineAbilityMapBySpellId, lookups);
+    BenchmarkLookupTable(report, "SkillLineAbility by skill", mSkillLineAbilityMapBySkillId, lookups);
+    BenchmarkLookupTable(report, "SkillRaceClassInfo", mSkillRaceClassInfoMap, lookups);
+    BenchmarkLookupTable(report, "SpellChain next", mSpellChainsNext, lookups);
+    BenchmarkLookupTable(report, "SpellArea", mSpellAreaMap, lookups);
+    BenchmarkLookupTable(report, "SpellArea for aura", mSpellAreaForAuraMap, lookups);
+    BenchmarkLookupTable(report, "SpellArea for area", mSpellAreaForAreaMap, lookups);
+
+    std::string result = report.str();
+    result.pop_back();
+    return result;
+}
+
 void SpellMgr::LoadSkillLineAbilityMaps()
 {
     mSkillLineAbilityMapBySpellId.clear();
@@ -2461,6 +2562,8 @@ void SpellMgr::LoadSkillLineAbilityMaps()
             ++count;
         }
     }
+    mSkillLineAbilityMapBySpellId.Finalize();
+    mSkillLineAbilityMapBySkillId.Finalize();
 
     sLog.outString(">> Loaded %u SkillLineAbility MultiMaps Data", count);
     sLog.outString();
@@ -2488,6 +2591,7 @@ void SpellMgr::LoadSkillRaceClassInfoMap()
 
         ++count;
     }
+    mSkillRaceClassInfoMap.Finalize();
 
     sLog.outString(">> Loaded %u SkillRaceClassInfo MultiMap Data", count);
     sLog.outString();
@@ -36,6 +36,7 @@
 #include "Spells/SpellAuras.h"
 #include "Server/SQLStorages.h"
 #include "Spells/SpellEffectDefines.h"
+#include "Util/FlatMultiMap.h"
 
 #include <map>
 
@@ -2216,9 +2217,9 @@ struct SpellArea
     void ApplyOrRemoveSpellIfCan(Player* player, uint32 newZone, uint32 newArea, bool onlyApply) const;
 };
 
-typedef std::multimap<uint32 /*applySpellId*/, SpellArea> SpellAreaMap;
-typedef std::multimap<uint32 /*auraSpellId*/, SpellArea const*> SpellAreaForAuraMap;
-typedef std::multimap<uint32 /*areaOrZoneId*/, SpellArea const*> SpellAreaForAreaMap;
+typedef FlatMultiMap<uint32 /*applySpellId*/, SpellArea> SpellAreaMap;
+typedef FlatMultiMap<uint32 /*auraSpellId*/, SpellArea const*> SpellAreaForAuraMap;
+typedef FlatMultiMap<uint32 /*areaOrZoneId*/, SpellArea const*> SpellAreaForAreaMap;
 typedef std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> SpellAreaMapBounds;
 typedef std::pair<SpellAreaForAuraMap::const_iterator, SpellAreaForAuraMap::const_iterator>  SpellAreaForAuraMapBounds;
 typedef std::pair<SpellAreaForAreaMap::const_iterator, SpellAreaForAreaMap::const_iterator>  SpellAreaForAreaMapBounds;
@@ -2234,7 +2235,7 @@ struct SpellChainNode
 };
 
 typedef std::unordered_map<uint32, SpellChainNode> SpellChainMap;
-typedef std::multimap<uint32, uint32> SpellChainMapNext;
+typedef FlatMultiMap<uint32, uint32> SpellChainMapNext;
 
 // Spell learning properties (accessed using SpellMgr functions)
 struct SpellLearnSkillNode
@@ -2256,10 +2257,10 @@ struct SpellLearnSpellNode
 typedef std::multimap<uint32, SpellLearnSpellNode> SpellLearnSpellMap;
 typedef std::pair<SpellLearnSpellMap::const_iterator, SpellLearnSpellMap::const_iterator> SpellLearnSpellMapBounds;
 
-typedef std::multimap<uint32, SkillLineAbilityEntry const*> SkillLineAbilityMap;
+typedef FlatMultiMap<uint32, SkillLineAbilityEntry const*> SkillLineAbilityMap;
 typedef std::pair<SkillLineAbilityMap::const_iterator, SkillLineAbilityMap::const_iterator> SkillLineAbilityMapBounds;
 
-typedef std::multimap<uint32, SkillRaceClassInfoEntry const*> SkillRaceClassInfoMap;
+typedef FlatMultiMap<uint32, SkillRaceClassInfoEntry const*> SkillRaceClassInfoMap;
 typedef std::pair<SkillRaceClassInfoMap::const_iterator, SkillRaceClassInfoMap::const_iterator> SkillRaceClassInfoMapBounds;
 
 bool IsPrimaryProfessionSkill(uint32 skill);
@@ -2833,6 +2834,9 @@ class SpellMgr
             return mSpellAreaForAreaMap.equal_range(area_id);
         }
 
+        // compares the flat lookup tables with std::multimap copies of them, for .debug spellmapbench
+        std::string BenchmarkLookupTables(uint32 lookups) const;
+
         // Modifiers
     public:
         static SpellMgr& Instance();
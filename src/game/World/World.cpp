@@ -161,6 +161,10 @@ World::~World()
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
+    // the queue threads sleep until they get a message, wake them up to see the shutdown
+    m_lfgQueue.GetMessager().Interrupt();
+    m_bgQueue.GetMessager().Interrupt();
+
     if (m_lfgQueueThread.joinable())
         m_lfgQueueThread.join();
     if (m_bgQueueThread.joinable())
@@ -173,10 +177,12 @@ void World::CleanupsBeforeStop()
 #ifdef ENABLE_PLAYERBOTS
     sRandomPlayerbotMgr.LogoutAllBots();
 #endif
+    sLootMgr.StopDropStats();                        // drop simulations post their results to sessions and the world messager
     KickAll(true);                                   // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
     sMapMgr.UnloadAll();                             // unload all grids (including locked in memory)
+    sMapPersistentStateMgr.SaveAllRespawnTimes();    // states without a loaded map can still hold unsaved respawn times
 }
 
 /// Find a session by its id
@@ -622,6 +628,20 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_BOOL_LOCKFREE_OBJECT_LOOKUP, "ObjectAccessor.LockFreeLookup", true);
+    HashMapHolder<Player>::SetLockFreeLookup(getConfig(CONFIG_BOOL_LOCKFREE_OBJECT_LOOKUP));
+    HashMapHolder<Corpse>::SetLockFreeLookup(getConfig(CONFIG_BOOL_LOCKFREE_OBJECT_LOOKUP));
+    setConfig(CONFIG_BOOL_MAP_UPDATE_LOD, "MapUpdate.LOD.Enable", false);
+    setConfigMin(CONFIG_FLOAT_MAP_UPDATE_LOD_FULL_RANGE, "MapUpdate.LOD.FullRange", 200.0f, 10.0f);
+    setConfigMin(CONFIG_FLOAT_MAP_UPDATE_LOD_COARSE_RANGE, "MapUpdate.LOD.CoarseRange", 533.0f, 10.0f);
+    setConfigMin(CONFIG_UINT32_MAP_UPDATE_LOD_COARSE_INTERVAL, "MapUpdate.LOD.CoarseInterval", 1000, 100);
+    setConfigMin(CONFIG_UINT32_MAP_UPDATE_LOD_FAR_INTERVAL, "MapUpdate.LOD.FarInterval", 10000, 100);
+    setConfig(CONFIG_UINT32_MAP_UPDATE_LOD_BUDGET, "MapUpdate.LOD.Budget", 0);
+
+    setConfig(CONFIG_BOOL_MOVEMENT_RELAY_SHAPING, "MovementRelay.Enable", false);
+    setConfig(CONFIG_FLOAT_MOVEMENT_RELAY_FULL_RANGE, "MovementRelay.FullRange", 40.0f);
+    setConfigMin(CONFIG_UINT32_MOVEMENT_RELAY_INTERVAL, "MovementRelay.Interval", 1000, 100);
+    setConfig(CONFIG_UINT32_MOVEMENT_RELAY_BUDGET, "MovementRelay.Budget", 0);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -647,6 +667,9 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
+    setConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_INTERVAL, "SaveRespawnTimeInterval", 10 * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_CHARACTER_PREFETCH_CACHE_SIZE, "CharacterPrefetch.CacheSize", 0);
+    setConfig(CONFIG_UINT32_CHARACTER_PREFETCH_TIMEOUT, "CharacterPrefetch.Timeout", 60);
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
     setConfig(CONFIG_BOOL_ALWAYS_MAX_SKILL_FOR_LEVEL, "AlwaysMaxSkillForLevel", false);
@@ -813,6 +836,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
+    setConfig(CONFIG_BOOL_VMAP_LOS_CACHE, "vmap.enableLOSCache", false);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
 
@@ -835,6 +859,9 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_UINT32_NUM_PATHFINDER_THREADS, "PathFinder.Threads", 0);
+    setConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 0);
+    MMAP::MMapFactory::createOrGetMMapManager()->SetPathCacheSize(getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE));
 
     sLog.outString();
 }
@@ -1600,6 +1627,9 @@ void World::Update(uint32 diff)
         LoginDatabase.PExecute("UPDATE uptime SET uptime = %u, maxplayers = %u WHERE realmid = %u AND starttime = " UI64FMTD, tmpDiff, maxClientsNum, realmID, uint64(m_startTime));
     }
 
+    /// <li> Publish players and corpses added or removed this tick to lock-free lookups
+    ObjectAccessor::PublishLookupSnapshots();
+
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
 #ifdef BUILD_METRICS
@@ -141,6 +141,13 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_MAP_UPDATE_LOD_COARSE_INTERVAL,
+    CONFIG_UINT32_MAP_UPDATE_LOD_FAR_INTERVAL,
+    CONFIG_UINT32_MAP_UPDATE_LOD_BUDGET,
+    CONFIG_UINT32_MOVEMENT_RELAY_INTERVAL,
+    CONFIG_UINT32_MOVEMENT_RELAY_BUDGET,
+    CONFIG_UINT32_NUM_PATHFINDER_THREADS,
+    CONFIG_UINT32_PATH_FIND_CACHE_SIZE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -199,6 +206,9 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY,
     CONFIG_UINT32_CHANNEL_STATIC_AUTO_TRESHOLD,
     CONFIG_UINT32_LFG_MATCHMAKING_TIMER,
+    CONFIG_UINT32_SAVE_RESPAWN_TIME_INTERVAL,
+    CONFIG_UINT32_CHARACTER_PREFETCH_CACHE_SIZE,
+    CONFIG_UINT32_CHARACTER_PREFETCH_TIMEOUT,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -284,6 +294,9 @@ enum eConfigFloatValues
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
     CONFIG_FLOAT_LEASH_RADIUS,
+    CONFIG_FLOAT_MAP_UPDATE_LOD_FULL_RANGE,
+    CONFIG_FLOAT_MAP_UPDATE_LOD_COARSE_RANGE,
+    CONFIG_FLOAT_MOVEMENT_RELAY_FULL_RANGE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -349,6 +362,10 @@ enum eConfigBoolValues
     CONFIG_BOOL_AUTOLOAD_ACTIVE,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_VMAP_LOS_CACHE,
+    CONFIG_BOOL_LOCKFREE_OBJECT_LOOKUP,
+    CONFIG_BOOL_MAP_UPDATE_LOD,
+    CONFIG_BOOL_MOVEMENT_RELAY_SHAPING,
     CONFIG_BOOL_LFG_MATCHMAKING,
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
     CONFIG_BOOL_DISABLE_INSTANCE_RELOCATE,
@@ -591,6 +608,7 @@ class World
         }
 
         Messager<World>& GetMessager() { return m_messager; }
+        LatencyStats& GetLoginLatency() { return m_loginLatency; }    // character login request to in world, in milliseconds
 
         void IncrementOpcodeCounter(uint32 opcodeId); // thread safe due to atomics
 
@@ -713,6 +731,7 @@ class World
 #endif
 
         Messager<World> m_messager;
+        LatencyStats m_loginLatency;
 
         // Opcode logging
         std::vector<std::atomic<uint32>> m_opcodeCounters;
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 
 #define MAX_STACK_SIZE 64
 
@@ -56,6 +57,13 @@ static inline float intBitsToFloat(uint32 i)
     return temp.fval;
 }
 
+// ray callbacks may implement intersectLeaf(ray, entries, count, maxDist, stopAtFirst) to test a whole leaf at once
+template<typename T, typename = void>
+struct HasLeafIntersect : std::false_type {};
+
+template<typename T>
+struct HasLeafIntersect<T, std::void_t<decltype(&T::intersectLeaf)>> : std::true_type {};
+
 struct AABound
 {
     Vector3 lo, hi;
@@ -219,12 +227,20 @@ class BIH
                         {
                             // leaf - test some objects
                             int n = tree[node + 1];
-                            while (n > 0)
+                            if constexpr (HasLeafIntersect<RayCallback>::value)
                             {
-                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst, ignoreM2Model);
-                                if (stopAtFirst && hit) return;
-                                --n;
-                                ++offset;
+                                if (n > 0 && intersectCallback.intersectLeaf(r, &objects[offset], n, maxDist, stopAtFirst) && stopAtFirst)
+                                    return;
+                            }
+                            else
+                            {
+                                while (n > 0)
+                                {
+                                    bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst, ignoreM2Model);
+                                    if (stopAtFirst && hit) return;
+                                    --n;
+                                    ++offset;
+                                }
                             }
                             break;
                         }
@@ -264,6 +264,17 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, Vector3 const* dests, bool* results, uint32 count, bool ignoreM2Model) const
+{
+    // nothing to collide with - skip ray setup entirely
+    if (!size())
+        return;
+
+    for (uint32 i = 0; i < count; ++i)
+        if (results[i])
+            results[i] = isInLineOfSight(x1, y1, z1, dests[i].x, dests[i].y, dests[i].z, ignoreM2Model);
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist) const
 {
     Vector3 v(x, y, z);
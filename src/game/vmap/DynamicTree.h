@@ -35,6 +35,8 @@ class DynamicMapTree
         ~DynamicMapTree();
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) const;
+        // only destinations with results[i] == true are tested
+        void isInLineOfSight(float x1, float y1, float z1, G3D::Vector3 const* dests, bool* results, uint32 count, bool ignoreM2Model) const;
         bool getIntersectionTime(const G3D::Ray& ray, const G3D::Vector3& endPos, float& maxDist) const;
         bool getObjectHitPos(const G3D::Vector3& pPos1, const G3D::Vector3& pPos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
         bool getObjectHitPos(float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float pModifyDist) const;
@@ -20,6 +20,7 @@
 #include "VMapManager2.h"
 #include "VMapDefinitions.h"
 #include "WorldModel.h"
+#include "RayIntersection.h"
 
 #include "Entities//GameObject.h"
 #include "World/World.h"
@@ -146,6 +147,9 @@ bool GameObjectModel::intersectRay(const G3D::Ray& ray, float& MaxDist, bool Sto
     if (!collision_enabled)
         return false;
 
+    if (!VMAP::RayMayHitBox(ray, iBound))
+        return false;
+
     float time = ray.intersectionTime(iBound);
     if (time == G3D::inf())
         return false;
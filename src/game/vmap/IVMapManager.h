@@ -23,6 +23,11 @@
 #include <Platform/Define.h>
 #include <vector>
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -64,6 +69,11 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) = 0;
+            /**
+            test one source against count destinations (world coords). Only destinations with results[i] == true are tested,
+            blocked ones get results[i] = false
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, G3D::Vector3 const* dests, bool* results, uint32 count, bool ignoreM2Model) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
@@ -20,6 +20,7 @@
 #include "WorldModel.h"
 #include "MapTree.h"
 #include "VMapDefinitions.h"
+#include "RayIntersection.h"
 
 using G3D::Vector3;
 using G3D::Ray;
@@ -41,6 +42,8 @@ namespace VMAP
 #endif
             return false;
         }
+        if (!RayMayHitBox(pRay, iBound))
+            return false;
         float time = pRay.intersectionTime(iBound);
         if (time == G3D::inf())
         {
@@ -0,0 +1,418 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "RayIntersection.h"
+#include "WorldModel.h"
+
+#include <G3D/Ray.h>
+#include <G3D/AABox.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VMAP_X86_KERNELS
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// kernels are built for their instruction set regardless of compiler flags and only selected at runtime
+#if defined(__GNUC__) || defined(__clang__)
+#define VMAP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define VMAP_TARGET(isa)
+#endif
+
+using G3D::Vector3;
+using G3D::Ray;
+using G3D::AABox;
+
+namespace VMAP
+{
+    static const float TRIANGLE_EPS = 1e-5f;
+    static const float BOX_MARGIN = 0.05f;                  // well above float rounding of vmap coords, keeps the box test conservative
+
+    // See RTR2 ch. 13.7 for the algorithm.
+    // The packed kernels below repeat every operation in the same order, keep them in sync
+    static bool IntersectTriangle(const MeshTriangle& tri, const Vector3* points, const Ray& ray, float& distance)
+    {
+        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
+        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
+        const Vector3 p(ray.direction().cross(e2));
+        const float a = e1.dot(p);
+
+        if (fabs(a) < TRIANGLE_EPS)
+        {
+            // Determinant is ill-conditioned; abort early
+            return false;
+        }
+
+        const float f = 1.0f / a;
+        const Vector3 s(ray.origin() - points[tri.idx0]);
+        const float u = f * s.dot(p);
+
+        if ((u < 0.0f) || (u > 1.0f))
+        {
+            // We hit the plane of the m_geometry, but outside the m_geometry
+            return false;
+        }
+
+        const Vector3 q(s.cross(e1));
+        const float v = f * ray.direction().dot(q);
+
+        if ((v < 0.0f) || ((u + v) > 1.0f))
+        {
+            // We hit the plane of the triangle, but outside the triangle
+            return false;
+        }
+
+        const float t = f * e2.dot(q);
+
+        if ((t > 0.0f) && (t < distance))
+        {
+            // This is a new hit, closer than the previous one
+            distance = t;
+            return true;
+        }
+        // This hit is after the previous hit, so ignore it
+        return false;
+    }
+
+    static bool IntersectTrianglesScalar(const Ray& ray, const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit)
+    {
+        bool hit = false;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (IntersectTriangle(triangles[indices[i]], vertices, ray, distance))
+            {
+                hit = true;
+                if (stopAtFirstHit)
+                    break;
+            }
+        }
+        return hit;
+    }
+
+    static bool RayMayHitBoxScalar(const Ray& /*ray*/, const AABox& /*box*/)
+    {
+        return true;                                        // no prefilter, callers do the exact test
+    }
+
+#ifdef VMAP_X86_KERNELS
+    // applies the lanes accepted by the packed test in triangle order, same as the scalar loop would
+    static inline bool ApplyLaneHits(int acceptMask, const float* t, uint32 lanes, float& distance, bool stopAtFirstHit, bool& hit)
+    {
+        for (uint32 l = 0; l < lanes; ++l)
+        {
+            if ((acceptMask & (1 << l)) && t[l] < distance)
+            {
+                distance = t[l];
+                hit = true;
+                if (stopAtFirstHit)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // unused tail lanes repeat the first triangle, their results are masked out by ApplyLaneHits
+    template<uint32 Width>
+    static inline void GatherTriangles(const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 lanes, float (&out)[9][Width])
+    {
+        for (uint32 l = 0; l < Width; ++l)
+        {
+            const MeshTriangle& tri = triangles[indices[l < lanes ? l : 0]];
+            const Vector3& v0 = vertices[tri.idx0];
+            const Vector3& v1 = vertices[tri.idx1];
+            const Vector3& v2 = vertices[tri.idx2];
+            out[0][l] = v0.x; out[1][l] = v0.y; out[2][l] = v0.z;
+            out[3][l] = v1.x; out[4][l] = v1.y; out[5][l] = v1.z;
+            out[6][l] = v2.x; out[7][l] = v2.y; out[8][l] = v2.z;
+        }
+    }
+
+    VMAP_TARGET("sse2")
+    static bool IntersectTrianglesSSE(const Ray& ray, const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit)
+    {
+        const Vector3& org = ray.origin();
+        const Vector3& dir = ray.direction();
+        const __m128 ox = _mm_set1_ps(org.x), oy = _mm_set1_ps(org.y), oz = _mm_set1_ps(org.z);
+        const __m128 dx = _mm_set1_ps(dir.x), dy = _mm_set1_ps(dir.y), dz = _mm_set1_ps(dir.z);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 eps = _mm_set1_ps(TRIANGLE_EPS);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        bool hit = false;
+        for (uint32 base = 0; base < count; base += 4)
+        {
+            uint32 lanes = std::min<uint32>(4, count - base);
+            alignas(16) float packed[9][4];
+            GatherTriangles<4>(vertices, triangles, indices + base, lanes, packed);
+
+            const __m128 v0x = _mm_load_ps(packed[0]), v0y = _mm_load_ps(packed[1]), v0z = _mm_load_ps(packed[2]);
+            const __m128 e1x = _mm_sub_ps(_mm_load_ps(packed[3]), v0x);
+            const __m128 e1y = _mm_sub_ps(_mm_load_ps(packed[4]), v0y);
+            const __m128 e1z = _mm_sub_ps(_mm_load_ps(packed[5]), v0z);
+            const __m128 e2x = _mm_sub_ps(_mm_load_ps(packed[6]), v0x);
+            const __m128 e2y = _mm_sub_ps(_mm_load_ps(packed[7]), v0y);
+            const __m128 e2z = _mm_sub_ps(_mm_load_ps(packed[8]), v0z);
+
+            // p = dir x e2, a = e1 . p
+            const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            __m128 reject = _mm_cmplt_ps(_mm_and_ps(a, absMask), eps);
+
+            const __m128 f = _mm_div_ps(one, a);
+            const __m128 sx = _mm_sub_ps(ox, v0x), sy = _mm_sub_ps(oy, v0y), sz = _mm_sub_ps(oz, v0z);
+            const __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+            reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(u, zero), _mm_cmpgt_ps(u, one)));
+
+            // q = s x e1
+            const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+            const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+            const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+            const __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+            reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(v, zero), _mm_cmpgt_ps(_mm_add_ps(u, v), one)));
+
+            const __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+            int acceptMask = _mm_movemask_ps(_mm_andnot_ps(reject, _mm_cmpgt_ps(t, zero)));
+            if (!acceptMask)
+                continue;
+
+            alignas(16) float times[4];
+            _mm_store_ps(times, t);
+            if (ApplyLaneHits(acceptMask, times, lanes, distance, stopAtFirstHit, hit))
+                return true;
+        }
+        return hit;
+    }
+
+    VMAP_TARGET("avx")
+    static bool IntersectTrianglesAVX(const Ray& ray, const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit)
+    {
+        // short leaves do not fill 8 lanes, not worth the wider gather
+        if (count <= 4)
+            return IntersectTrianglesSSE(ray, vertices, triangles, indices, count, distance, stopAtFirstHit);
+
+        const Vector3& org = ray.origin();
+        const Vector3& dir = ray.direction();
+        const __m256 ox = _mm256_set1_ps(org.x), oy = _mm256_set1_ps(org.y), oz = _mm256_set1_ps(org.z);
+        const __m256 dx = _mm256_set1_ps(dir.x), dy = _mm256_set1_ps(dir.y), dz = _mm256_set1_ps(dir.z);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 eps = _mm256_set1_ps(TRIANGLE_EPS);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+        bool hit = false;
+        for (uint32 base = 0; base < count; base += 8)
+        {
+            uint32 lanes = std::min<uint32>(8, count - base);
+            alignas(32) float packed[9][8];
+            GatherTriangles<8>(vertices, triangles, indices + base, lanes, packed);
+
+            const __m256 v0x = _mm256_load_ps(packed[0]), v0y = _mm256_load_ps(packed[1]), v0z = _mm256_load_ps(packed[2]);
+            const __m256 e1x = _mm256_sub_ps(_mm256_load_ps(packed[3]), v0x);
+            const __m256 e1y = _mm256_sub_ps(_mm256_load_ps(packed[4]), v0y);
+            const __m256 e1z = _mm256_sub_ps(_mm256_load_ps(packed[5]), v0z);
+            const __m256 e2x = _mm256_sub_ps(_mm256_load_ps(packed[6]), v0x);
+            const __m256 e2y = _mm256_sub_ps(_mm256_load_ps(packed[7]), v0y);
+            const __m256 e2z = _mm256_sub_ps(_mm256_load_ps(packed[8]), v0z);
+
+            const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+            const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+            const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+            const __m256 a = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+            __m256 reject = _mm256_cmp_ps(_mm256_and_ps(a, absMask), eps, _CMP_LT_OQ);
+
+            const __m256 f = _mm256_div_ps(one, a);
+            const __m256 sx = _mm256_sub_ps(ox, v0x), sy = _mm256_sub_ps(oy, v0y), sz = _mm256_sub_ps(oz, v0z);
+            const __m256 u = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)));
+            reject = _mm256_or_ps(reject, _mm256_or_ps(_mm256_cmp_ps(u, zero, _CMP_LT_OQ), _mm256_cmp_ps(u, one, _CMP_GT_OQ)));
+
+            const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+            const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+            const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+            const __m256 v = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)));
+            reject = _mm256_or_ps(reject, _mm256_or_ps(_mm256_cmp_ps(v, zero, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_GT_OQ)));
+
+            const __m256 t = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)));
+            int acceptMask = _mm256_movemask_ps(_mm256_andnot_ps(reject, _mm256_cmp_ps(t, zero, _CMP_GT_OQ)));
+            if (!acceptMask)
+                continue;
+
+            alignas(32) float times[8];
+            _mm256_store_ps(times, t);
+            if (ApplyLaneHits(acceptMask, times, lanes, distance, stopAtFirstHit, hit))
+                return true;
+        }
+        return hit;
+    }
+
+    // slab test on x/y/z lanes, w lane is an infinite slab
+    VMAP_TARGET("sse2")
+    static bool RayMayHitBoxSSE(const Ray& ray, const AABox& box)
+    {
+        const Vector3& org = ray.origin();
+        const Vector3& dir = ray.direction();
+        const Vector3& low = box.low();
+        const Vector3& high = box.high();
+
+        const __m128 margin = _mm_set1_ps(BOX_MARGIN);
+        const __m128 o = _mm_set_ps(0.0f, org.z, org.y, org.x);
+        const __m128 invDir = _mm_div_ps(_mm_set1_ps(1.0f), _mm_set_ps(1.0f, dir.z, dir.y, dir.x));
+        const __m128 lo = _mm_sub_ps(_mm_set_ps(-FLT_MAX, low.z, low.y, low.x), margin);
+        const __m128 hi = _mm_add_ps(_mm_set_ps(FLT_MAX, high.z, high.y, high.x), margin);
+
+        // axis parallel rays give +-inf, or NaN exactly on the inflated plane where min/max pick the other operand
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(lo, o), invDir);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(hi, o), invDir);
+        __m128 tNear = _mm_min_ps(t1, t2);
+        __m128 tFar = _mm_max_ps(t1, t2);
+
+        tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(2, 3, 0, 1)));
+        tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 0, 3, 2)));
+        tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(2, 3, 0, 1)));
+        tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        float nearTime = _mm_cvtss_f32(tNear);
+        float farTime = _mm_cvtss_f32(tFar);
+        return !(farTime < 0.0f || nearTime > farTime);
+    }
+
+    static bool CpuSupportsSSE()
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true;                                        // part of x86-64
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+
+    static bool CpuSupportsAVX()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        // cpu support plus OS saving ymm state
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx");
+#endif
+    }
+#endif
+
+    typedef bool (*TrianglesKernelFunc)(const Ray& ray, const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit);
+    typedef bool (*BoxKernelFunc)(const Ray& ray, const AABox& box);
+
+    struct RayKernelFuncs
+    {
+        TrianglesKernelFunc triangles;
+        BoxKernelFunc box;
+    };
+
+    static RayKernelFuncs GetKernelFuncs(RayKernel kernel)
+    {
+        switch (kernel)
+        {
+#ifdef VMAP_X86_KERNELS
+            case RAY_KERNEL_SSE: return { &IntersectTrianglesSSE, &RayMayHitBoxSSE };
+            case RAY_KERNEL_AVX: return { &IntersectTrianglesAVX, &RayMayHitBoxSSE };
+#endif
+            default: return { &IntersectTrianglesScalar, &RayMayHitBoxScalar };
+        }
+    }
+
+    static std::atomic<RayKernel> s_rayKernel(GetBestRayKernel());
+    static std::atomic<TrianglesKernelFunc> s_trianglesKernel(GetKernelFuncs(s_rayKernel).triangles);
+    static std::atomic<BoxKernelFunc> s_boxKernel(GetKernelFuncs(s_rayKernel).box);
+
+    bool IntersectTriangles(const Ray& ray, const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit)
+    {
+        return s_trianglesKernel.load(std::memory_order_relaxed)(ray, vertices, triangles, indices, count, distance, stopAtFirstHit);
+    }
+
+    bool RayMayHitBox(const Ray& ray, const AABox& box)
+    {
+        return s_boxKernel.load(std::memory_order_relaxed)(ray, box);
+    }
+
+    bool IntersectTrianglesWith(RayKernel kernel, const Ray& ray, const Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit)
+    {
+        return GetKernelFuncs(kernel).triangles(ray, vertices, triangles, indices, count, distance, stopAtFirstHit);
+    }
+
+    bool RayMayHitBoxWith(RayKernel kernel, const Ray& ray, const AABox& box)
+    {
+        return GetKernelFuncs(kernel).box(ray, box);
+    }
+
+    RayKernel GetRayKernel()
+    {
+        return s_rayKernel;
+    }
+
+    RayKernel GetBestRayKernel()
+    {
+#ifdef VMAP_X86_KERNELS
+        if (CpuSupportsAVX())
+            return RAY_KERNEL_AVX;
+        if (CpuSupportsSSE())
+            return RAY_KERNEL_SSE;
+#endif
+        return RAY_KERNEL_SCALAR;
+    }
+
+    bool SetRayKernel(RayKernel kernel)
+    {
+        if (kernel >= MAX_RAY_KERNEL || kernel > GetBestRayKernel())
+            return false;
+
+        // all kernels give the same results, so other threads may switch mid query
+        RayKernelFuncs funcs = GetKernelFuncs(kernel);
+        s_trianglesKernel = funcs.triangles;
+        s_boxKernel = funcs.box;
+        s_rayKernel = kernel;
+        return true;
+    }
+
+    char const* GetRayKernelName(RayKernel kernel)
+    {
+        switch (kernel)
+        {
+            case RAY_KERNEL_SCALAR: return "scalar";
+            case RAY_KERNEL_SSE:    return "sse";
+            case RAY_KERNEL_AVX:    return "avx";
+            default:                return "unknown";
+        }
+    }
+}
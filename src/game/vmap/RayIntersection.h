@@ -0,0 +1,65 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _RAY_INTERSECTION_H
+#define _RAY_INTERSECTION_H
+
+#include <Platform/Define.h>
+
+namespace G3D
+{
+    class Vector3;
+    class Ray;
+    class AABox;
+}
+
+namespace VMAP
+{
+    class MeshTriangle;
+
+    enum RayKernel
+    {
+        RAY_KERNEL_SCALAR   = 0,                            // one triangle per test, no box prefilter
+        RAY_KERNEL_SSE      = 1,                            // 4 triangles per test
+        RAY_KERNEL_AVX      = 2,                            // 8 triangles per test
+        MAX_RAY_KERNEL
+    };
+
+    /**
+    Tests the triangles triangles[indices[0..count-1]] (one BIH leaf) against the ray, in order.
+    Gives bitwise the same distance/hit as calling IntersectTriangle for each index, whatever kernel is active.
+    */
+    bool IntersectTriangles(const G3D::Ray& ray, const G3D::Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit);
+
+    /**
+    Conservative ray/box slab test, returns false only if the ray can not hit the (slightly inflated) box.
+    Used to skip the exact but slow G3D::Ray::intersectionTime for misses.
+    */
+    bool RayMayHitBox(const G3D::Ray& ray, const G3D::AABox& box);
+
+    // same as above with the given kernel instead of the active one, lets benchmarks compare kernels without switching them for other threads
+    bool IntersectTrianglesWith(RayKernel kernel, const G3D::Ray& ray, const G3D::Vector3* vertices, const MeshTriangle* triangles, const uint32* indices, uint32 count, float& distance, bool stopAtFirstHit);
+    bool RayMayHitBoxWith(RayKernel kernel, const G3D::Ray& ray, const G3D::AABox& box);
+
+    RayKernel GetRayKernel();
+    RayKernel GetBestRayKernel();                           // best kernel supported by this cpu
+    bool SetRayKernel(RayKernel kernel);                    // false if not supported by this cpu/build
+    char const* GetRayKernelName(RayKernel kernel);
+}
+
+#endif
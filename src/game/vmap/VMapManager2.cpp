@@ -200,6 +200,28 @@ namespace VMAP
         }
         return result;
     }
+
+    void VMapManager2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, Vector3 const* dests, bool* results, uint32 count, bool ignoreM2Model)
+    {
+        if (!isLineOfSightCalcEnabled())
+            return;
+
+        // map tree lookup and source conversion are shared by all rays
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (!results[i])
+                continue;
+
+            Vector3 pos2 = convertPositionToInternalRep(dests[i].x, dests[i].y, dests[i].z);
+            if (pos1 != pos2)
+                results[i] = instanceTree->second->isInLineOfSight(pos1, pos2, ignoreM2Model);
+        }
+    }
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -20,6 +20,7 @@
 #include "VMapDefinitions.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
+#include "RayIntersection.h"
 #include <string.h>
 
 using G3D::Vector3;
@@ -32,59 +33,6 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle& tri, std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, float& distance)
-    {
-        static const float EPS = 1e-5f;
-
-        // See RTR2 ch. 13.7 for the algorithm.
-
-        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
-        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
-        const Vector3 p(ray.direction().cross(e2));
-        const float a = e1.dot(p);
-
-        if (fabs(a) < EPS)
-        {
-            // Determinant is ill-conditioned; abort early
-            return false;
-        }
-
-        const float f = 1.0f / a;
-        const Vector3 s(ray.origin() - points[tri.idx0]);
-        const float u = f * s.dot(p);
-
-        if ((u < 0.0f) || (u > 1.0f))
-        {
-            // We hit the plane of the m_geometry, but outside the m_geometry
-            return false;
-        }
-
-        const Vector3 q(s.cross(e1));
-        const float v = f * ray.direction().dot(q);
-
-        if ((v < 0.0f) || ((u + v) > 1.0f))
-        {
-            // We hit the plane of the triangle, but outside the triangle
-            return false;
-        }
-
-        const float t = f * e2.dot(q);
-
-        if ((t > 0.0f) && (t < distance))
-        {
-            // This is a new hit, closer than the previous one
-            distance = t;
-
-            /* baryCoord[0] = 1.0 - u - v;
-            baryCoord[1] = u;
-            baryCoord[2] = v; */
-
-            return true;
-        }
-        // This hit is after the previous hit, so ignore it
-        return false;
-    }
-
     class TriBoundFunc
     {
         public:
@@ -355,15 +303,16 @@ namespace VMAP
     struct GModelRayCallback
     {
         GModelRayCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
-        bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/, bool /*ignoreM2Model*/)
+            vertices(vert.data()), triangles(tris.data()), hit(false) {}
+        // BIH hands over whole leaves, so the triangles can be tested in packets
+        bool intersectLeaf(const G3D::Ray& ray, const uint32* entries, uint32 count, float& distance, bool pStopAtFirstHit)
         {
-            bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
-            if (result)  hit = true;
+            if (IntersectTriangles(ray, vertices, triangles, entries, count, distance, pStopAtFirstHit))
+                hit = true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        const Vector3* vertices;
+        const MeshTriangle* triangles;
         bool hit;
     };
 
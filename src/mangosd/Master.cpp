@@ -367,6 +367,7 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nLoaderConnections = sConfig.GetIntDefault("CharacterDatabaseLoaderConnections", 4);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -375,10 +376,10 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + nLoaderConnections + 1);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nLoaderConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
@@ -98,7 +98,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nLoaderConns /*= 0*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -140,6 +140,19 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     if (!m_pAsyncConn->Initialize(infoString))
         return false;
 
+    // create connections for the query holder loaders
+    for (int i = 0; i < std::min(nLoaderConns, MAX_CONNECTION_POOL_SIZE); ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_holderConnections.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -160,6 +173,11 @@ void Database::StopServer()
         delete m_pQueryConnection;
 
     m_pQueryConnections.clear();
+
+    for (auto& holderConnection : m_holderConnections)
+        delete holderConnection;
+
+    m_holderConnections.clear();
 }
 
 SqlDelayThread* Database::CreateDelayThread()
@@ -175,6 +193,12 @@ void Database::InitDelayThread()
     // New delay thread for delay execute
     m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
     m_delayThread = new MaNGOS::Thread(m_threadBody);
+
+    for (auto& holderConnection : m_holderConnections)
+    {
+        m_holderLoaders.push_back(new SqlDelayThread(this, holderConnection, false));
+        m_holderLoaderThreads.push_back(new MaNGOS::Thread(m_holderLoaders.back()));
+    }
 }
 
 void Database::HaltDelayThread()
@@ -186,6 +210,30 @@ void Database::HaltDelayThread()
     delete m_delayThread;                                   // This also deletes m_threadBody
     m_delayThread = nullptr;
     m_threadBody = nullptr;
+
+    // the delay thread may have handed out holder queries until it stopped
+    for (auto& loader : m_holderLoaders)
+        loader->Stop();
+    for (auto& loaderThread : m_holderLoaderThreads)
+    {
+        loaderThread->wait();
+        delete loaderThread;                                // This also deletes the loader
+    }
+    m_holderLoaderThreads.clear();
+    m_holderLoaders.clear();
+}
+
+bool Database::ExecuteHolder(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback)
+{
+    if (m_holderLoaders.empty())
+        return holder->Execute(callback, m_threadBody, m_pResultQueue);
+
+    if (!m_threadBody)
+        return false;
+
+    // start each holder on the next loader, so short holders do not all queue behind the first one
+    m_threadBody->Delay(new SqlQueryHolderSplit(holder, callback, m_pResultQueue, m_holderLoaders, m_holderCounter++, &m_holderLatency));
+    return true;
 }
 
 void Database::ThreadStart()
@@ -240,6 +288,12 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         guard->Query(sql);
     }
+
+    for (auto& holderConnection : m_holderConnections)
+    {
+        SqlConnection::Lock guard(holderConnection);
+        guard->Query(sql);
+    }
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -25,6 +25,7 @@
 #include "Policies/ThreadingModel.h"
 #include "SqlPreparedStatement.h"
 #include "QueryResult.h"
+#include "Util/LatencyStats.h"
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
@@ -106,7 +107,8 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        // nLoaderConns > 0 adds connections that run the queries of query holders in parallel
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nLoaderConns = 0);
         // start worker thread for async DB request execution
         virtual void InitDelayThread();
         // stop worker thread
@@ -222,11 +224,15 @@ class Database
         // NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
         void AllowAsyncTransactions() { m_allowAsyncTransactions = true; }
 
+        // time from queuing a query holder to all its results being ready, in milliseconds
+        LatencyStats& GetHolderLatency() { return m_holderLatency; }
+        uint32 GetHolderLoaderCount() const { return uint32(m_holderLoaders.size()); }
+
     protected:
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
             m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
-            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
+            m_holderCounter(0), m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
         }
@@ -248,6 +254,9 @@ class Database
         // for now return one single connection for async requests
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
 
+        // queues a query holder on the delay thread, split over the loader connections if there are any
+        bool ExecuteHolder(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback);
+
         friend class SqlStatement;
         // PREPARED STATEMENT API
         // query function for prepared statements
@@ -269,6 +278,13 @@ class Database
         SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
         MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
 
+        // connections and threads running the queries of query holders, in the order of the delay thread
+        SqlConnectionContainer m_holderConnections;
+        std::vector<SqlDelayThread*> m_holderLoaders;       ///< owned by m_holderLoaderThreads
+        std::vector<MaNGOS::Thread*> m_holderLoaderThreads;
+        std::atomic<uint32> m_holderCounter;                ///< loader taking the first query of the next holder
+        LatencyStats m_holderLatency;
+
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
 
         // PREPARED STATEMENT REGISTRY
@@ -181,7 +181,7 @@ Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, Sq
 {
     ASYNC_DELAYHOLDER_BODY(holder)
     auto callback = std::bind(method, object, std::placeholders::_1, holder);
-    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), m_threadBody, m_pResultQueue);
+    return ExecuteHolder(holder, new MaNGOS::QueryCallback(std::move(callback)));
 }
 
 template<class Class, typename ParamType1>
@@ -190,7 +190,7 @@ Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, Sq
 {
     ASYNC_DELAYHOLDER_BODY(holder)
     auto callback = std::bind(method, object, std::placeholders::_1, holder, param1);
-    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), m_threadBody, m_pResultQueue);
+    return ExecuteHolder(holder, new MaNGOS::QueryCallback(std::move(callback)));
 }
 
 #undef ASYNC_QUERY_BODY
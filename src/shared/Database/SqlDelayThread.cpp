@@ -20,7 +20,7 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : m_dbEngine(db), m_dbConnection(conn), m_running(true), m_pingDatabase(pingDatabase)
 {
 }
 
@@ -51,7 +51,7 @@ void SqlDelayThread::run()
 
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (m_pingDatabase && (loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
             m_dbEngine->Ping();
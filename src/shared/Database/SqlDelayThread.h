@@ -39,12 +39,13 @@ class SqlDelayThread : public MaNGOS::Runnable
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
         std::atomic<bool> m_running;
+        bool m_pingDatabase;                                    ///< false for the holder loader threads, their connections are pinged by the delay thread
 
         // process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
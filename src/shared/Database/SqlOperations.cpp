@@ -20,6 +20,7 @@
 #include "SqlDelayThread.h"
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
+#include "Util/LatencyStats.h"
 
 #include <cstdarg>
 
@@ -212,6 +213,23 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+
+    size_t oldSize = m_runWith.size();
+    m_runWith.resize(size);
+    for (size_t i = oldSize; i < size; ++i)
+        m_runWith[i] = i;
+}
+
+bool SqlQueryHolder::RunWith(size_t index, size_t leader)
+{
+    if (index >= m_runWith.size() || leader >= m_runWith.size() || m_runWith[leader] != leader)
+    {
+        sLog.outError("Query holder index (" SIZEFMTD ") can not run with index (" SIZEFMTD "), size: " SIZEFMTD, index, leader, m_runWith.size());
+        return false;
+    }
+
+    m_runWith[index] = leader;
+    return true;
 }
 
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
@@ -234,3 +252,81 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
 
     return true;
 }
+
+SqlQueryHolderSplit::SqlQueryHolderSplit(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue,
+                                         std::vector<SqlDelayThread*> const& loaders, size_t firstLoader, LatencyStats* latency)
+    : m_job(std::make_shared<Job>()), m_loaders(loaders), m_firstLoader(firstLoader)
+{
+    m_job->holder = holder;
+    m_job->callback = callback;
+    m_job->queue = queue;
+    m_job->latency = latency;
+    m_job->queuedTime = std::chrono::steady_clock::now();
+    m_job->remaining = 0;
+}
+
+void SqlQueryHolderSplit::Finish(Job& job)
+{
+    if (job.latency)
+        job.latency->Add(uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - job.queuedTime).count()));
+
+    /// sync with the caller thread
+    job.queue->Add(job.callback);
+}
+
+bool SqlQueryHolderSplit::Execute(SqlConnection* /*conn*/)
+{
+    if (!m_job->holder || !m_job->callback || !m_job->queue || m_loaders.empty())
+        return false;
+
+    std::vector<SqlQueryHolder::SqlResultPair>& queries = m_job->holder->m_queries;
+
+    std::vector<size_t> const& runWith = m_job->holder->m_runWith;
+
+    /// queries bound to another one go into its part, in holder order
+    std::vector<std::vector<size_t>> parts(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+        if (queries[i].first)
+            parts[runWith[i]].push_back(i);
+
+    /// count all parts before handing out the first one, a fast loader must not see the job done early
+    size_t count = 0;
+    for (auto const& part : parts)
+        if (!part.empty())
+            ++count;
+
+    if (!count)
+    {
+        Finish(*m_job);
+        return true;
+    }
+
+    m_job->remaining = count;
+    size_t loader = m_firstLoader;
+    for (auto& part : parts)
+        if (!part.empty())
+            m_loaders[loader++ % m_loaders.size()]->Delay(new Part(m_job, std::move(part)));
+
+    return true;
+}
+
+bool SqlQueryHolderSplit::Part::Execute(SqlConnection* conn)
+{
+    {
+        LOCK_DB_CONN(conn);
+        /// queries of one part read one snapshot, writes queued after the holder can not land between them
+        bool transaction = m_indexes.size() > 1 && conn->BeginTransaction();
+
+        /// every part writes its own result slots, the holder is not resized while loading
+        for (size_t index : m_indexes)
+            m_job->holder->SetResult(index, conn->Query(m_job->holder->m_queries[index].first));
+
+        if (transaction)
+            conn->CommitTransaction();
+    }
+
+    if (--m_job->remaining == 0)
+        Finish(*m_job);
+
+    return true;
+}
@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "Utilities/Callback.h"
 
+#include <atomic>
+#include <chrono>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -87,6 +89,8 @@ class SqlQuery;                                             /// contains a singl
 class QueryResult;                                          /// the result of one
 class SqlQueryHolder;                                       /// groups several async quries
 class SqlQueryHolderEx;                                     /// points to a holder, added to the delay thread
+class SqlQueryHolderSplit;                                  /// spreads the queries of a holder over the holder loader threads
+class LatencyStats;
 
 class SqlResultQueue
 {
@@ -119,15 +123,20 @@ class SqlQuery : public SqlOperation
 class SqlQueryHolder
 {
         friend class SqlQueryHolderEx;
+        friend class SqlQueryHolderSplit;
     private:
         typedef std::pair<const char*, std::unique_ptr<QueryResult>> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        std::vector<size_t> m_runWith;                      ///< index of the query each query runs after on split holders, itself if none
     public:
         SqlQueryHolder() {}
         virtual ~SqlQueryHolder();
         bool SetQuery(size_t index, const char* sql);
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
         void SetSize(size_t size);
+        // split holders run the query at index right after the one at leader, on the same connection and in one transaction,
+        // for queries that must see the same data, like a list and its children
+        bool RunWith(size_t index, size_t leader);
         std::unique_ptr<QueryResult> GetResult(size_t index);
         void SetResult(size_t index, std::unique_ptr<QueryResult> queryResult);
         bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
@@ -144,4 +153,41 @@ class SqlQueryHolderEx : public SqlOperation
             : m_holder(holder), m_callback(callback), m_queue(queue) {}
         bool Execute(SqlConnection* conn) override;
 };
+
+// Queued on the delay thread like SqlQueryHolderEx, so the holder still sees every write queued before it,
+// but only hands the queries out to the loader threads (each with its own connection) instead of running them.
+// The last query done calls back.
+class SqlQueryHolderSplit : public SqlOperation
+{
+    private:
+        struct Job
+        {
+            SqlQueryHolder* holder;
+            MaNGOS::IQueryCallback* callback;
+            SqlResultQueue* queue;
+            LatencyStats* latency;
+            std::chrono::steady_clock::time_point queuedTime;
+            std::atomic<size_t> remaining;
+        };
+
+        class Part : public SqlOperation
+        {
+            private:
+                std::shared_ptr<Job> m_job;
+                std::vector<size_t> m_indexes;
+            public:
+                Part(std::shared_ptr<Job> job, std::vector<size_t> indexes) : m_job(std::move(job)), m_indexes(std::move(indexes)) {}
+                bool Execute(SqlConnection* conn) override;
+        };
+
+        std::shared_ptr<Job> m_job;
+        std::vector<SqlDelayThread*> const& m_loaders;
+        size_t m_firstLoader;
+
+        static void Finish(Job& job);
+    public:
+        SqlQueryHolderSplit(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue,
+                            std::vector<SqlDelayThread*> const& loaders, size_t firstLoader, LatencyStats* latency);
+        bool Execute(SqlConnection* conn) override;
+};
 #endif                                                      //__SQLOPERATIONS_H
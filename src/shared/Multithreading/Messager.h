@@ -19,34 +19,212 @@
 #ifndef MANGOS_MESSAGER_H
 #define MANGOS_MESSAGER_H
 
-#include <vector>
+#include "Platform/Define.h"
+#include "Util/LatencyStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
-#include <functional>
+#include <type_traits>
+#include <utility>
 
+/*
+    Multiple producer, single consumer message queue, used to run closures on the thread owning T
+    - AddMessage is lock free: the closure is moved into the queue node (one allocation, no std::function),
+      nodes are linked with one atomic exchange (intrusive queue of D. Vyukov)
+    - Execute runs the messages queued when it started, as one batch; messages they add run on the next call
+    - only one thread may call Execute / WaitForMessages at a time
+*/
 template <class T>
 class Messager
 {
     public:
-        void AddMessage(const std::function<void(T*)>& message)
+        Messager() : m_head(&m_stub), m_tail(&m_stub), m_depth(0), m_maxDepth(0), m_batchCount(0), m_maxBatch(0), m_waiting(false), m_interrupted(false)
+        {
+            m_stub.next.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~Messager()
         {
-            std::lock_guard<std::mutex> guard(m_messageMutex);
-            m_messageVector.push_back(message);
+            // pending messages are dropped, as the owner is going away
+            while (Node* node = Pop())
+                delete node;
         }
+
+        Messager(Messager const&) = delete;
+        Messager& operator=(Messager const&) = delete;
+
+        template <class F>
+        void AddMessage(F&& message)
+        {
+            // counted before it is published, so the consumer never sees the node before its count
+            uint32 depth = m_depth.fetch_add(1) + 1;
+            Push(new MessageNode<typename std::decay<F>::type>(std::forward<F>(message)));
+
+            uint32 maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+            while (depth > maxDepth && !m_maxDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed)) {}
+
+            // only a sleeping consumer needs the mutex, map and world messagers never take it
+            if (m_waiting.load())
+            {
+                std::lock_guard<std::mutex> guard(m_waitMutex);
+                m_waitCondition.notify_one();
+            }
+        }
+
+        // blocks the consumer thread until a message is added or Interrupt() is called
+        void WaitForMessages()
+        {
+            std::unique_lock<std::mutex> lock(m_waitMutex);
+            m_waiting.store(true);
+            m_waitCondition.wait(lock, [this]() { return m_depth.load() != 0 || m_interrupted; });
+            m_waiting.store(false);
+        }
+
+        // same as above, but returns false once the deadline is reached without a message
+        template <class Clock, class Duration>
+        bool WaitForMessages(std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            std::unique_lock<std::mutex> lock(m_waitMutex);
+            m_waiting.store(true);
+            bool result = m_waitCondition.wait_until(lock, deadline, [this]() { return m_depth.load() != 0 || m_interrupted; });
+            m_waiting.store(false);
+            return result;
+        }
+
+        // wakes up the consumer for good, used to let its thread see a shutdown
+        void Interrupt()
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_waitMutex);
+                m_interrupted = true;
+            }
+            m_waitCondition.notify_all();
+        }
+
         void Execute(T* object)
         {
-            std::vector<std::function<void(T*)>> messageVectorCopy;
+            // the batch is bounded by the messages counted right now, the ones they add run on the next call
+            uint32 pending = m_depth.load(std::memory_order_acquire);
+            if (!pending)
+                return;
+
+            Clock::time_point now = Clock::now();
+            uint32 batch = 0;
+            while (batch < pending)
             {
-                std::lock_guard<std::mutex> guard(m_messageMutex);
-                std::swap(m_messageVector, messageVectorCopy);
+                Node* node = Pop();
+                if (!node)
+                    break;
+
+                m_depth.fetch_sub(1, std::memory_order_relaxed);
+                m_latency.Add(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::max(now - node->queued, Clock::duration::zero())).count()));
+                ++batch;
+
+                node->Run(object);
+                delete node;
             }
-            for (auto& message : messageVectorCopy)
-                message(object);
 
-            messageVectorCopy.clear();
+            m_batchCount.fetch_add(1, std::memory_order_relaxed);
+            if (batch > m_maxBatch.load(std::memory_order_relaxed))
+                m_maxBatch.store(batch, std::memory_order_relaxed);
         }
+
+        // metrics, readable from any thread
+        uint32 GetDepth() const { return m_depth.load(std::memory_order_relaxed); }
+        uint32 GetMaxDepth() const { return m_maxDepth.load(std::memory_order_relaxed); }
+        uint64 GetBatchCount() const { return m_batchCount.load(std::memory_order_relaxed); }
+        uint32 GetMaxBatch() const { return m_maxBatch.load(std::memory_order_relaxed); }
+        LatencyStats const& GetLatency() const { return m_latency; }    // queued to executed, in microseconds
+
+        void ResetStats()
+        {
+            m_maxDepth.store(GetDepth(), std::memory_order_relaxed);
+            m_batchCount.store(0, std::memory_order_relaxed);
+            m_maxBatch.store(0, std::memory_order_relaxed);
+            m_latency.Reset();
+        }
+
     private:
-        std::vector<std::function<void(T*)>> m_messageVector;
-        std::mutex m_messageMutex;  
+        typedef std::chrono::steady_clock Clock;
+
+        struct Node
+        {
+            Node() : queued(Clock::now()) { next.store(nullptr, std::memory_order_relaxed); }
+            virtual ~Node() {}
+            virtual void Run(T* /*object*/) {}
+
+            std::atomic<Node*> next;
+            Clock::time_point queued;
+        };
+
+        template <class F>
+        struct MessageNode : public Node
+        {
+            template <class U>
+            explicit MessageNode(U&& callable) : message(std::forward<U>(callable)) {}
+            void Run(T* object) override { message(object); }
+
+            F message;
+        };
+
+        void Push(Node* node)
+        {
+            Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // returns nullptr when empty, or when the next message is still being linked by its producer
+        Node* Pop()
+        {
+            Node* tail = m_tail;
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &m_stub)
+            {
+                if (!next)
+                    return nullptr;
+                m_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            // tail is the only node, put the stub behind it to be able to unlink it
+            m_stub.next.store(nullptr, std::memory_order_relaxed);
+            Push(&m_stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+            return nullptr;
+        }
+
+        std::atomic<Node*> m_head;                          // producers push here
+        Node* m_tail;                                       // consumer pops here
+        Node m_stub;
+
+        std::atomic<uint32> m_depth;
+        std::atomic<uint32> m_maxDepth;
+        std::atomic<uint64> m_batchCount;
+        std::atomic<uint32> m_maxBatch;
+        LatencyStats m_latency;
+
+        std::mutex m_waitMutex;
+        std::condition_variable m_waitCondition;
+        std::atomic<bool> m_waiting;
+        bool m_interrupted;
 };
 
-#endif
\ No newline at end of file
+#endif
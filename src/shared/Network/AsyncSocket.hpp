@@ -21,6 +21,7 @@
 
 #include "Platform/Define.h"
 #include <boost/asio.hpp>
+#include <array>
 #include <boost/enable_shared_from_this.hpp>
 #include "boost/lexical_cast.hpp"
 #include "Log/Log.h"
@@ -36,9 +37,13 @@ namespace MaNGOS
             virtual ~AsyncSocket();
 
             void Read(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            // completes with whatever is available, up to length bytes
+            void ReadSome(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadSkip(size_t skipSize, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            // gathers both buffers in one write, neither is copied
+            void Write(const char* header, size_t headerLength, const char* body, size_t bodyLength, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
 
             bool Start();
             void Close()
@@ -92,6 +97,12 @@ namespace MaNGOS
         boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), callback);
     }
 
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::ReadSome(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
+    {
+        m_socket.async_read_some(boost::asio::buffer(buffer, length), callback);
+    }
+
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
@@ -114,6 +125,13 @@ namespace MaNGOS
         boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), callback);
     }
 
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::Write(const char* header, size_t headerLength, const char* body, size_t bodyLength, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
+    {
+        std::array<boost::asio::const_buffer, 2> buffers = { boost::asio::buffer(header, headerLength), boost::asio::buffer(body, bodyLength) };
+        boost::asio::async_write(m_socket, buffers, callback);
+    }
+
     template <typename SocketType>
     bool MaNGOS::AsyncSocket<SocketType>::AsyncSocket::Start()
     {
@@ -0,0 +1,308 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/BufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace
+{
+    size_t const MAX_CACHED_BYTES = 1024 * 1024;          // per class and thread
+    size_t const MAX_THREAD_CACHED_BYTES = 4 * 1024 * 1024; // all classes of a thread
+    size_t const MAX_RETURNED_BYTES = 4 * 1024 * 1024;    // blocks waiting on the return lists of one thread
+    size_t const MIN_CACHED_BLOCKS = 16;
+
+    // every pooled block starts with the pool it was allocated from, the buffer follows
+    size_t const HEADER_SIZE = alignof(std::max_align_t) > sizeof(void*) ? alignof(std::max_align_t) : sizeof(void*);
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct PoolCounters
+    {
+        std::atomic<uint64> hits[BufferPool::CLASS_COUNT];
+        std::atomic<uint64> misses[BufferPool::CLASS_COUNT];
+        std::atomic<uint64> releases[BufferPool::CLASS_COUNT];
+        std::atomic<uint64> returns[BufferPool::CLASS_COUNT];
+        std::atomic<uint64> unpooled;
+    };
+
+    PoolCounters s_counters;
+
+    struct ThreadPool
+    {
+        // owner thread only
+        FreeBlock* freeBlocks[BufferPool::CLASS_COUNT];
+        size_t freeCount[BufferPool::CLASS_COUNT];
+        size_t cachedBytes;
+
+        // blocks freed by other threads, pushed lock-free and taken back as a whole by the owner
+        std::atomic<FreeBlock*> returnedBlocks[BufferPool::CLASS_COUNT];
+        std::atomic<size_t> returnedBytes;
+
+        std::atomic<bool> alive;
+        // 1 for the owner thread + every block not on the owner's free lists, the last release deletes the pool
+        std::atomic<size_t> refs;
+
+        ThreadPool() : cachedBytes(0), returnedBytes(0), alive(true), refs(1)
+        {
+            for (uint32 i = 0; i < BufferPool::CLASS_COUNT; ++i)
+            {
+                freeBlocks[i] = nullptr;
+                freeCount[i] = 0;
+                returnedBlocks[i] = nullptr;
+            }
+        }
+    };
+
+    void ReleasePool(ThreadPool* pool)
+    {
+        if (pool->refs.fetch_sub(1) == 1)
+            delete pool;
+    }
+
+    // deletes a returned list, each block drops its pool reference, so the pool must not be used after the call
+    void DeleteReturnedBlocks(ThreadPool* pool, FreeBlock* block)
+    {
+        while (block)
+        {
+            FreeBlock* next = block->next;
+            ::operator delete(block);
+            ReleasePool(pool);
+            block = next;
+        }
+    }
+
+    enum PoolState
+    {
+        POOL_NONE,
+        POOL_ALIVE,
+        POOL_DESTROYED,                                     // thread exit, later allocations of the thread go to the heap
+    };
+
+    thread_local PoolState t_poolState = POOL_NONE;
+    thread_local ThreadPool* t_pool = nullptr;
+
+    struct ThreadPoolHandle
+    {
+        ThreadPoolHandle()
+        {
+            t_pool = new ThreadPool;
+            t_poolState = POOL_ALIVE;
+        }
+
+        ~ThreadPoolHandle()
+        {
+            ThreadPool* pool = t_pool;
+            t_pool = nullptr;
+            t_poolState = POOL_DESTROYED;
+
+            // frees from other threads seeing the pool dead delete their block themselves
+            pool->alive = false;
+            for (uint32 i = 0; i < BufferPool::CLASS_COUNT; ++i)
+            {
+                FreeBlock* block = pool->freeBlocks[i];
+                while (block)
+                {
+                    FreeBlock* next = block->next;
+                    ::operator delete(block);
+                    block = next;
+                }
+            }
+
+            // the pool's own reference keeps it alive while draining
+            for (std::atomic<FreeBlock*>& returned : pool->returnedBlocks)
+                DeleteReturnedBlocks(pool, returned.exchange(nullptr));
+
+            ReleasePool(pool);
+        }
+    };
+
+    ThreadPool* GetThreadPool()
+    {
+        if (t_poolState == POOL_DESTROYED)
+            return nullptr;
+
+        thread_local ThreadPoolHandle handle;
+        return t_pool;
+    }
+
+    ThreadPool*& BlockOwner(void* block)
+    {
+        return *static_cast<ThreadPool**>(block);
+    }
+
+    // moves the blocks other threads returned for this class to the free list
+    FreeBlock* TakeReturnedBlocks(ThreadPool& pool, uint32 sizeClass, size_t blockSize)
+    {
+        FreeBlock* returned = pool.returnedBlocks[sizeClass].exchange(nullptr);
+        if (!returned)
+            return nullptr;
+
+        size_t count = 0;
+        FreeBlock* last = returned;
+        for (; last->next; last = last->next)
+            ++count;
+        ++count;
+
+        pool.returnedBytes.fetch_sub(count * blockSize);
+        pool.refs.fetch_sub(count);                         // never the last reference, the owner thread holds one
+        last->next = pool.freeBlocks[sizeClass];
+        pool.freeBlocks[sizeClass] = returned;
+        pool.freeCount[sizeClass] += count;
+        pool.cachedBytes += count * blockSize;
+        return returned;
+    }
+}
+
+void* BufferPool::Allocate(size_t size)
+{
+    uint32 sizeClass = GetClass(size);
+    if (sizeClass >= CLASS_COUNT)
+    {
+        s_counters.unpooled.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    size_t const blockSize = HEADER_SIZE + s_classSizes[sizeClass];
+    ThreadPool* pool = GetThreadPool();
+    if (!pool)
+    {
+        void* block = ::operator new(blockSize);
+        BlockOwner(block) = nullptr;
+        return static_cast<char*>(block) + HEADER_SIZE;
+    }
+
+    FreeBlock* block = pool->freeBlocks[sizeClass];
+    if (!block && pool->returnedBlocks[sizeClass].load(std::memory_order_relaxed))
+        block = TakeReturnedBlocks(*pool, sizeClass, blockSize);
+
+    void* result;
+    if (block)
+    {
+        pool->freeBlocks[sizeClass] = block->next;
+        --pool->freeCount[sizeClass];
+        pool->cachedBytes -= blockSize;
+        s_counters.hits[sizeClass].fetch_add(1, std::memory_order_relaxed);
+        result = block;
+    }
+    else
+    {
+        s_counters.misses[sizeClass].fetch_add(1, std::memory_order_relaxed);
+        result = ::operator new(blockSize);
+    }
+
+    pool->refs.fetch_add(1, std::memory_order_relaxed);
+    BlockOwner(result) = pool;
+    return static_cast<char*>(result) + HEADER_SIZE;
+}
+
+void BufferPool::Deallocate(void* buffer, size_t size)
+{
+    if (!buffer)
+        return;
+
+    uint32 sizeClass = GetClass(size);
+    if (sizeClass >= CLASS_COUNT)
+    {
+        ::operator delete(buffer);
+        return;
+    }
+
+    void* block = static_cast<char*>(buffer) - HEADER_SIZE;
+    ThreadPool* owner = BlockOwner(block);
+    if (!owner)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    size_t const blockSize = HEADER_SIZE + s_classSizes[sizeClass];
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+
+    if (owner == t_pool)
+    {
+        if (owner->freeCount[sizeClass] >= std::max(MIN_CACHED_BLOCKS, MAX_CACHED_BYTES / s_classSizes[sizeClass]) ||
+            owner->cachedBytes + blockSize > MAX_THREAD_CACHED_BYTES)
+        {
+            s_counters.releases[sizeClass].fetch_add(1, std::memory_order_relaxed);
+            ::operator delete(block);
+        }
+        else
+        {
+            freeBlock->next = owner->freeBlocks[sizeClass];
+            owner->freeBlocks[sizeClass] = freeBlock;
+            ++owner->freeCount[sizeClass];
+            owner->cachedBytes += blockSize;
+        }
+
+        owner->refs.fetch_sub(1);                           // never the last reference, this thread holds one
+        return;
+    }
+
+    // allocated by another thread (network thread buffers freed by world and map threads), hand it back
+    if (!owner->alive.load() || owner->returnedBytes.load(std::memory_order_relaxed) + blockSize > MAX_RETURNED_BYTES)
+    {
+        s_counters.releases[sizeClass].fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(block);
+        ReleasePool(owner);
+        return;
+    }
+
+    owner->refs.fetch_add(1);                               // keeps the pool while pushing, the block's reference moves with it
+    owner->returnedBytes.fetch_add(blockSize);
+    freeBlock->next = owner->returnedBlocks[sizeClass].load();
+    while (!owner->returnedBlocks[sizeClass].compare_exchange_weak(freeBlock->next, freeBlock))
+        ;
+    s_counters.returns[sizeClass].fetch_add(1, std::memory_order_relaxed);
+
+    // the owner exited meanwhile and may have drained its lists before the push
+    if (!owner->alive.load())
+        DeleteReturnedBlocks(owner, owner->returnedBlocks[sizeClass].exchange(nullptr));
+
+    ReleasePool(owner);
+}
+
+void BufferPool::GetStats(ClassStats (&stats)[CLASS_COUNT], uint64& unpooled)
+{
+    for (uint32 i = 0; i < CLASS_COUNT; ++i)
+    {
+        stats[i].size = s_classSizes[i];
+        stats[i].hits = s_counters.hits[i].load(std::memory_order_relaxed);
+        stats[i].misses = s_counters.misses[i].load(std::memory_order_relaxed);
+        stats[i].releases = s_counters.releases[i].load(std::memory_order_relaxed);
+        stats[i].returns = s_counters.returns[i].load(std::memory_order_relaxed);
+    }
+    unpooled = s_counters.unpooled.load(std::memory_order_relaxed);
+}
+
+void BufferPool::ResetStats()
+{
+    for (uint32 i = 0; i < CLASS_COUNT; ++i)
+    {
+        s_counters.hits[i].store(0, std::memory_order_relaxed);
+        s_counters.misses[i].store(0, std::memory_order_relaxed);
+        s_counters.releases[i].store(0, std::memory_order_relaxed);
+        s_counters.returns[i].store(0, std::memory_order_relaxed);
+    }
+    s_counters.unpooled.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_BUFFERPOOL_H
+#define MANGOS_BUFFERPOOL_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+#include <new>
+
+// Size class pools of raw buffers, one set per thread, used as ByteBuffer storage
+// Every block remembers the pool it came from and goes back to it when freed: the freeing thread's own blocks directly,
+// other threads' blocks through a lock-free return list taken over by the owner at its next allocation of that class.
+// Each pool keeps at most ~1MB per class and 4MB in total, at most 4MB may wait on its return lists, the rest goes to the heap
+// Requests above the largest class go to the heap directly
+class BufferPool
+{
+    public:
+        static constexpr uint32 CLASS_COUNT = 8;            // 64, 256, 1K, 4K, 8K, 16K, 32K and 64K bytes
+
+        struct ClassStats
+        {
+            size_t size;
+            uint64 hits;                                    // allocations served from a pool
+            uint64 misses;                                  // allocations which had to go to the heap
+            uint64 releases;                                // frees which went to the heap, the pool being full
+            uint64 returns;                                 // frees by other threads handed back to the allocating thread
+        };
+
+        static void* Allocate(size_t size);
+        static void Deallocate(void* block, size_t size);
+
+        // size of the block Allocate(size) returns
+        static size_t GetBlockSize(size_t size)
+        {
+            uint32 sizeClass = GetClass(size);
+            return sizeClass < CLASS_COUNT ? s_classSizes[sizeClass] : size;
+        }
+
+        static void GetStats(ClassStats (&stats)[CLASS_COUNT], uint64& unpooled);
+        static void ResetStats();
+
+    private:
+        static constexpr size_t s_classSizes[CLASS_COUNT] = { 64, 256, 1024, 4096, 8192, 16384, 32768, 65536 };
+
+        static uint32 GetClass(size_t size)
+        {
+            uint32 sizeClass = 0;
+            while (sizeClass < CLASS_COUNT && size > s_classSizes[sizeClass])
+                ++sizeClass;
+            return sizeClass;
+        }
+};
+
+// std::allocator replacement drawing from BufferPool, stateless so containers swap and move storage freely
+template <class T>
+class BufferPoolAllocator
+{
+    public:
+        typedef T value_type;
+
+        BufferPoolAllocator() noexcept {}
+        template <class U> BufferPoolAllocator(BufferPoolAllocator<U> const&) noexcept {}
+
+        T* allocate(std::size_t count) { return static_cast<T*>(BufferPool::Allocate(count * sizeof(T))); }
+        void deallocate(T* block, std::size_t count) noexcept { BufferPool::Deallocate(block, count * sizeof(T)); }
+
+        template <class U> bool operator==(BufferPoolAllocator<U> const&) const noexcept { return true; }
+        template <class U> bool operator!=(BufferPoolAllocator<U> const&) const noexcept { return false; }
+};
+
+#endif
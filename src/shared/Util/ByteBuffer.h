@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "Util/ByteConverter.h"
+#include "Util/BufferPool.h"
 #include <utf8.h>
 
 class ByteBufferException
@@ -52,7 +53,7 @@ class ByteBuffer
 
         explicit ByteBuffer(size_t reservedSize = s_defaultSize): _rpos(0), _wpos(0)
         {
-            _storage.reserve(reservedSize);
+            reserve(reservedSize);
         }
 
         virtual ~ByteBuffer() = default;
@@ -72,7 +73,7 @@ class ByteBuffer
 
         ByteBuffer(size_t size, Reserve) : _rpos(0), _wpos(0)
         {
-            _storage.reserve(size);
+            reserve(size);
         }
 
         ByteBuffer(size_t size, Resize) : _rpos(0), _wpos(size)
@@ -374,8 +375,9 @@ class ByteBuffer
 
         void reserve(size_t ressize)
         {
+            // whole pool blocks, the rest of the block would be wasted anyway
             if (ressize > size())
-                _storage.reserve(ressize);
+                _storage.reserve(BufferPool::GetBlockSize(ressize));
         }
 
         void append(const std::string& str)
@@ -401,7 +403,11 @@ class ByteBuffer
             MANGOS_ASSERT(size() < 10000000);
 
             if (_storage.size() < _wpos + cnt)
+            {
+                if (_storage.capacity() < _wpos + cnt)
+                    _storage.reserve(BufferPool::GetBlockSize(std::max(_wpos + cnt, _storage.capacity() * 2)));
                 _storage.resize(_wpos + cnt);
+            }
             memcpy(&_storage[_wpos], src, cnt);
             _wpos += cnt;
         }
@@ -467,7 +473,7 @@ class ByteBuffer
         }
 
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        std::vector<uint8, BufferPoolAllocator<uint8>> _storage;   // storage blocks come from the thread's BufferPool
 
         static constexpr size_t s_defaultSize = 0x1000;
 };
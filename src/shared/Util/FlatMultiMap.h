@@ -0,0 +1,113 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_FLATMULTIMAP_H
+#define MANGOS_FLATMULTIMAP_H
+
+#include "Util/Errors.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Read only multimap kept as one sorted vector, for lookup tables filled once at load
+// Entries are appended by insert() and sorted by Finalize(), entries with equal keys keep their insertion order
+// like in std::multimap. Lookups are binary searches over contiguous memory and an entry costs no tree node.
+// Lookups are only valid after Finalize(), pointers to values stay valid until the next insert() or clear().
+template<class Key, class Value>
+class FlatMultiMap
+{
+    public:
+        typedef Key key_type;
+        typedef Value mapped_type;
+        typedef std::pair<Key, Value> value_type;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+        FlatMultiMap() : m_finalized(true) {}
+
+        void insert(value_type const& value)
+        {
+            m_entries.push_back(value);
+            m_finalized = false;
+        }
+
+        void Finalize()
+        {
+            std::stable_sort(m_entries.begin(), m_entries.end(), [](value_type const& left, value_type const& right)
+            {
+                return left.first < right.first;
+            });
+            m_entries.shrink_to_fit();
+            m_finalized = true;
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+            m_entries.shrink_to_fit();
+            m_finalized = true;
+        }
+
+        const_iterator begin() const { return m_entries.begin(); }
+        const_iterator end() const { return m_entries.end(); }
+        size_t size() const { return m_entries.size(); }
+        bool empty() const { return m_entries.empty(); }
+
+        const_iterator lower_bound(Key const& key) const
+        {
+            MANGOS_ASSERT(m_finalized);
+            return std::lower_bound(m_entries.begin(), m_entries.end(), key, [](value_type const& entry, Key const& k)
+            {
+                return entry.first < k;
+            });
+        }
+
+        const_iterator upper_bound(Key const& key) const
+        {
+            MANGOS_ASSERT(m_finalized);
+            return std::upper_bound(m_entries.begin(), m_entries.end(), key, [](Key const& k, value_type const& entry)
+            {
+                return k < entry.first;
+            });
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(Key const& key) const
+        {
+            const_iterator first = lower_bound(key);
+            const_iterator last = std::upper_bound(first, m_entries.cend(), key, [](Key const& k, value_type const& entry)
+            {
+                return k < entry.first;
+            });
+            return std::make_pair(first, last);
+        }
+
+        const_iterator find(Key const& key) const
+        {
+            const_iterator itr = lower_bound(key);
+            return itr != m_entries.end() && !(key < itr->first) ? itr : m_entries.end();
+        }
+
+        // approximate heap bytes used by the entries
+        size_t GetMemoryUsage() const { return m_entries.capacity() * sizeof(value_type); }
+
+    private:
+        std::vector<value_type> m_entries;
+        bool m_finalized;
+};
+
+#endif
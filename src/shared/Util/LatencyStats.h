@@ -0,0 +1,106 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_LATENCYSTATS_H
+#define MANGOS_LATENCYSTATS_H
+
+#include "Platform/Define.h"
+
+#include <algorithm>
+#include <atomic>
+
+// Lock free latency accumulator, written by one or more threads and read by anyone (e.g. a gm command)
+// Samples are in the unit the owner records (milliseconds for queue waits, microseconds for message delivery),
+// percentiles are estimated from power of two buckets
+class LatencyStats
+{
+    public:
+        static constexpr uint32 BUCKET_COUNT = 24;          // last bucket holds everything from 2^22 units up
+
+        struct Snapshot
+        {
+            uint64 count;
+            uint64 total;
+            uint32 maximum;
+            uint64 buckets[BUCKET_COUNT];
+
+            uint32 GetAverage() const { return count ? uint32(total / count) : 0; }
+
+            // upper bound of the bucket holding the given percentile (0-100)
+            uint32 GetPercentile(uint32 percentile) const
+            {
+                if (!count)
+                    return 0;
+
+                uint64 const target = (count * percentile + 99) / 100;
+                uint64 seen = 0;
+                for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+                {
+                    seen += buckets[i];
+                    if (seen >= target)
+                        return i + 1 < BUCKET_COUNT ? std::min((1u << i) - 1, maximum) : maximum;
+                }
+                return maximum;
+            }
+        };
+
+        LatencyStats() { Reset(); }
+
+        void Add(uint32 sample)
+        {
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_total.fetch_add(sample, std::memory_order_relaxed);
+
+            uint32 max = m_maximum.load(std::memory_order_relaxed);
+            while (sample > max && !m_maximum.compare_exchange_weak(max, sample, std::memory_order_relaxed)) {}
+
+            // bucket i holds samples below 2^i
+            uint32 bucket = 0;
+            while (bucket + 1 < BUCKET_COUNT && (sample >> bucket))
+                ++bucket;
+            m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Reset()
+        {
+            m_count = 0;
+            m_total = 0;
+            m_maximum = 0;
+            for (auto& bucket : m_buckets)
+                bucket = 0;
+        }
+
+        Snapshot GetSnapshot() const
+        {
+            Snapshot snapshot;
+            snapshot.count = m_count.load(std::memory_order_relaxed);
+            snapshot.total = m_total.load(std::memory_order_relaxed);
+            snapshot.maximum = m_maximum.load(std::memory_order_relaxed);
+            for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+                snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            return snapshot;
+        }
+
+    private:
+        std::atomic<uint64> m_count;
+        std::atomic<uint64> m_total;
+        std::atomic<uint32> m_maximum;
+        std::atomic<uint64> m_buckets[BUCKET_COUNT];
+};
+
+#endif
@@ -25,10 +25,13 @@
 
 #include <chrono>
 #include <cstdarg>
+#include <functional>
+#include <thread>
 
 std::mt19937* initRand()
 {
-    std::seed_seq seq = { size_t(std::time(nullptr)), size_t(std::clock()) };
+    // threads started together (e.g. loot simulation workers) must not share a sequence
+    std::seed_seq seq = { size_t(std::time(nullptr)), size_t(std::clock()), std::hash<std::thread::id>()(std::this_thread::get_id()) };
     return new std::mt19937(seq);
 }
 